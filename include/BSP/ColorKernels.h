@@ -0,0 +1,195 @@
+/*******************************************************************************
+ * @file ColorKernels.h
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief Color rendering kernels.
+ *
+ * @details This file defines the fixed-point kernels used to render colors in
+ * the LED strips buffers: solid fill, linear gradient and brightness scaling.
+ * The kernels work on packed RGB data (3 bytes per pixel, R first).
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+#ifndef __BSP_COLOR_KERNELS_H_
+#define __BSP_COLOR_KERNELS_H_
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+
+#include <cstdint> /* Standard Int Types */
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+/* Size of a packed RGB pixel in bytes */
+#define COLOR_KERNELS_PIXEL_SIZE 3
+
+/* Selects the packed 32-bit path. The scalar path is the default on all the
+ * targets, the packed path is slower on the host and was not measured faster
+ * on the ESP32-S3.
+ */
+#ifndef COLOR_KERNELS_PACKED_PATH
+#define COLOR_KERNELS_PACKED_PATH 0
+#endif
+
+/*******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * STRUCTURES AND TYPES
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/************************* Imported global variables **************************/
+/* None */
+
+/************************* Exported global variables **************************/
+/* None */
+
+/************************** Static global variables ***************************/
+/* None */
+
+/*******************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * CLASSES
+ ******************************************************************************/
+
+/**
+ * @brief Color kernels class.
+ *
+ * @details Color kernels class. This class provides the divide-free kernels
+ * used to render the LED strips. Scaling uses the (c * (s + 1)) >> 8
+ * fixed-point rule. The packed path processes four channels per 32-bit word
+ * and produces the exact same output as the scalar path.
+ */
+class ColorKernels
+{
+    /********************* PUBLIC METHODS AND ATTRIBUTES **********************/
+    public:
+        /**
+         * @brief Fills pixels with a solid color.
+         *
+         * @param[out] pPixels The packed RGB pixels to fill.
+         * @param[in] kCount The number of pixels to fill.
+         * @param[in] kColorCode The 0xRRGGBB color code.
+         */
+        static void Fill(uint8_t*       pPixels,
+                         const uint32_t kCount,
+                         const uint32_t kColorCode);
+
+        /**
+         * @brief Fills pixels with a linear gradient.
+         *
+         * @details Fills pixels with a linear gradient. The channels are
+         * interpolated in Q16.16 fixed-point, the first and last pixels get
+         * the exact start and end colors.
+         *
+         * @param[out] pPixels The packed RGB pixels to fill.
+         * @param[in] kCount The number of pixels to fill.
+         * @param[in] kStartColorCode The 0xRRGGBB color of the first pixel.
+         * @param[in] kEndColorCode The 0xRRGGBB color of the last pixel.
+         */
+        static void Gradient(uint8_t*       pPixels,
+                             const uint32_t kCount,
+                             const uint32_t kStartColorCode,
+                             const uint32_t kEndColorCode);
+
+        /**
+         * @brief Scales the brightness of pixels.
+         *
+         * @details Scales the brightness of pixels. The source and
+         * destination can be the same buffer.
+         *
+         * @param[out] pDst The packed RGB destination pixels.
+         * @param[in] kpSrc The packed RGB source pixels.
+         * @param[in] kCount The number of pixels to scale.
+         * @param[in] kScale The brightness scale, 255 keeps the colors.
+         */
+        static void Scale(uint8_t*       pDst,
+                          const uint8_t* kpSrc,
+                          const uint32_t kCount,
+                          const uint8_t  kScale);
+
+        /**
+         * @brief Expands palette indices to pixels.
+         *
+         * @param[out] pDst The packed RGB destination pixels.
+         * @param[in] kpIndices The palette index of each pixel.
+         * @param[in] kpPalette The packed RGB palette.
+         * @param[in] kCount The number of pixels to expand.
+         */
+        static void Expand(uint8_t*       pDst,
+                           const uint8_t* kpIndices,
+                           const uint8_t* kpPalette,
+                           const uint32_t kCount);
+
+        /**
+         * @brief Blends two pixel buffers.
+         *
+         * @details Blends two pixel buffers as
+         * (from * (256 - w) + to * w) >> 8. The destination can be the same
+         * buffer as one of the sources.
+         *
+         * @param[out] pDst The packed RGB destination pixels.
+         * @param[in] kpFrom The packed RGB pixels of weight 0.
+         * @param[in] kpTo The packed RGB pixels of weight 256.
+         * @param[in] kCount The number of pixels to blend.
+         * @param[in] kWeight The weight of the to pixels, from 0 to 256.
+         */
+        static void Blend(uint8_t*       pDst,
+                          const uint8_t* kpFrom,
+                          const uint8_t* kpTo,
+                          const uint32_t kCount,
+                          const uint16_t kWeight);
+
+    /******************* PROTECTED METHODS AND ATTRIBUTES *********************/
+    protected:
+
+    /********************* PRIVATE METHODS AND ATTRIBUTES *********************/
+    private:
+        static void FillScalar(uint8_t*       pPixels,
+                               const uint32_t kCount,
+                               const uint32_t kColorCode);
+        static void ScaleScalar(uint8_t*       pDst,
+                                const uint8_t* kpSrc,
+                                const uint32_t kSize,
+                                const uint32_t kMult);
+#if COLOR_KERNELS_PACKED_PATH
+        static void FillPacked(uint8_t*       pPixels,
+                               const uint32_t kCount,
+                               const uint32_t kColorCode);
+        static void ScalePacked(uint8_t*       pDst,
+                                const uint8_t* kpSrc,
+                                const uint32_t kSize,
+                                const uint32_t kMult);
+#endif
+};
+
+#endif /* #ifndef __BSP_COLOR_KERNELS_H_ */
@@ -24,17 +24,34 @@
 #include <cstdint> /* Standard Int Types */
 #include <memory>  /* std::shared_ptr */
 #include <vector>  /* std::vector */
+#include <atomic>  /* std::atomic */
 #include <string> /* std::string */
 #include <Arduino.h>  /* Arduino Services */
 #include <FastLED.h> /* FastLED driver */
-#include <Logger.h>  /* Logger service */
 #include <Pattern.h> /* Pattern Object */
+#include <PatternCompiler.h> /* Compiled patterns */
+#include <PixelArena.h> /* Pixel buffers arena */
+#include <SceneLinks.h> /* Link parameters */
 
 /*******************************************************************************
  * CONSTANTS
  ******************************************************************************/
 
-/* None */
+/* Longest time step applied at once to the animations phases, after the link
+ * speed scale. The fastest rate (0xFFFF << 24 / ANIM_SPEED_PERIOD_US) times
+ * this step still fits the 64 bits phase.
+ */
+#define ANIM_MAX_TIME_STEP_US 100000000ULL
+
+/* Strips with bigger pixel buffers are placed in PSRAM */
+#define LED_STRIP_SRAM_MAX_SIZE 16384
+
+/* Scene transitions, a cut switches to the new scene at once */
+#define LED_TRANSITION_CUT      0
+#define LED_TRANSITION_FADE     1
+#define LED_TRANSITION_WIPE     2
+#define LED_TRANSITION_DISSOLVE 3
+#define LED_TRANSITION_MAX      LED_TRANSITION_DISSOLVE
 
 /*******************************************************************************
  * MACROS
@@ -54,6 +71,25 @@ typedef struct SStripInfo
     std::string name;
 } SStripInfo;
 
+typedef struct
+{
+    gpio_num_t  ctrlGPIO;
+    gpio_num_t  mosfetGPIO;
+    uint16_t    numLed;
+    /* Indexed strips only render indexed patterns, their base frame uses
+     * one byte per LED.
+     */
+    bool        isIndexed;
+    std::string name;
+} SStripConfig;
+
+typedef struct
+{
+    /* Q32.32 phase in steps, the integer part stays below the period */
+    uint64_t phase;
+    uint32_t step;
+} SAnimationState;
+
 /*******************************************************************************
  * GLOBAL VARIABLES
  ******************************************************************************/
@@ -91,253 +127,149 @@ class LEDStrip
         virtual void GetStripInfo(std::shared_ptr<SStripInfo> info) const = 0;
         virtual uint8_t GetId(void) const = 0;
         virtual const std::string& GetName(void) const = 0;
-
-        virtual void Apply(const Pattern* pPattern) = 0;
-        virtual void UpdateColors(void) = 0;
-
-        virtual void SetEnabled(const bool kEnable) = 0;
-        virtual bool IsEnabled(void) const = 0;
+        virtual uint16_t GetLedCount(void) const = 0;
+        virtual bool IsIndexed(void) const = 0;
+
+        /**
+         * @brief Renders a frame of a program in the back buffer.
+         *
+         * @param[in] kpProgram The program compiled for the strip.
+         * @param[in] krParams The parameters of the link, only read when the
+         * revision changes.
+         * @param[in] kRevision The program revision, a new revision restarts
+         * the program.
+         * @param[in] kFrameTime The frame time.
+         */
+        virtual void Apply(const SPatternProgram* kpProgram,
+                           const SLinkParams&     krParams,
+                           const uint32_t         kRevision,
+                           const uint64_t         kFrameTime) = 0;
+        virtual bool Present(void) = 0;
+
+        /**
+         * @brief Starts a transition from the frame shown by the strip.
+         *
+         * @details Starts a transition from the frame shown by the strip to
+         * the frames rendered by the next calls to Apply. Must be called by
+         * the renderer between two frames.
+         *
+         * @param[in] kType The transition type.
+         * @param[in] kDurationUs The transition duration.
+         * @param[in] kStartTime The frame time of the transition start.
+         */
+        virtual void StartTransition(const uint8_t  kType,
+                                     const uint32_t kDurationUs,
+                                     const uint64_t kStartTime) = 0;
+
+        /**
+         * @brief Requests the strip to be powered on or off.
+         *
+         * @details Requests the strip to be powered on or off. The request
+         * can be made by any task, it is applied by the renderer with
+         * UpdateEnabled. The strip pins are only switched by the renderer.
+         *
+         * @param[in] kEnable The requested state.
+         *
+         * @return true if the request changed, false otherwise.
+         */
+        virtual bool RequestEnabled(const bool kEnable) = 0;
+
+        /**
+         * @brief Applies the last requested power state.
+         *
+         * @details Applies the last requested power state. Must be called by
+         * the renderer between two frames while the transmitter is idle.
+         *
+         * @return true if the strip was powered on, false otherwise.
+         */
+        virtual bool UpdateEnabled(void) = 0;
 };
 
-template<gpio_num_t kGpioId, gpio_num_t kMosfetId, uint16_t kNumLeds>
 class LEDStripC : public LEDStrip
 {
     public:
-        LEDStripC(const char* kpName) :
-        rCtrl_(FastLED.addLeds<WS2812B, (uint8_t)kGpioId, GRB>(leds_,
-                                                               (int)kNumLeds))
-        {
-            name_         = std::string(kpName);
-            isEnabled_    = true;
-            applyIter_    = 0;
-            breathIn_     = false;
-            updateColors_ = true;
-
-            SetEnabled(false);
-
-            rCtrl_.setCorrection(TypicalLEDStrip);
-        }
-
-        virtual ~LEDStripC(void)
-        {
-        }
-
-        virtual void GetStripInfo(std::shared_ptr<SStripInfo> info) const
-        {
-            info->ctrlGPIO  = kGpioId;
-            info->numLed    = kNumLeds;
-            info->name      = name_;
-            info->isEnabled = isEnabled_;
-        }
-
-        virtual uint8_t GetId(void) const
-        {
-            return (uint8_t)kGpioId;
-        }
-
-        virtual const std::string& GetName(void) const
-        {
-            return name_;
-        }
-
-        virtual void Apply(const Pattern* pPattern)
-        {
-            if(isEnabled_ == false)
-            {
-                return;
-            }
-
-            /* Apply colors */
-            if(updateColors_ == true)
-            {
-                ApplyColor(pPattern->GetColors(),
-                           pPattern->GetBrightness());
-
-                updateColors_ = false;
-            }
-
-            /* Apply animations */
-            const std::vector<SAnimation>& krAnims = pPattern->GetAnimations();
-            for(const SAnimation& krAnim : krAnims)
-            {
-                switch(krAnim.type)
-                {
-                    case ANIM_TRAIL:
-                        ApplyTrail(krAnim);
-                        break;
-                    case ANIM_BREATH:
-                        ApplyBreath(krAnim);
-                        break;
-                    default:
-                        LOG_ERROR("Unknown animation ID %d\n", krAnim.type);
-                        break;
-                }
-            }
-
-            ++applyIter_;
-        }
-
-        virtual void UpdateColors(void)
-        {
-            updateColors_ = true;
-        }
-
-        virtual void SetEnabled(const bool kEnable)
-        {
-            if(kEnable == false && isEnabled_ == true)
-            {
-                /* Switch off the mosfet */
-                pinMode(kMosfetId, OUTPUT);
-                digitalWrite(kMosfetId, LOW);
-
-                /* Stop controller pin on the mosfet */
-                pinMode(kGpioId, OUTPUT);
-                digitalWrite(kGpioId, LOW);
-
-                LOG_DEBUG("Disabling Strip %d\n", kGpioId);
-            }
-            else if(kEnable == true && isEnabled_ == false)
-            {
-                /* Switch on the mosfet */
-                pinMode(kMosfetId, OUTPUT);
-                digitalWrite(kMosfetId, HIGH);
-
-                LOG_DEBUG("Enabling Strip %d\n", kGpioId);
-            }
-            isEnabled_ = kEnable;
-        }
-
-        virtual bool IsEnabled(void) const
-        {
-            return isEnabled_;
-        }
+        LEDStripC(const SStripConfig& krConfig, PixelArena& rArena);
+        virtual ~LEDStripC(void);
+
+        static size_t GetBuffersSize(const uint16_t kLedCount,
+                                     const bool     kIsIndexed);
+
+        bool IsReady(void) const;
+
+        virtual void GetStripInfo(std::shared_ptr<SStripInfo> info) const;
+        virtual uint8_t GetId(void) const;
+        virtual const std::string& GetName(void) const;
+        virtual uint16_t GetLedCount(void) const;
+        virtual bool IsIndexed(void) const;
+
+        virtual void Apply(const SPatternProgram* kpProgram,
+                           const SLinkParams&     krParams,
+                           const uint32_t         kRevision,
+                           const uint64_t         kFrameTime);
+        virtual bool Present(void);
+
+        virtual void StartTransition(const uint8_t  kType,
+                                     const uint32_t kDurationUs,
+                                     const uint64_t kStartTime);
+
+        virtual bool RequestEnabled(const bool kEnable);
+        virtual bool UpdateEnabled(void);
 
     protected:
 
     private:
-        void ApplyColor(const std::vector<SColor>& krColors,
-                        const uint8_t kBrightness)
-        {
-            uint32_t i;
-
-            rCtrl_.clearLedData();
-
-            for(const SColor& krColor : krColors)
-            {
-                /* Check if gradient */
-                if(krColor.startColorCode != krColor.endColorCode)
-                {
-                    /* Create the gradient */
-                    fill_gradient_RGB(&leds_[krColor.startIdx],
-                                    krColor.endIdx - krColor.startIdx + 1,
-                                    krColor.startColorCode,
-                                    krColor.endColorCode);
-                }
-                else
-                {
-                    /* Just set the color */
-                    for(i = krColor.startIdx; i <= krColor.endIdx; ++i)
-                    {
-                        leds_[i] = krColor.startColorCode;
-                    }
-                }
-            }
-
-            /* Apply brightness */
-            brightness_    = kBrightness;
-            maxBrightness_ = kBrightness;
-            for(i = 0; i < kNumLeds; ++i)
-            {
-                ledsInit_[i] = leds_[i];
-                leds_[i].g = (uint8_t)((uint32_t)leds_[i].g * (uint32_t)brightness_ / 255U);
-                leds_[i].r = (uint8_t)((uint32_t)leds_[i].r * (uint32_t)brightness_ / 255U);
-                leds_[i].b = (uint8_t)((uint32_t)leds_[i].b * (uint32_t)brightness_ / 255U);
-            }
-        }
-
-        void ApplyTrail(const SAnimation& krAnim)
-        {
-            uint32_t i;
-            CRGB     swap;
-
-            /* Param is for the speed */
-            if(applyIter_ % krAnim.param == 0)
-            {
-                /* Check for reverse */
-                if(krAnim.startIdx > krAnim.endIdx)
-                {
-                    swap = leds_[krAnim.startIdx];
-                    for(i = krAnim.startIdx; i > krAnim.endIdx; --i)
-                    {
-                        leds_[i] = leds_[i - 1];
-                    }
-                    leds_[krAnim.endIdx] = swap;
-                }
-                else
-                {
-                    swap = leds_[krAnim.startIdx];
-                    for(i = krAnim.startIdx; i < krAnim.endIdx; ++i)
-                    {
-                        leds_[i] = leds_[i + 1];
-                    }
-                    leds_[krAnim.endIdx] = swap;
-                }
-            }
-        }
-
-        void ApplyBreath(const SAnimation& krAnim)
-        {
-            uint32_t i;
-
-            /* Param is for the speed */
-            if(applyIter_ % krAnim.param == 0)
-            {
-                if(breathIn_ == true)
-                {
-                    if(brightness_ + 1 <= maxBrightness_)
-                    {
-                        ++brightness_;
-                    }
-                    else
-                    {
-                        brightness_ = maxBrightness_;
-                        breathIn_ = false;
-                    }
-                }
-                else
-                {
-                    if(brightness_ >= 1)
-                    {
-                        --brightness_;
-                    }
-                    else
-                    {
-                        breathIn_ = true;
-                    }
-                }
-
-                for(i = krAnim.startIdx; i <= krAnim.endIdx; ++i)
-                {
-                    leds_[i].g = (uint8_t)((uint32_t)ledsInit_[i].g * (uint32_t)brightness_ / 255U);
-                    leds_[i].r = (uint8_t)((uint32_t)ledsInit_[i].r * (uint32_t)brightness_ / 255U);
-                    leds_[i].b = (uint8_t)((uint32_t)ledsInit_[i].b * (uint32_t)brightness_ / 255U);
-                }
-            }
-        }
-
-        bool     isEnabled_;
-        bool     updateColors_;
-        bool     breathIn_;
-        uint32_t applyIter_;
-        uint8_t  brightness_;
-        uint8_t  maxBrightness_;
+        void SetEnabled(const bool kEnable);
+        void ApplyColor(const SPatternProgram* kpProgram);
+        void AdvanceAnimation(const SAnimOp&   krOp,
+                              SAnimationState& rState,
+                              const uint64_t   kTimeStep);
+        void RenderFrame(const SPatternProgram* kpProgram);
+        void RenderIndexedFrame(const SPatternProgram* kpProgram);
+        void ApplyLinkFlags(void);
+        void ApplyTransition(const uint64_t kFrameTime);
+
+        bool       isEnabled_;
+        bool       isIndexed_;
+        /* Set by any task, applied by the renderer */
+        std::atomic<bool> requestedEnable_;
+        /* The front buffer was sent since the strip was enabled */
+        bool       isFrontShown_;
+        bool       frameDirty_;
+        bool       newFrame_;
+        uint32_t   revision_;
+        uint64_t   lastTime_;
+        /* The strip was re-enabled, the animations time base is stale */
+        bool       isTimeStale_;
+        uint8_t    maxBrightness_;
+        /* Parameters of the link of the current revision */
+        uint8_t    linkFlags_;
+        uint16_t   linkSpeed_;
+        uint16_t   numLeds_;
+        gpio_num_t gpio_;
+        gpio_num_t mosfetGpio_;
 
         std::string name_;
 
-        CLEDController& rCtrl_;
-        CRGB            leds_[kNumLeds];
-        CRGB            ledsInit_[kNumLeds];
+        CLEDController* pCtrl_;
+        CRGB*           pFrontLeds_;
+        CRGB*           pBackLeds_;
+        /* Base RGB frame of RGB strips */
+        CRGB*           pBaseLeds_;
+        /* Base and animated indices, then animated palette of indexed
+         * strips.
+         */
+        uint8_t*        pIndices_;
+        CRGB*           pPalette_;
+        /* Outgoing frame of the current transition */
+        CRGB*           pTransitionLeds_;
+
+        uint8_t  transitionType_;
+        uint32_t transitionUs_;
+        uint64_t transitionStart_;
+
+        /* Phase accumulator of each animation */
+        std::vector<SAnimationState> animStates_;
 };
 
 
-#endif /* #ifndef __BSP_LEDSTRIP_H_ */
\ No newline at end of file
+#endif /* #ifndef __BSP_LEDSTRIP_H_ */
\ No newline at end of file
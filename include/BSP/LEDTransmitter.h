@@ -0,0 +1,145 @@
+/*******************************************************************************
+ * @file LEDTransmitter.h
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief LED strips output stage.
+ *
+ * @details This file defines the LED strips transmitter interface and its
+ * FastLED backend. The transmitter sends the strips front buffers in the
+ * background while the next frame is rendered in the back buffers.
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+#ifndef __BSP_LED_TRANSMITTER_H_
+#define __BSP_LED_TRANSMITTER_H_
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+
+#include <cstdint>   /* Standard Int Types */
+#include <Arduino.h> /* Task and semaphore services */
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * STRUCTURES AND TYPES
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/************************* Imported global variables **************************/
+/* None */
+
+/************************* Exported global variables **************************/
+/* None */
+
+/************************** Static global variables ***************************/
+/* None */
+
+/*******************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * CLASSES
+ ******************************************************************************/
+
+/**
+ * @brief LED transmitter interface.
+ *
+ * @details LED transmitter interface. A transmitter sends the front buffers
+ * of all strips. Each call to Transmit must be preceded by a call to WaitDone,
+ * the strips buffers can only be swapped between these two calls. WaitDone
+ * can be called without a following Transmit when a frame is skipped.
+ */
+class LEDTransmitter
+{
+    public:
+        virtual ~LEDTransmitter(void) {};
+
+        /**
+         * @brief Starts sending the front buffers of all channels.
+         *
+         * @details Starts sending the front buffers of all channels. The
+         * function returns without waiting for the end of the transmission.
+         *
+         * @param[in] kBrightness The global brightness of the frame.
+         * @param[in] kFramePeriodUs The frame period, a transmission longer
+         * than the period is reported as an overrun.
+         */
+        virtual void Transmit(const uint8_t  kBrightness,
+                              const uint32_t kFramePeriodUs) = 0;
+
+        /**
+         * @brief Waits for the end of the current transmission, if any.
+         */
+        virtual void WaitDone(void) = 0;
+
+        /**
+         * @brief Tells if a transmission is in progress.
+         *
+         * @return true if a frame is being sent, false otherwise.
+         */
+        virtual bool IsBusy(void) = 0;
+};
+
+/**
+ * @brief FastLED transmitter.
+ *
+ * @details FastLED transmitter. The frames are shown by a dedicated task, its
+ * configuration is TASK_LED_TRANSMIT.
+ * FastLED's RMT driver starts all the channels before waiting for any of
+ * them, the strips are therefore sent in parallel.
+ */
+class FastLEDTransmitter : public LEDTransmitter
+{
+    public:
+        FastLEDTransmitter(void);
+        virtual ~FastLEDTransmitter(void);
+
+        virtual void Transmit(const uint8_t  kBrightness,
+                              const uint32_t kFramePeriodUs);
+        virtual void WaitDone(void);
+        virtual bool IsBusy(void);
+
+    protected:
+
+    private:
+        static void TransmitRoutine(void* pObjThis);
+
+        volatile uint8_t  brightness_;
+        volatile uint32_t framePeriodUs_;
+        SemaphoreHandle_t doneLock_;
+        TaskHandle_t      transmitThread_;
+};
+
+#endif /* #ifndef __BSP_LED_TRANSMITTER_H_ */
@@ -0,0 +1,122 @@
+/*******************************************************************************
+ * @file PixelArena.h
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief Pixel buffers arena.
+ *
+ * @details This file defines the arena used to allocate the LED strips pixel
+ * buffers. The arena is allocated once in a given memory (internal SRAM or
+ * PSRAM) and hands out buffers until it is full, buffers are never freed.
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+#ifndef __BSP_PIXEL_ARENA_H_
+#define __BSP_PIXEL_ARENA_H_
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+
+#include <cstdint> /* Standard Int Types */
+#include <cstddef> /* size_t */
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * STRUCTURES AND TYPES
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/************************* Imported global variables **************************/
+/* None */
+
+/************************* Exported global variables **************************/
+/* None */
+
+/************************** Static global variables ***************************/
+/* None */
+
+/*******************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * CLASSES
+ ******************************************************************************/
+
+/**
+ * @brief Pixel buffers arena class.
+ *
+ * @details Pixel buffers arena class. The buffers are word aligned so the
+ * packed color kernels can be used on them.
+ */
+class PixelArena
+{
+    /********************* PUBLIC METHODS AND ATTRIBUTES **********************/
+    public:
+        /**
+         * @brief Allocates the arena.
+         *
+         * @details Allocates the arena. When the PSRAM is requested but
+         * cannot be used, the arena falls back to the internal SRAM.
+         *
+         * @param[in] kSize The size of the arena in bytes.
+         * @param[in] kUsePsram Tells if the arena is placed in PSRAM.
+         */
+        PixelArena(const size_t kSize, const bool kUsePsram);
+        ~PixelArena(void);
+
+        /**
+         * @brief Allocates a buffer in the arena.
+         *
+         * @param[in] kSize The size of the buffer in bytes.
+         *
+         * @return The buffer, nullptr if the arena is full.
+         */
+        void* Allocate(const size_t kSize);
+
+        size_t GetSize(void) const;
+        size_t GetUsedSize(void) const;
+        bool IsPsram(void) const;
+
+    /******************* PROTECTED METHODS AND ATTRIBUTES *********************/
+    protected:
+
+    /********************* PRIVATE METHODS AND ATTRIBUTES *********************/
+    private:
+        uint8_t* pMemory_;
+        size_t   size_;
+        size_t   usedSize_;
+        bool     isPsram_;
+};
+
+#endif /* #ifndef __BSP_PIXEL_ARENA_H_ */
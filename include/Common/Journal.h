@@ -0,0 +1,262 @@
+/*******************************************************************************
+ * @file Journal.h
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief Storage journal.
+ *
+ * @details This file defines the append-only journal holding the stored
+ * configuration. Each record is identified by a type and a key and protected
+ * by a CRC. The last valid record of a type and key gives its value, an
+ * erase record removes it. Replaying the journal stops at the first invalid
+ * record, so a record torn by a power loss only drops the records written
+ * after it. The journal is compacted by rewriting the live records to a new
+ * file that replaces the journal once complete.
+ * The records are written to the flash in chunks of bounded size. A write
+ * gate can delay each chunk to a time where stalling the flash does not
+ * disturb the other tasks.
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+#ifndef __COMMON_JOURNAL_H_
+#define __COMMON_JOURNAL_H_
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+
+#include <cstdint>       /* Standard Int Types */
+#include <cstddef>       /* size_t */
+#include <unordered_map> /* std::unordered_map */
+#include <FS.h>          /* Filesystem services */
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+/* Size of a record header: MARKER 1B | TYPE 1B | KEY 2B | SIZE 2B | CRC 4B */
+#define JOURNAL_HEADER_SIZE 10
+
+/* Record types are 7 bits, the last bit marks the erase records */
+#define JOURNAL_TYPE_MAX 0x7F
+
+/* Maximal size of a flash write, one SPIFFS page */
+#define JOURNAL_CHUNK_SIZE 256
+
+/*******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * STRUCTURES AND TYPES
+ ******************************************************************************/
+
+/**
+ * @brief Replayed record routine, kpData is nullptr for erase records.
+ */
+typedef void (*JournalRecordRoutine)(void*          pParam,
+                                     const uint8_t  kType,
+                                     const uint16_t kKey,
+                                     const uint8_t* kpData,
+                                     const uint16_t kSize);
+
+/**
+ * @brief Write gate routine, called before each flash access with its expected
+ * stall in microseconds. Returns when the access can start.
+ */
+typedef void (*JournalGateRoutine)(void* pParam, const uint32_t kStallUs);
+
+/**
+ * @brief Write gate release routine, called after each gated flash access.
+ */
+typedef void (*JournalGateDoneRoutine)(void* pParam);
+
+/*******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/************************* Imported global variables **************************/
+/* None */
+
+/************************* Exported global variables **************************/
+/* None */
+
+/************************** Static global variables ***************************/
+/* None */
+
+/*******************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * CLASSES
+ ******************************************************************************/
+
+/**
+ * @brief Storage journal class.
+ *
+ * @details Storage journal class. The journal is not thread safe, the
+ * storage serializes its accesses.
+ */
+class Journal
+{
+    /********************* PUBLIC METHODS AND ATTRIBUTES **********************/
+    public:
+        Journal(void);
+
+        /**
+         * @brief Opens the journal and completes an interrupted compaction.
+         *
+         * @return true if a journal exists, false otherwise.
+         */
+        bool Open(void);
+
+        /**
+         * @brief Replays the valid records in the order they were written.
+         * The journal is read with a single sequential read.
+         *
+         * @param[in] pRoutine The routine called for each record.
+         * @param[in] pParam The routine parameter.
+         *
+         * @return true if the journal was read, false otherwise.
+         */
+        bool Replay(JournalRecordRoutine pRoutine, void* pParam);
+
+        /**
+         * @brief Starts writing records.
+         *
+         * @param[in] kCompact Writes a new journal that replaces the current
+         * one when ended, otherwise the records are appended.
+         *
+         * @return true if the journal is ready, false otherwise.
+         */
+        bool Begin(const bool kCompact);
+
+        /**
+         * @brief Writes a record.
+         *
+         * @param[in] kType The record type, up to JOURNAL_TYPE_MAX.
+         * @param[in] kKey The record key.
+         * @param[in] kpData The record data.
+         * @param[in] kSize The record data size.
+         *
+         * @return The number of bytes written, 0 on error.
+         */
+        size_t Append(const uint8_t  kType,
+                      const uint16_t kKey,
+                      const uint8_t* kpData,
+                      const size_t   kSize);
+
+        /**
+         * @brief Writes an erase record.
+         *
+         * @param[in] kType The record type, up to JOURNAL_TYPE_MAX.
+         * @param[in] kKey The record key.
+         *
+         * @return The number of bytes written, 0 on error.
+         */
+        size_t Erase(const uint8_t kType, const uint16_t kKey);
+
+        /**
+         * @brief Ends writing records, a compaction replaces the journal.
+         *
+         * @return true if all the records were written, false otherwise.
+         */
+        bool End(void);
+
+        /**
+         * @brief Removes the journal.
+         */
+        void Reset(void);
+
+        /**
+         * @brief Tells if the journal should be compacted: it is damaged or
+         * mostly made of outdated records.
+         *
+         * @return true if the journal should be compacted, false otherwise.
+         */
+        bool NeedsCompaction(void) const;
+
+        /**
+         * @brief Sets the routines called before and after each flash access.
+         *
+         * @param[in] pRoutine The gate routine, nullptr to write directly.
+         * @param[in] pDoneRoutine The release routine, called after the
+         * accesses when the gate routine is set.
+         * @param[in] pParam The routines parameter.
+         */
+        void SetWriteGate(JournalGateRoutine     pRoutine,
+                          JournalGateDoneRoutine pDoneRoutine,
+                          void*                  pParam);
+
+        /**
+         * @brief Gets the longest flash stall since the last Begin.
+         *
+         * @return The stall duration in microseconds.
+         */
+        uint32_t GetLongestStall(void) const;
+
+        size_t GetSize(void) const;
+        size_t GetLiveSize(void) const;
+
+    /******************* PROTECTED METHODS AND ATTRIBUTES *********************/
+    protected:
+
+    /********************* PRIVATE METHODS AND ATTRIBUTES *********************/
+    private:
+        void TrackRecord(const uint8_t  kType,
+                         const uint16_t kKey,
+                         const size_t   kRecordSize,
+                         const bool     kIsErase);
+        size_t Write(const uint8_t  kType,
+                     const uint16_t kKey,
+                     const uint8_t* kpData,
+                     const size_t   kSize);
+        void Stage(const uint8_t* kpData, const size_t kSize);
+        void WriteChunk(void);
+        void StartStall(const bool kIsChunk);
+        void EndStall(const bool kIsChunk);
+
+        File file_;
+        bool isWriting_;
+        bool isCompacting_;
+        /* The last records may be lost, the journal must be rewritten */
+        bool isDamaged_;
+
+        size_t size_;
+        size_t liveSize_;
+        /* Size of the live records, by type and key */
+        std::unordered_map<uint32_t, uint32_t> records_;
+
+        /* Bytes waiting for the next chunk write */
+        uint8_t chunk_[JOURNAL_CHUNK_SIZE];
+        size_t  chunkSize_;
+
+        JournalGateRoutine     gateRoutine_;
+        JournalGateDoneRoutine gateDoneRoutine_;
+        void*                  pGateParam_;
+        uint64_t               stallStart_;
+        /* Decaying maxima of the chunk writes and of the other accesses
+         * (open, close, rename) stalls, given to the gate.
+         */
+        uint32_t               chunkStallUs_;
+        uint32_t               fileStallUs_;
+        uint32_t               longestStallUs_;
+};
+
+#endif /* #ifndef __COMMON_JOURNAL_H_ */
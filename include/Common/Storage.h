@@ -9,7 +9,12 @@
  *
  * @brief Storage abstraction layer.
  *
- * @details This file provides the storage manager service.
+ * @details This file provides the storage manager service. The data is
+ * stored as records of the storage journal. Each pattern is its own record
+ * and tracked individually: a commit only appends the patterns that changed
+ * and erases the deleted ones. The changes are committed by the storage task
+ * once they stopped for a quiet period, or after a maximal delay, so the
+ * flash is never written by the UI loop or the BLE callbacks.
  *
  * @copyright Alexy Torres Aurora Dugo
  ******************************************************************************/
@@ -26,7 +31,9 @@
 #include <memory>  /* std::shared_ptr */
 #include <utility> /* std::pair */
 #include <unordered_map> /* std::unordered_map */
+#include <Arduino.h> /* FreeRTOS services */
 #include <Pattern.h> /* Patern object */
+#include <Journal.h> /* Storage journal */
 #include <StripsManager.h> /* Strip manager types */
 
 /*******************************************************************************
@@ -46,14 +53,40 @@
  ******************************************************************************/
 
 typedef std::pair<std::vector<std::shared_ptr<SScene>>, bool>  ScenesCache;
-typedef std::pair<std::vector<std::shared_ptr<Pattern>>, bool> PatternCache;
 typedef std::pair<std::string, bool>                           StringCache;
 typedef std::pair<uint8_t, bool>                               Uint8Cache;
+typedef std::pair<std::vector<SStripConfig>, bool>             StripsCache;
+
+typedef struct
+{
+    /* nullptr when the pattern was removed, it is erased on commit */
+    std::shared_ptr<Pattern> pattern;
+    bool                     isDirty;
+} SPatternCacheEntry;
+
+typedef std::unordered_map<uint16_t, SPatternCacheEntry> PatternCache;
+
+typedef struct
+{
+    uint8_t              type;
+    uint16_t             key;
+    bool                 isErase;
+    std::vector<uint8_t> data;
+} SStorageRecord;
 
 typedef struct
 {
     uint32_t totalSize;
     uint32_t usedSize;
+    /* Bytes written to the flash by the last commit and since boot */
+    uint32_t lastCommitBytes;
+    uint64_t totalBytesWritten;
+    uint32_t commitCount;
+    /* Longest flash stall in microseconds of the last commit and since
+     * boot.
+     */
+    uint32_t lastCommitStallUs;
+    uint32_t longestStallUs;
 } SStorageStats;
 
 /*******************************************************************************
@@ -93,14 +126,36 @@ class Storage
 
         void LoadData(void);
 
-        void Update(const bool kForce);
+        /**
+         * @brief Writes the pending changes to the flash, returns once they
+         * are written. Used before the power goes off.
+         */
+        void Flush(void);
 
         void GetPatterns(std::vector<std::shared_ptr<Pattern>>& rPatterns) const;
-        void SavePatterns(const std::vector<std::shared_ptr<Pattern>>& krPatterns);
+
+        /**
+         * @brief Saves a new or updated pattern, only this pattern record is
+         * appended on the next commit.
+         *
+         * @param[in] krPattern The pattern to save.
+         */
+        void SavePattern(const std::shared_ptr<Pattern>& krPattern);
+
+        /**
+         * @brief Removes a pattern, it is erased on the next commit.
+         *
+         * @param[in] kPatternId The pattern identifier.
+         */
+        void RemovePattern(const uint16_t kPatternId);
 
         void GetScenes(std::vector<std::shared_ptr<SScene>>& rScenes) const;
         void SaveScenes(const std::vector<std::shared_ptr<SScene>>& krScenes);
 
+        void GetStrips(std::vector<SStripConfig>& rStrips) const;
+        void SaveStrips(const std::vector<SStripConfig>& krStrips);
+
+        uint8_t GetSelectedScene(void) const;
         void SaveSelectedScene(const uint8_t kSelectedScene);
 
         uint8_t GetBrightness(void) const;
@@ -114,6 +169,19 @@ class Storage
 
         void GetStorageStats(SStorageStats& rState);
 
+        /**
+         * @brief Sets the routine that schedules the flash writes of the
+         * commits.
+         *
+         * @param[in] pRoutine The gate routine, nullptr to write directly.
+         * @param[in] pDoneRoutine The release routine, called after each
+         * gated write.
+         * @param[in] pParam The routines parameter.
+         */
+        void SetWriteGate(JournalGateRoutine     pRoutine,
+                          JournalGateDoneRoutine pDoneRoutine,
+                          void*                  pParam);
+
     /******************* PROTECTED METHODS AND ATTRIBUTES *********************/
     protected:
 
@@ -122,36 +190,116 @@ class Storage
         Storage(void);
 
         void Commit(const bool kForce);
+        void NotifyChange(void);
+        static void FlushRoutine(void* pObjThis);
+
+        /**
+         * @brief Writes the changed data to the journal.
+         *
+         * @param[in] kCompact Rewrites all the data to a new journal.
+         * @param[out] rWrittenBytes Incremented by the bytes written.
+         * @param[out] rStallUs Raised to the longest flash stall.
+         *
+         * @return true if the data was written, false otherwise.
+         */
+        bool WriteJournal(const bool kCompact,
+                          size_t&    rWrittenBytes,
+                          uint32_t&  rStallUs);
+
+        /**
+         * @brief Serializes the changed data and clears its change flags.
+         * A failed write damages the journal, the next commit then rewrites
+         * all the data.
+         *
+         * @param[in] kCompact Serializes all the data.
+         * @param[out] rRecords The records to write.
+         */
+        void CollectRecords(const bool                   kCompact,
+                            std::vector<SStorageRecord>& rRecords);
+
+        static void ReplayRecord(void*          pParam,
+                                 const uint8_t  kType,
+                                 const uint16_t kKey,
+                                 const uint8_t* kpData,
+                                 const uint16_t kSize);
+        void ApplyRecord(const uint8_t  kType,
+                         const uint16_t kKey,
+                         const uint8_t* kpData,
+                         const uint16_t kSize);
 
-        void WriteFile(const char* kpPath,
-                       const uint8_t* kpBuffer,
-                       size_t& rSize) const;
         void ReadFile(const char* kpPath,
                       uint8_t* pBuffer,
                       size_t& rSize) const;
-
-        void LoadPatterns(void);
-        void CommitPattern(const std::shared_ptr<Pattern>& krPattern) const;
-
-        void LoadScenes(void);
-        void CommitScenes(void) const;
+        void LoadLegacyData(const bool kLegacySpeed);
+        void LoadLegacyPatterns(const bool kLegacySpeed);
+        void RemoveLegacyData(void);
+
+        /**
+         * @brief Reads a pattern stored before the pattern image, its
+         * animations and colors are raw structures.
+         */
+        static std::shared_ptr<Pattern> DeserializeLegacyPattern(
+                                                const uint8_t* kpBuffer,
+                                                const size_t   kSize,
+                                                const bool     kLegacySpeed);
+
+        /**
+         * @brief Reads scenes stored before the versioned scenes record,
+         * their settings and links parameters are optional.
+         */
+        void DeserializeLegacyScenes(const uint8_t* kpBuffer,
+                                     const size_t   kSize);
+
+        /**
+         * @brief Reads a strips layout stored before the versioned strips
+         * record, the strips without a color mode are RGB strips.
+         */
+        void DeserializeLegacyStrips(const uint8_t* kpBuffer,
+                                     const size_t   kSize,
+                                     const bool     kHasModes);
+
+        void DeserializeScenes(const uint8_t* kpBuffer, const size_t kSize);
+        size_t SerializeScenes(uint8_t* pBuffer, const size_t kSize) const;
+
+        void DeserializeStrips(const uint8_t* kpBuffer, const size_t kSize);
+        size_t SerializeStrips(uint8_t* pBuffer, const size_t kSize) const;
 
         void FactoryReset(void);
 
-        bool     isInit_;
+        bool isInit_;
+
+        /* Protected by the lock */
         bool     needUpdate_;
-        uint64_t lastUpdateTime_;
+        /* Legacy records were replayed, the journal is rewritten */
+        bool     hasLegacyRecords_;
+        uint64_t firstChangeTime_;
+        uint64_t lastChangeTime_;
 
-        /* Cached data */
+        /* Cached data, protected by the lock */
         ScenesCache  scenes_;
         PatternCache patterns_;
         StringCache  pin_;
         StringCache  token_;
         Uint8Cache   brightness_;
         Uint8Cache   selectedScene_;
+        StripsCache  strips_;
+
+        /* Protected by the commit lock */
+        Journal journal_;
+
+        SemaphoreHandle_t lock_;
+        SemaphoreHandle_t commitLock_;
+        TaskHandle_t      flushThread_;
+
+        /* Flash writes statistics, protected by the lock */
+        uint32_t lastCommitBytes_;
+        uint64_t totalBytesWritten_;
+        uint32_t commitCount_;
+        uint32_t lastCommitStallUs_;
+        uint32_t longestStallUs_;
 
         /* Instance */
         static Storage* PINSTANCE_;
 };
 
-#endif /* #ifndef __COMMON_STORAGE_H_ */
\ No newline at end of file
+#endif /* #ifndef __COMMON_STORAGE_H_ */
\ No newline at end of file
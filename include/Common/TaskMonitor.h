@@ -0,0 +1,197 @@
+/*******************************************************************************
+ * @file TaskMonitor.h
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief Tasks configuration and monitoring.
+ *
+ * @details This file defines the configuration of the system tasks (priority,
+ * core and stack size) and the monitor that counts the tasks deadline
+ * overruns and records their stack usage. When a task overruns
+ * TASK_MISS_EVENT_COUNT consecutive periods, the task bit is set in the
+ * monitor event group.
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+#ifndef __COMMON_TASK_MONITOR_H_
+#define __COMMON_TASK_MONITOR_H_
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+
+#include <cstdint>   /* Standard Int Types */
+#include <Arduino.h> /* FreeRTOS services */
+#include <freertos/event_groups.h> /* FreeRTOS event groups */
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+/* Tasks configuration, stack sizes are in bytes. The LED tasks run above the
+ * UI so a busy menu or BLE exchange does not make the LEDs stutter.
+ */
+#define LED_WORKER_TASK_PRIO    5
+#define LED_WORKER_TASK_CORE    1
+#define LED_WORKER_TASK_STACK   4096
+
+#define LED_RENDER_TASK_PRIO    5
+#define LED_RENDER_TASK_CORE    0
+#define LED_RENDER_TASK_STACK   4096
+
+#define LED_TRANSMIT_TASK_PRIO  6
+#define LED_TRANSMIT_TASK_CORE  1
+#define LED_TRANSMIT_TASK_STACK 2048
+
+#define BLE_TASK_PRIO           2
+#define BLE_TASK_CORE           0
+#define BLE_TASK_STACK          4096
+
+#define STORAGE_TASK_PRIO       1
+#define STORAGE_TASK_CORE       0
+#define STORAGE_TASK_STACK      4096
+
+/* The UI runs in the Arduino loop task, its core is set by the Arduino core */
+#define UI_TASK_PRIO            1
+#define UI_TASK_CORE            ARDUINO_RUNNING_CORE
+#define UI_TASK_STACK           8192
+
+/* Number of consecutive overruns that raise a task event */
+#define TASK_MISS_EVENT_COUNT 5
+
+/*******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * STRUCTURES AND TYPES
+ ******************************************************************************/
+
+typedef enum
+{
+    TASK_LED_WORKER   = 0,
+    TASK_LED_RENDER   = 1,
+    TASK_LED_TRANSMIT = 2,
+    TASK_BLE          = 3,
+    TASK_STORAGE      = 4,
+    TASK_UI           = 5,
+    TASK_MAX_ID
+} ETaskId;
+
+typedef struct
+{
+    const char* kpName;
+    UBaseType_t priority;
+    BaseType_t  core;
+    uint32_t    stackSize;
+} STaskConfig;
+
+typedef struct
+{
+    uint32_t periods;
+    uint32_t overruns;
+    uint32_t consecutiveOverruns;
+    uint32_t missEvents;
+    /* Minimum free stack in bytes since the task started */
+    uint32_t stackHighWater;
+} STaskStats;
+
+/*******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/************************* Imported global variables **************************/
+/* None */
+
+/************************* Exported global variables **************************/
+/* None */
+
+/************************** Static global variables ***************************/
+/* None */
+
+/*******************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * CLASSES
+ ******************************************************************************/
+
+class TaskMonitor
+{
+    /********************* PUBLIC METHODS AND ATTRIBUTES **********************/
+    public:
+        static TaskMonitor* GetInstance(void);
+
+        static const STaskConfig& GetConfig(const ETaskId kTaskId);
+
+        /**
+         * @brief Creates a task with its configuration and monitors it.
+         *
+         * @param[in] kTaskId The task identifier.
+         * @param[in] pRoutine The task routine.
+         * @param[in] pParam The task routine parameter.
+         *
+         * @return The task handle, nullptr if the task could not be created.
+         */
+        TaskHandle_t CreateTask(const ETaskId  kTaskId,
+                                TaskFunction_t pRoutine,
+                                void*          pParam);
+
+        /**
+         * @brief Monitors a task that was not created by the monitor.
+         *
+         * @param[in] kTaskId The task identifier.
+         * @param[in] kHandle The task handle.
+         */
+        void RegisterTask(const ETaskId kTaskId, const TaskHandle_t kHandle);
+
+        /**
+         * @brief Reports the end of a task period.
+         *
+         * @param[in] kTaskId The task identifier.
+         * @param[in] kOverrun Tells if the task missed its deadline.
+         */
+        void ReportPeriod(const ETaskId kTaskId, const bool kOverrun);
+
+        void GetStats(const ETaskId kTaskId, STaskStats& rStats);
+
+        /**
+         * @brief Gets the monitor event group, bit N is set when the task N
+         * overruns TASK_MISS_EVENT_COUNT consecutive periods.
+         *
+         * @return The event group.
+         */
+        EventGroupHandle_t GetEventGroup(void) const;
+
+    /******************* PROTECTED METHODS AND ATTRIBUTES *********************/
+    protected:
+
+    /********************* PRIVATE METHODS AND ATTRIBUTES *********************/
+    private:
+        TaskMonitor(void);
+
+        TaskHandle_t       handles_[TASK_MAX_ID];
+        STaskStats         stats_[TASK_MAX_ID];
+        SemaphoreHandle_t  lock_;
+        EventGroupHandle_t events_;
+
+        static TaskMonitor* PINSTANCE_;
+};
+
+#endif /* #ifndef __COMMON_TASK_MONITOR_H_ */
@@ -91,6 +91,7 @@ class BLEManager
     private:
         BLEManager(void);
         void Init(void);
+        static void UpdateRoutine(void* pObjThis);
         uint8_t* SerializeStripsInfo(StripsInfoTable_t& rInfoTbl,
                                      size_t& rSize) const;
         uint8_t* SerializePatternsInfo(size_t& rSize) const;
@@ -107,10 +108,14 @@ class BLEManager
         BLECharacteristic* pCharacteristicGetStrips_;
         BLECharacteristic* pCharacteristicManagePatterns_;
         BLECharacteristic* pCharacteristicManageScenes_;
+        BLECharacteristic* pCharacteristicManageBatch_;
         BLECharacteristic* pCharacteristicSetScene_;
+        BLECharacteristic* pCharacteristicSetStrips_;
         BLEAdvertising*    pAdvertising_;
 
+        TaskHandle_t updateThread_;
+
         static BLEManager* PINSTANCE_;
 };
 
-#endif /* #ifndef __CORE_BLEMANAGER_H_ */
\ No newline at end of file
+#endif /* #ifndef __CORE_BLEMANAGER_H_ */
\ No newline at end of file
@@ -0,0 +1,157 @@
+/*******************************************************************************
+ * @file LinkIndex.h
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief Pattern links reverse index.
+ *
+ * @details This file defines the reverse index of the scene links. For each
+ * pattern, the index lists the scenes and strips that use it so pattern
+ * changes only visit the affected links. The index is updated incrementally
+ * when scenes are added, updated or removed.
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+#ifndef __CORE_LINK_INDEX_H_
+#define __CORE_LINK_INDEX_H_
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+
+#include <cstdint> /* Standard Int Types */
+#include <cstddef> /* size_t */
+#include <vector>  /* std::vector */
+#include <SceneLinks.h> /* Scene links container */
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * STRUCTURES AND TYPES
+ ******************************************************************************/
+
+typedef struct
+{
+    uint8_t sceneIdx;
+    uint8_t stripId;
+} SPatternUse;
+
+/*******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/************************* Imported global variables **************************/
+/* None */
+
+/************************* Exported global variables **************************/
+/* None */
+
+/************************** Static global variables ***************************/
+/* None */
+
+/*******************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * CLASSES
+ ******************************************************************************/
+
+/**
+ * @brief Pattern links reverse index class.
+ *
+ * @details Pattern links reverse index class. The uses are stored per pattern
+ * identifier, the scenes must only link existing patterns. The index is not
+ * thread safe, the manager lock protects it.
+ */
+class LinkIndex
+{
+    /********************* PUBLIC METHODS AND ATTRIBUTES **********************/
+    public:
+        /**
+         * @brief Adds the links of a scene to the index.
+         *
+         * @param[in] kSceneIdx The index of the scene.
+         * @param[in] krLinks The links of the scene.
+         */
+        void AddScene(const uint8_t kSceneIdx, const SceneLinks& krLinks);
+
+        /**
+         * @brief Removes the links of a scene from the index.
+         *
+         * @param[in] kSceneIdx The index of the scene.
+         * @param[in] krLinks The links of the scene.
+         */
+        void RemoveScene(const uint8_t kSceneIdx, const SceneLinks& krLinks);
+
+        /**
+         * @brief Updates the scene indices after a scene was erased from the
+         * scenes table, the following scenes move down by one.
+         *
+         * @param[in] kSceneIdx The index of the erased scene.
+         */
+        void ShiftScenes(const uint8_t kSceneIdx);
+
+        void RemoveLink(const uint8_t  kSceneIdx,
+                        const uint8_t  kStripId,
+                        const uint16_t kPatternId);
+
+        void RemovePattern(const uint16_t kPatternId);
+
+        /**
+         * @brief Gets the uses of a pattern.
+         *
+         * @param[in] kPatternId The pattern identifier.
+         *
+         * @return The scenes and strips that use the pattern.
+         */
+        const std::vector<SPatternUse>& GetUses(
+                                            const uint16_t kPatternId) const;
+
+        /**
+         * @brief Tells if a pattern is used by a scene.
+         *
+         * @param[in] kPatternId The pattern identifier.
+         * @param[in] kSceneIdx The index of the scene.
+         *
+         * @return true if the scene links the pattern, false otherwise.
+         */
+        bool IsUsedBy(const uint16_t kPatternId, const uint8_t kSceneIdx) const;
+
+        void Clear(void);
+        size_t GetHeapSize(void) const;
+
+    /******************* PROTECTED METHODS AND ATTRIBUTES *********************/
+    protected:
+
+    /********************* PRIVATE METHODS AND ATTRIBUTES *********************/
+    private:
+        std::vector<std::vector<SPatternUse>> uses_;
+
+        static const std::vector<SPatternUse> NO_USE_;
+};
+
+#endif /* #ifndef __CORE_LINK_INDEX_H_ */
@@ -9,7 +9,9 @@
  *
  * @brief LED strip pattern.
  *
- * @details This file provides the LED strip pattern class.
+ * @details This file provides the LED strip pattern class. A pattern is built
+ * from its animations, colors and palette, it is then packed in its stored
+ * image layout and read in place, see PatternImage.
  *
  * @copyright Alexy Torres Aurora Dugo
  ******************************************************************************/
@@ -22,13 +24,21 @@
  ******************************************************************************/
 
 #include <cstdint> /* Standard Int Types */
+#include <cstddef> /* size_t */
 #include <vector>  /* CPP vectors */
+#include <string>  /* std::string */
 
 /*******************************************************************************
  * CONSTANTS
  ******************************************************************************/
 
-/* None */
+/* Animation speeds are Q8.8 steps per reference frame period */
+#define ANIM_SPEED_FRAC_BITS 8
+#define ANIM_SPEED_UNIT      (1 << ANIM_SPEED_FRAC_BITS)
+#define ANIM_SPEED_PERIOD_US 10000
+
+/* Maximal number of entries of an indexed pattern palette */
+#define PATTERN_PALETTE_MAX 256
 
 /*******************************************************************************
  * MACROS
@@ -40,12 +50,17 @@
  * STRUCTURES AND TYPES
  ******************************************************************************/
 
+/* In indexed patterns, the breath and palette cycle ranges are palette
+ * entries, the trail ranges are LEDs.
+ */
 typedef enum
 {
     ANIM_TRAIL,
-    ANIM_BREATH
+    ANIM_BREATH,
+    ANIM_PALETTE_CYCLE
 } EAnimationType;
 
+/* In indexed patterns, the color codes are palette indices */
 typedef struct
 {
     uint16_t startIdx;
@@ -60,7 +75,8 @@ typedef struct
     uint8_t        type;
     uint16_t       startIdx;
     uint16_t       endIdx;
-    uint8_t        param;
+    /* Speed in Q8.8 steps (LEDs or brightness levels) per 10ms */
+    uint16_t       param;
 } SAnimation;
 
 /*******************************************************************************
@@ -99,18 +115,59 @@ class Pattern
         Pattern(const uint16_t kIdentifier,
                 const std::string& krName);
 
+        /* The setters are only used before the pattern is packed */
         void SetAnimations(const std::vector<SAnimation>& krAnimations);
         void SetColors(const std::vector<SColor>& krColors);
         void SetBrightness(const uint8_t kBrightness);
+        void SetPalette(const std::vector<uint32_t>& krPalette);
 
+        /* The animations, colors and palette are empty once packed */
         const std::vector<SAnimation>& GetAnimations(void) const;
         const std::vector<SColor>& GetColors(void) const;
         uint8_t GetBrightness(void) const;
+        const std::vector<uint32_t>& GetPalette(void) const;
+        bool IsIndexed(void) const;
+
+        /**
+         * @brief Packs the animations, colors and palette in the stored image
+         * layout and releases them.
+         *
+         * @details Packs the animations, colors and palette in the stored
+         * image layout and releases them. The compiler and the storage then
+         * read the image in place. Packing a packed pattern does nothing.
+         *
+         * @return true if the pattern is packed, false if it cannot be
+         * stored and stays unpacked.
+         */
+        bool Pack(void);
+
+        /**
+         * @brief Replaces the pattern by a copy of a stored image, the
+         * pattern is packed.
+         *
+         * @param[in] kpImage The image.
+         * @param[in] kSize The number of bytes available.
+         *
+         * @return true if the image is valid, false otherwise.
+         */
+        bool LoadImage(const uint8_t* kpImage, const size_t kSize);
+
+        bool IsPacked(void) const;
+        const uint8_t* GetImage(void) const;
+        size_t GetImageSize(void) const;
 
         void ForceId(const uint16_t kNewId);
         uint16_t GetId(void) const;
         const std::string& GetName(void) const;
 
+        /**
+         * @brief Gets the number of bytes used by the pattern object and its
+         * buffers, allocator overhead excluded.
+         *
+         * @return The number of bytes.
+         */
+        size_t GetHeapSize(void) const;
+
     /******************* PROTECTED METHODS AND ATTRIBUTES *********************/
     protected:
 
@@ -122,6 +179,10 @@ class Pattern
         uint8_t                 brightness_;
         std::vector<SAnimation> animations_;
         std::vector<SColor>     colors_;
+        std::vector<uint32_t>   palette_;
+
+        /* Stored image of a packed pattern, empty otherwise */
+        std::vector<uint8_t> image_;
 };
 
-#endif /* #ifndef __CORE_PATTERN_H_ */
\ No newline at end of file
+#endif /* #ifndef __CORE_PATTERN_H_ */
\ No newline at end of file
@@ -0,0 +1,243 @@
+/*******************************************************************************
+ * @file PatternCompiler.h
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief LED strip pattern compiler.
+ *
+ * @details This file defines the pattern compiler. A pattern is validated and
+ * lowered once for a given strip into a flat list of kernel calls with
+ * resolved arguments. The renderer then runs the lists without any check.
+ * Indexed patterns are lowered to operations on 8-bit palette indices and on
+ * the palette, the palette is expanded to RGB when the frame is output.
+ * Packed patterns are compiled from their stored image, read in place.
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+#ifndef __CORE_PATTERN_COMPILER_H_
+#define __CORE_PATTERN_COMPILER_H_
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+
+#include <cstdint> /* Standard Int Types */
+#include <cstddef> /* size_t */
+#include <vector>  /* std::vector */
+#include <Pattern.h> /* Pattern object */
+#include <PatternImage.h> /* Pattern stored image */
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * STRUCTURES AND TYPES
+ ******************************************************************************/
+
+/* Color operation, renders a range of the base frame (RGB or indices) */
+typedef struct SColorOp
+{
+    void (*pKernel)(uint8_t* pFrame, const struct SColorOp& krOp);
+
+    uint16_t startIdx;
+    uint16_t count;
+    uint32_t startColorCode;
+    uint32_t endColorCode;
+} SColorOp;
+
+/* Animation operation, renders a range of the frame or palette at a step */
+typedef struct SAnimOp
+{
+    void (*pKernel)(uint8_t*              pFrame,
+                    const uint8_t*        kpBase,
+                    const struct SAnimOp& krOp,
+                    const uint32_t        kStep);
+
+    uint16_t lowIdx;
+    uint16_t length;
+    uint8_t  level;
+    /* Number of steps in a cycle of the animation */
+    uint32_t period;
+    /* Q32.32 steps per microsecond */
+    uint64_t rate;
+} SAnimOp;
+
+/* Range of the base frame copied unchanged to the output frame */
+typedef struct
+{
+    uint16_t startIdx;
+    uint16_t count;
+} SFrameSpan;
+
+typedef struct
+{
+    uint16_t                ledCount;
+    uint8_t                 brightness;
+    bool                    isIndexed;
+    /* Packed RGB palette of indexed programs */
+    std::vector<uint8_t>    palette;
+    std::vector<SColorOp>   colorOps;
+    /* The base LEDs no trail moves, the trails write the others from the
+     * base so each LED of the frame is written once.
+     */
+    std::vector<SFrameSpan> baseSpans;
+    /* Operations before paletteIdx run on the frame, operations before
+     * scaleIdx run on the unscaled palette, the others run after the pattern
+     * brightness is applied (on the palette of indexed programs).
+     */
+    std::vector<SAnimOp>  animOps;
+    size_t                paletteIdx;
+    size_t                scaleIdx;
+} SPatternProgram;
+
+/*******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/************************* Imported global variables **************************/
+/* None */
+
+/************************* Exported global variables **************************/
+/* None */
+
+/************************** Static global variables ***************************/
+/* None */
+
+/*******************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * CLASSES
+ ******************************************************************************/
+
+/**
+ * @brief Pattern compiler class.
+ *
+ * @details Pattern compiler class. Ranges are clipped to the strip length,
+ * empty ranges are dropped and the animation types are resolved to their
+ * kernels.
+ */
+class PatternCompiler
+{
+    /********************* PUBLIC METHODS AND ATTRIBUTES **********************/
+    public:
+        /**
+         * @brief Checks that a pattern only uses known animation types,
+         * trails on disjoint ranges and, for indexed patterns, existing
+         * palette entries. A packed pattern image is checked in place.
+         *
+         * @param[in] krPattern The pattern to check.
+         *
+         * @return true if the pattern is valid, false otherwise.
+         */
+        static bool Validate(const Pattern& krPattern);
+
+        /**
+         * @brief Checks a pattern image, see Validate.
+         *
+         * @param[in] krImage The pattern image to check.
+         *
+         * @return true if the image is valid, false otherwise.
+         */
+        static bool Validate(const PatternImage& krImage);
+
+        /**
+         * @brief Compiles a pattern for a strip, a packed pattern is compiled
+         * from its image.
+         *
+         * @param[in] krPattern The pattern to compile.
+         * @param[in] kLedCount The number of LEDs of the strip.
+         * @param[out] rProgram The compiled program.
+         *
+         * @return true if the pattern was compiled, false if it is invalid.
+         */
+        static bool Compile(const Pattern&   krPattern,
+                            const uint16_t   kLedCount,
+                            SPatternProgram& rProgram);
+
+        /**
+         * @brief Compiles a pattern image for a strip, the image is read in
+         * place and can be released once compiled.
+         *
+         * @param[in] krImage The pattern image to compile.
+         * @param[in] kLedCount The number of LEDs of the strip.
+         * @param[out] rProgram The compiled program.
+         *
+         * @return true if the image was compiled, false if it is invalid.
+         */
+        static bool Compile(const PatternImage& krImage,
+                            const uint16_t      kLedCount,
+                            SPatternProgram&    rProgram);
+
+        /**
+         * @brief Copies the base LEDs that no trail moves to a frame, the
+         * frame operations of the program then write the other LEDs.
+         *
+         * @param[in] krProgram The compiled program.
+         * @param[out] pFrame The frame to write.
+         * @param[in] kpBase The base frame.
+         * @param[in] kPixelSize The size of an LED in the frames.
+         */
+        static void CopyBase(const SPatternProgram& krProgram,
+                             uint8_t*               pFrame,
+                             const uint8_t*         kpBase,
+                             const size_t           kPixelSize);
+
+    /******************* PROTECTED METHODS AND ATTRIBUTES *********************/
+    protected:
+
+    /********************* PRIVATE METHODS AND ATTRIBUTES *********************/
+    private:
+        static bool ValidateAnimation(const SAnimation& krAnim,
+                                      const size_t      kPaletteSize,
+                                      const uint16_t    kPatternId);
+        static bool ValidateTrails(const SAnimation& krAnim,
+                                   const SAnimation& krOther,
+                                   const uint16_t    kPatternId);
+        static bool ValidateColor(const SColor&  krColor,
+                                  const size_t   kPaletteSize,
+                                  const uint16_t kPatternId);
+        static void StartProgram(const uint8_t    kBrightness,
+                                 const uint16_t   kPaletteSize,
+                                 const uint16_t   kLedCount,
+                                 SPatternProgram& rProgram);
+        static void CompileAnimation(const SAnimation&     krAnim,
+                                     const uint16_t        kLedCount,
+                                     SPatternProgram&      rProgram,
+                                     std::vector<SAnimOp>& rPaletteOps,
+                                     std::vector<SAnimOp>& rPostScaleOps);
+        static void EndProgram(const std::vector<SAnimOp>& krPaletteOps,
+                               const std::vector<SAnimOp>& krPostScaleOps,
+                               SPatternProgram&            rProgram);
+        static void CompileColor(const SColor&    krColor,
+                                 const uint16_t   kLedCount,
+                                 SPatternProgram& rProgram);
+        static bool ClipAnimation(const SAnimation& krAnim,
+                                  const uint16_t    kLimit,
+                                  SAnimOp&          rOp);
+};
+
+#endif /* #ifndef __CORE_PATTERN_COMPILER_H_ */
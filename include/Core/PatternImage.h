@@ -0,0 +1,193 @@
+/*******************************************************************************
+ * @file PatternImage.h
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief LED strip pattern image.
+ *
+ * @details This file defines the stored form of a pattern. The image is a
+ * versioned packed layout with little-endian fields at offsets given by the
+ * header counts, it does not depend on the compiler structures layout. An
+ * image is read in place: the view decodes the fields from the image bytes,
+ * which can be a journal buffer or the image held by a packed pattern. The
+ * patterns of the pattern table are packed and compiled from their image.
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+#ifndef __CORE_PATTERN_IMAGE_H_
+#define __CORE_PATTERN_IMAGE_H_
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+
+#include <cstdint>   /* Standard Int Types */
+#include <cstddef>   /* size_t */
+#include <memory>    /* std::shared_ptr */
+#include <Pattern.h> /* Pattern object */
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+/* Images with another version are not read */
+#define PATTERN_IMAGE_VERSION 1
+
+/* Sizes of the image parts, the layout is described in Storage.txt */
+#define PATTERN_IMAGE_HEADER_SIZE 12
+#define PATTERN_IMAGE_ANIM_SIZE   7
+#define PATTERN_IMAGE_COLOR_SIZE  12
+#define PATTERN_IMAGE_ENTRY_SIZE  4
+
+/*******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * STRUCTURES AND TYPES
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/************************* Imported global variables **************************/
+/* None */
+
+/************************* Exported global variables **************************/
+/* None */
+
+/************************** Static global variables ***************************/
+/* None */
+
+/*******************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * CLASSES
+ ******************************************************************************/
+
+/**
+ * @brief Pattern image view class.
+ *
+ * @details Pattern image view class. The view does not copy the image, the
+ * image must outlive it. The accessors are only valid when IsValid returns
+ * true, the indices are not checked.
+ */
+class PatternImage
+{
+    /********************* PUBLIC METHODS AND ATTRIBUTES **********************/
+    public:
+        /**
+         * @brief Creates a view on an image and checks its version and size.
+         *
+         * @param[in] kpImage The image, no alignment is required.
+         * @param[in] kSize The number of bytes available, the image can be
+         * followed by other data.
+         */
+        PatternImage(const uint8_t* kpImage, const size_t kSize);
+
+        bool IsValid(void) const;
+
+        /**
+         * @brief Gets the size of the image, the next image of a sequence of
+         * images starts after it.
+         *
+         * @return The image size in bytes.
+         */
+        size_t GetSize(void) const;
+
+        uint16_t GetId(void) const;
+        uint8_t GetBrightness(void) const;
+        bool IsIndexed(void) const;
+
+        /**
+         * @brief Gets the pattern name, it is not null terminated.
+         *
+         * @return The name characters, GetNameSize long.
+         */
+        const char* GetName(void) const;
+        uint8_t GetNameSize(void) const;
+
+        uint8_t GetAnimationCount(void) const;
+        void GetAnimation(const uint8_t kIdx, SAnimation& rAnim) const;
+
+        uint8_t GetColorCount(void) const;
+        void GetColor(const uint8_t kIdx, SColor& rColor) const;
+
+        uint16_t GetPaletteSize(void) const;
+        uint32_t GetPaletteColor(const uint16_t kIdx) const;
+
+        /**
+         * @brief Creates an unpacked pattern object from the image, its
+         * animations, colors and palette can be read.
+         *
+         * @return The pattern, nullptr if the image is not valid.
+         */
+        std::shared_ptr<Pattern> ToPattern(void) const;
+
+        /**
+         * @brief Sets the pattern identifier of a valid image.
+         *
+         * @param[out] pImage The image.
+         * @param[in] kId The new identifier.
+         */
+        static void WriteId(uint8_t* pImage, const uint16_t kId);
+
+        /**
+         * @brief Gets the size of the image of a pattern.
+         *
+         * @param[in] krPattern The pattern.
+         *
+         * @return The image size in bytes, 0 if the pattern cannot be stored.
+         */
+        static size_t GetImageSize(const Pattern& krPattern);
+
+        /**
+         * @brief Writes the image of a pattern, a packed pattern image is
+         * copied.
+         *
+         * @param[in] krPattern The pattern.
+         * @param[out] pBuffer The image buffer.
+         * @param[in] kSize The buffer size.
+         *
+         * @return The image size in bytes, 0 on error.
+         */
+        static size_t Write(const Pattern& krPattern,
+                            uint8_t*       pBuffer,
+                            const size_t   kSize);
+
+    /******************* PROTECTED METHODS AND ATTRIBUTES *********************/
+    protected:
+
+    /********************* PRIVATE METHODS AND ATTRIBUTES *********************/
+    private:
+        const uint8_t* pImage_;
+        bool           isValid_;
+
+        /* Offsets of the image parts */
+        size_t animsOffset_;
+        size_t colorsOffset_;
+        size_t paletteOffset_;
+        size_t nameOffset_;
+};
+
+#endif /* #ifndef __CORE_PATTERN_IMAGE_H_ */
@@ -0,0 +1,194 @@
+/*******************************************************************************
+ * @file PatternTable.h
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief Pattern table.
+ *
+ * @details This file defines the table holding the patterns of the manager.
+ * The pattern identifier is the index of its slot in a dense table. Free
+ * slots are chained in a free list so allocating, removing and looking up a
+ * pattern is done in constant time. Each slot has a generation that changes
+ * when its pattern is replaced or removed, handles made of the identifier and
+ * the generation tell if a reference to a pattern is still current.
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+#ifndef __CORE_PATTERN_TABLE_H_
+#define __CORE_PATTERN_TABLE_H_
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+
+#include <cstdint> /* Standard Int Types */
+#include <cstddef> /* size_t */
+#include <vector>  /* std::vector */
+#include <memory>  /* std::shared_ptr */
+#include <Pattern.h> /* Pattern object */
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+/* Invalid pattern identifier, also ends the free list */
+#define PATTERN_TABLE_NO_ID 0xFFFF
+
+/*******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * STRUCTURES AND TYPES
+ ******************************************************************************/
+
+typedef struct
+{
+    uint16_t id;
+    uint16_t generation;
+} SPatternHandle;
+
+/*******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/************************* Imported global variables **************************/
+/* None */
+
+/************************* Exported global variables **************************/
+/* None */
+
+/************************** Static global variables ***************************/
+/* None */
+
+/*******************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * CLASSES
+ ******************************************************************************/
+
+/**
+ * @brief Pattern table class.
+ *
+ * @details Pattern table class. The table is not thread safe, the manager
+ * lock protects it. The inserted patterns are packed, they hold their stored
+ * image only.
+ */
+class PatternTable
+{
+    /********************* PUBLIC METHODS AND ATTRIBUTES **********************/
+    public:
+        PatternTable(void);
+
+        /**
+         * @brief Adds a pattern to a free slot and sets its identifier.
+         *
+         * @param[in] krPattern The pattern to add.
+         *
+         * @return The pattern identifier, PATTERN_TABLE_NO_ID if the table is
+         * full.
+         */
+        uint16_t Add(const std::shared_ptr<Pattern>& krPattern);
+
+        /**
+         * @brief Adds a pattern to the slot of its own identifier, used when
+         * loading stored patterns.
+         *
+         * @param[in] krPattern The pattern to add.
+         *
+         * @return true if the pattern was added, false if its identifier is
+         * invalid or already used.
+         */
+        bool Insert(const std::shared_ptr<Pattern>& krPattern);
+
+        /**
+         * @brief Replaces the pattern that has the same identifier.
+         *
+         * @param[in] krPattern The new pattern.
+         *
+         * @return true if the pattern was replaced, false if the identifier
+         * is unknown.
+         */
+        bool Replace(const std::shared_ptr<Pattern>& krPattern);
+
+        bool Remove(const uint16_t kPatternId);
+
+        /**
+         * @brief Gets a pattern.
+         *
+         * @param[in] kPatternId The pattern identifier.
+         *
+         * @return The pattern, nullptr if the identifier is unknown.
+         */
+        const std::shared_ptr<Pattern>* Find(const uint16_t kPatternId) const;
+
+        /**
+         * @brief Gets a pattern from a handle.
+         *
+         * @param[in] krHandle The pattern handle.
+         *
+         * @return The pattern, nullptr if the handle is stale.
+         */
+        const std::shared_ptr<Pattern>* Resolve(
+                                        const SPatternHandle& krHandle) const;
+
+        /**
+         * @brief Gets the handle of the current pattern of a slot.
+         *
+         * @param[in] kPatternId The pattern identifier.
+         *
+         * @return The handle, its identifier is PATTERN_TABLE_NO_ID if the
+         * identifier is unknown.
+         */
+        SPatternHandle GetHandle(const uint16_t kPatternId) const;
+
+        bool Contains(const uint16_t kPatternId) const;
+        size_t GetCount(void) const;
+        void GetIds(std::vector<uint16_t>& rPatternIds) const;
+        void GetPatterns(std::vector<std::shared_ptr<Pattern>>& rPatterns) const;
+
+        /**
+         * @brief Gets the number of heap bytes used by the table itself.
+         *
+         * @return The number of heap bytes.
+         */
+        size_t GetHeapSize(void) const;
+
+    /******************* PROTECTED METHODS AND ATTRIBUTES *********************/
+    protected:
+
+    /********************* PRIVATE METHODS AND ATTRIBUTES *********************/
+    private:
+        typedef struct
+        {
+            std::shared_ptr<Pattern> pattern;
+            uint16_t                 generation;
+            uint16_t                 nextFree;
+        } SPatternSlot;
+
+        void RebuildFreeList(void);
+
+        std::vector<SPatternSlot> slots_;
+        uint16_t                  freeHead_;
+        uint16_t                  count_;
+        bool                      isFreeListValid_;
+};
+
+#endif /* #ifndef __CORE_PATTERN_TABLE_H_ */
@@ -0,0 +1,199 @@
+/*******************************************************************************
+ * @file SceneLinks.h
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief Scene links container.
+ *
+ * @details This file defines the container of the links between the strips
+ * and the patterns of a scene. The links are kept sorted by strip identifier
+ * in a small vector: the first links are stored in the container itself and
+ * only bigger scenes spill to a single heap buffer. Each link carries the
+ * parameters applied to its pattern when it is rendered on the strip, so a
+ * pattern can be shared by links that show it differently.
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+#ifndef __CORE_SCENE_LINKS_H_
+#define __CORE_SCENE_LINKS_H_
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+
+#include <cstdint> /* Standard Int Types */
+#include <cstddef> /* size_t */
+#include <vector>  /* std::vector */
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+/* Number of links stored without heap allocation */
+#define SCENE_LINKS_INLINE_COUNT 4
+
+/* Link parameters that render the pattern unchanged */
+#define LINK_BRIGHTNESS_DEFAULT 255
+#define LINK_SPEED_DEFAULT      256
+#define LINK_PHASE_DEFAULT      0
+
+/* Link flags */
+#define LINK_FLAG_REVERSE 0x01
+#define LINK_FLAG_MIRROR  0x02
+
+/* Serialized size of the link parameters */
+#define LINK_PARAMS_SIZE 6
+
+/*******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * STRUCTURES AND TYPES
+ ******************************************************************************/
+
+typedef struct
+{
+    /* Scale of the pattern brightness, 255 keeps it */
+    uint8_t  brightness;
+    /* LINK_FLAG_* flags, the mirror is applied before the reverse */
+    uint8_t  flags;
+    /* Q8.8 scale of the animations speed */
+    uint16_t speed;
+    /* Animations start phase in 1/65536 of their period */
+    uint16_t phase;
+} SLinkParams;
+
+typedef struct
+{
+    uint8_t     stripId;
+    uint16_t    patternId;
+    SLinkParams params;
+} SSceneLink;
+
+/*******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/************************* Imported global variables **************************/
+/* None */
+
+/************************* Exported global variables **************************/
+/* None */
+
+/************************** Static global variables ***************************/
+/* None */
+
+/*******************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * CLASSES
+ ******************************************************************************/
+
+/**
+ * @brief Scene links container class.
+ *
+ * @details Scene links container class. A strip has at most one link in a
+ * scene, setting the link of a linked strip replaces its pattern. The links
+ * are iterated in increasing strip identifier order.
+ */
+class SceneLinks
+{
+    /********************* PUBLIC METHODS AND ATTRIBUTES **********************/
+    public:
+        SceneLinks(void);
+
+        /**
+         * @brief Links a strip to a pattern with the default parameters.
+         *
+         * @param[in] kStripId The strip identifier.
+         * @param[in] kPatternId The pattern identifier.
+         */
+        void Set(const uint8_t kStripId, const uint16_t kPatternId);
+
+        /**
+         * @brief Links a strip to a pattern.
+         *
+         * @param[in] kStripId The strip identifier.
+         * @param[in] kPatternId The pattern identifier.
+         * @param[in] krParams The link parameters.
+         */
+        void Set(const uint8_t      kStripId,
+                 const uint16_t     kPatternId,
+                 const SLinkParams& krParams);
+
+        /**
+         * @brief Removes the link of a strip.
+         *
+         * @param[in] kStripId The strip identifier.
+         *
+         * @return true if the strip was linked, false otherwise.
+         */
+        bool Erase(const uint8_t kStripId);
+
+        /**
+         * @brief Gets the link of a strip.
+         *
+         * @param[in] kStripId The strip identifier.
+         *
+         * @return The link, nullptr if the strip is not linked.
+         */
+        const SSceneLink* Find(const uint8_t kStripId) const;
+
+        size_t Size(void) const;
+
+        /**
+         * @brief Gets the number of bytes allocated on the heap for the
+         * links, zero while they fit in the container.
+         *
+         * @return The number of heap bytes.
+         */
+        size_t GetHeapSize(void) const;
+
+        /**
+         * @brief Tells if two links parameters render the same output.
+         *
+         * @param[in] krFirst The first parameters.
+         * @param[in] krSecond The second parameters.
+         *
+         * @return true if the parameters are equal, false otherwise.
+         */
+        static bool IsSameParams(const SLinkParams& krFirst,
+                                 const SLinkParams& krSecond);
+
+        const SSceneLink* begin(void) const;
+        const SSceneLink* end(void) const;
+
+    /******************* PROTECTED METHODS AND ATTRIBUTES *********************/
+    protected:
+
+    /********************* PRIVATE METHODS AND ATTRIBUTES *********************/
+    private:
+        SSceneLink* GetData(void);
+        const SSceneLink* GetData(void) const;
+        size_t LowerBound(const uint8_t kStripId) const;
+
+        uint16_t                count_;
+        bool                    isSpilled_;
+        SSceneLink              inline_[SCENE_LINKS_INLINE_COUNT];
+        std::vector<SSceneLink> spilled_;
+};
+
+#endif /* #ifndef __CORE_SCENE_LINKS_H_ */
@@ -24,15 +24,30 @@
 #include <cstdint>    /* Standard Int Types */
 #include <vector>     /* std::vector */
 #include <memory>     /* std::shared_ptr */
-#include <unordered_map> /* std::unordered_map */
+#include <atomic>     /* std::atomic */
+#include <esp_timer.h> /* Frame deadline timer */
 #include <LEDStrip.hpp> /* LED strip driver*/
+#include <LEDTransmitter.h> /* LED strips output stage */
 #include <Pattern.h>  /* Pattern object */
+#include <PatternCompiler.h> /* Pattern compiler */
+#include <PatternTable.h> /* Pattern table */
+#include <SceneLinks.h> /* Scene links container */
+#include <LinkIndex.h> /* Pattern links reverse index */
 
 /*******************************************************************************
  * CONSTANTS
  ******************************************************************************/
 
-/* None */
+/* Scenes frame rate, 0 selects the default */
+#define SCENE_FPS_DEFAULT 100
+#define SCENE_FPS_MAX     200
+
+/* Render stage that renders a step: the LED worker or the render helper,
+ * they run on different cores.
+ */
+#define RENDERER_WORKER 0
+#define RENDERER_HELPER 1
+#define RENDERER_COUNT  2
 
 /*******************************************************************************
  * MACROS
@@ -48,10 +63,85 @@ typedef std::vector<std::shared_ptr<SStripInfo>> StripsInfoTable_t;
 
 typedef struct
 {
-    std::string                           name;
-    std::unordered_map<uint8_t, uint16_t> links;
+    std::string name;
+    SceneLinks  links;
+    /* Target frame rate, 0 for SCENE_FPS_DEFAULT */
+    uint8_t     fps;
+    /* Transition from the previous scene when the scene is selected */
+    uint8_t     transition;
+    uint16_t    transitionMs;
 } SScene;
 
+typedef struct
+{
+    LEDStrip*                              pStrip;
+    std::shared_ptr<const Pattern>         pattern;
+    SPatternHandle                         patternHandle;
+    SLinkParams                            params;
+    std::shared_ptr<const SPatternProgram> program;
+    uint32_t                               revision;
+    uint8_t                                renderer;
+} SRenderStep;
+
+/* Immutable once published to the worker */
+typedef struct
+{
+    bool                     isActive;
+    bool                     isAnimated;
+    uint32_t                 sequence;
+    uint32_t                 framePeriodUs;
+    bool                     hasHelperWork;
+    /* Time of the scene selection that published the plan, 0 otherwise */
+    uint64_t                 selectTime;
+    /* Transition of the strips to the plan, only for selected scenes */
+    uint8_t                  transition;
+    uint32_t                 transitionUs;
+    std::vector<SRenderStep> steps;
+} SRenderSnapshot;
+
+typedef struct
+{
+    SRenderSnapshot* pSnapshot;
+    uint32_t         retireEpoch;
+} SRetiredSnapshot;
+
+/* Heap usage of the patterns and scenes, allocator overhead excluded */
+typedef struct
+{
+    size_t patternCount;
+    size_t patternsSize;
+    size_t tableSize;
+    size_t sceneCount;
+    size_t scenesSize;
+} SHeapReport;
+
+typedef struct
+{
+    uint32_t acquisitions;
+    uint32_t perSecond;
+} SLockStats;
+
+/* LED worker frame statistics, times in microseconds. The jitter is the
+ * difference between the measured and the target frame period, it is sampled
+ * on each frame that follows a scheduled one. The latency is the time between
+ * a frame deadline and the frame being sent. The scene latency is the time
+ * between a scene selection, or the strips being enabled again, and the end
+ * of the transmission of the scene first frame.
+ */
+typedef struct
+{
+    uint32_t framePeriodUs;
+    uint32_t frameCount;
+    uint32_t missedDeadlines;
+    uint32_t jitterSamples;
+    uint32_t lastJitterUs;
+    uint32_t meanJitterUs;
+    uint32_t maxJitterUs;
+    uint32_t worstLatencyUs;
+    uint32_t sceneLatencyUs;
+    uint32_t worstSceneLatencyUs;
+} SFrameStats;
+
 /*******************************************************************************
  * GLOBAL VARIABLES
  ******************************************************************************/
@@ -89,12 +179,24 @@ class StripsManager
 
         void GetStripsInfo(StripsInfoTable_t& rStripsInfo) const;
 
+        /**
+         * @brief Saves a new strips layout, applied on the next boot.
+         *
+         * @details Saves a new strips layout, applied on the next boot. The
+         * layout is checked with the rules of the boot: a layout with a
+         * strip without LED or two strips on the same GPIO is rejected.
+         *
+         * @param[in] krConfigs The strips configuration.
+         *
+         * @return true if the layout was saved, false otherwise.
+         */
+        bool SaveStripsLayout(const std::vector<SStripConfig>& krConfigs);
+
         uint16_t AddPattern(const std::shared_ptr<Pattern>& krNewPattern);
         bool RemovePattern(const uint16_t kPatternId);
         bool UpdatePattern(const std::shared_ptr<Pattern>& krNewPattern);
         const Pattern* GetPatternInfo(const uint16_t kPatternId);
         void GetPatternsIds(std::vector<uint16_t>& rPatternIds) const;
-        uint16_t GetNewPatternId(void);
 
         uint8_t AddScene(const std::shared_ptr<SScene>& krNewScene);
         bool RemoveScene(const uint8_t kSceneIdx);
@@ -108,11 +210,78 @@ class StripsManager
         void Lock(void);
         void Unlock(void);
 
+        /**
+         * @brief Starts a batch of edits.
+         *
+         * @details Starts a batch of edits. The manager stays locked by the
+         * calling task until CommitBatch, the other tasks and the LED worker
+         * see all the edits of the batch or none of them. Batches can be
+         * nested.
+         */
+        void BeginBatch(void);
+
+        /**
+         * @brief Ends a batch of edits.
+         *
+         * @details Ends a batch of edits. The render plan, the strips
+         * activity and the storage are updated once for all the edits of the
+         * outermost batch.
+         */
+        void CommitBatch(void);
+
         void Enable(void);
         void Disable(void);
         void Kill(void);
 
-        void CheckForActivity(void);
+        void NotifyBrightnessUpdate(void);
+
+        void GetHeapReport(SHeapReport& rReport);
+
+        /**
+         * @brief Gets the number of manager lock acquisitions, in total and
+         * over the last second.
+         *
+         * @param[out] rStats The lock statistics.
+         */
+        void GetLockStats(SLockStats& rStats);
+
+        void GetFrameStats(SFrameStats& rStats);
+        void ResetFrameStats(void);
+
+        /**
+         * @brief Waits for a gap between two frames where the flash can be
+         * written without delaying the next frame.
+         *
+         * @details Waits for a gap between two frames where the flash can be
+         * written without delaying the next frame. The gap starts when the
+         * frame is sent and ends at the next frame deadline. A write that
+         * does not fit in the gaps waits at most FRAME_GAP_WAIT_MAX_US.
+         * The gap is reserved until EndFrameGap, no frame is sent meanwhile.
+         *
+         * @param[in] kStallUs The expected duration of the write.
+         */
+        void WaitFrameGap(const uint32_t kStallUs);
+
+        /**
+         * @brief Ends the flash write started after WaitFrameGap, the next
+         * frame can be sent.
+         */
+        void EndFrameGap(void);
+
+        /**
+         * @brief Splits the steps of a render plan between the renderers.
+         *
+         * @details Splits the steps of a render plan between the renderers,
+         * the most expensive remaining step goes to the least loaded
+         * renderer. The worker is the renderer 0 and is loaded first on
+         * ties. The device runs RENDERER_COUNT renderers, the host tests
+         * measure the scaling with more.
+         *
+         * @param[in, out] rSnapshot The plan, its steps renderers are set.
+         * @param[in] kRendererCount The number of renderers.
+         */
+        static void BalanceRenderPlan(SRenderSnapshot& rSnapshot,
+                                      const uint8_t    kRendererCount);
 
     /******************* PROTECTED METHODS AND ATTRIBUTES *********************/
     protected:
@@ -121,28 +290,130 @@ class StripsManager
     private:
         StripsManager(void);
 
+        /**
+         * @brief Checks the strips of a layout, the invalid strips are not
+         * created.
+         *
+         * @param[in] krConfigs The strips configuration.
+         * @param[out] rIsValid Set to the validity of each strip.
+         *
+         * @return true if all the strips are valid, false otherwise.
+         */
+        static bool ValidateStrips(const std::vector<SStripConfig>& krConfigs,
+                                   std::vector<bool>&               rIsValid);
+        void CreateStrips(const std::vector<SStripConfig>& krConfigs);
         void AddStrip(const std::shared_ptr<LEDStrip>& krNewStrip);
+        LEDStrip* FindStrip(const uint8_t kStripId) const;
+        bool CheckSceneLinks(const SScene& krScene) const;
         void ActivateScene(void);
+        void UpdateActivity(void);
+        void PublishStripsEnable(void);
+        bool UpdateStripsEnable(void);
+        void BuildRenderPlan(const bool kRestart);
+        void ReclaimSnapshots(void);
+        void WakeWorker(const uint32_t kReasons);
+
+        /**
+         * @brief Waits for the next frame of the LED worker schedule.
+         *
+         * @details Waits for the next frame deadline, the wake up reasons
+         * received meanwhile are coalesced and rendered on that frame. The
+         * schedule restarts when the deadline is more than a frame period
+         * old. Called by the worker without the work lock held.
+         *
+         * @param[in, out] rDeadline The next frame deadline, 0 for an
+         * unscheduled frame.
+         * @param[in, out] rLastStartTime The start time of the last frame.
+         *
+         * @return The received wake up reasons.
+         */
+        uint32_t WaitNextFrame(uint64_t& rDeadline, uint64_t& rLastStartTime);
 
         static void UpdateRoutine(void* objThis);
+        static void RenderRoutine(void* objThis);
+        static void FrameGapRoutine(void* pObjThis, const uint32_t kStallUs);
+        static void FrameGapDoneRoutine(void* pObjThis);
+        static void FrameTimerRoutine(void* pObjThis);
+        void UpdateFrameStats(const uint64_t kStartTime,
+                              const uint64_t kEndTime,
+                              const uint64_t kDeadline,
+                              const uint64_t kLastStartTime,
+                              const uint32_t kFramePeriodUs);
 
-        void SavePatterns(void);
         void SaveScenes(void);
-        void SaveSelectedScene(void) const;
-
-        bool isEnabled_;
-
-        std::unordered_map<uint8_t, std::shared_ptr<LEDStrip>> strips_;
-        std::unordered_map<uint16_t, std::shared_ptr<Pattern>> patterns_;
-        std::vector<std::shared_ptr<SScene>>                   scenes_;
-        uint8_t                                                selectedScene_;
+        void SaveSelectedScene(void);
+
+        /* Protected by the work lock */
+        bool     isEnabled_;
+        uint64_t enableTime_;
+        /* Global brightness is not zero, activity input */
+        bool isLit_;
+        /* Strips power requests are pending, applied by the worker */
+        std::atomic<bool> stripsUpdate_;
+
+        /* Sorted by strip identifier */
+        std::vector<std::shared_ptr<LEDStrip>> strips_;
+        PatternTable                           patterns_;
+        LinkIndex                              linkIndex_;
+        std::vector<std::shared_ptr<SScene>>   scenes_;
+        uint8_t                                selectedScene_;
+        uint64_t                               sceneSelectTime_;
+
+        /* Protected by the manager lock */
+        uint8_t batchDepth_;
+        uint8_t batchPending_;
+
+        std::atomic<SRenderSnapshot*> pRenderSnapshot_;
+        std::atomic<uint32_t>         workerEpoch_;
+        /* Frame period of the published snapshot, read by the waiting
+         * worker.
+         */
+        std::atomic<uint32_t>         framePeriodUs_;
+        std::vector<SRetiredSnapshot> retiredSnapshots_;
+        uint32_t                      planRevision_;
+        uint32_t                      planSequence_;
+
+        /* Protected by the work lock */
+        SFrameStats frameStats_;
+        uint64_t    jitterSum_;
+        /* End of the current flash write gap, 0 while a frame is rendered */
+        uint64_t    frameGapEnd_;
+
+        /* Given by the worker when a frame gap starts */
+        SemaphoreHandle_t frameGapSem_;
+        /* Set under the work lock when a write is admitted in a frame gap,
+         * the worker sends no frame until the write ends.
+         */
+        std::atomic<bool> isFlashWriting_;
+        /* Given when an admitted write ends */
+        SemaphoreHandle_t flashDoneSem_;
 
         SemaphoreHandle_t threadWorkLock_;
         SemaphoreHandle_t managerLock_;
 
+        std::atomic<uint32_t> lockCount_;
+        std::atomic<uint32_t> lockRate_;
+        uint64_t              lockWindowStart_;
+        uint32_t              lockWindowCount_;
+
         TaskHandle_t workerThread_;
 
+        /* Wakes the worker before its frame deadlines */
+        esp_timer_handle_t frameTimer_;
+
+        /* Render helper, renders a part of the worker frame on the other
+         * core.
+         */
+        TaskHandle_t           renderThread_;
+        SemaphoreHandle_t      renderDoneSem_;
+        const SRenderSnapshot* pHelperSnapshot_;
+        uint64_t               helperFrameTime_;
+
+        std::shared_ptr<LEDTransmitter> pTransmitter_;
+        std::shared_ptr<PixelArena>     pSramArena_;
+        std::shared_ptr<PixelArena>     pPsramArena_;
+
         static StripsManager* PINSTANCE_;
 };
 
-#endif /* #ifndef __CORE_STRIPS_MANAGER_H_ */
\ No newline at end of file
+#endif /* #ifndef __CORE_STRIPS_MANAGER_H_ */
\ No newline at end of file
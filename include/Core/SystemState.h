@@ -111,6 +111,12 @@ class SystemState
         void Init(void);
 
         void UpdateState(void);
+
+        /**
+         * @brief Logs the statistics of the tasks that raised an overrun
+         * event since the last check.
+         */
+        void CheckTasks(void);
         void SetSystemState(const ESystemState kNewState);
         void ManageIdle(void);
         void ManageMenu0(void);
@@ -0,0 +1,321 @@
+/*******************************************************************************
+ * @file ColorKernels.cpp
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief Color rendering kernels.
+ *
+ * @details This file provides the fixed-point kernels used to render colors in
+ * the LED strips buffers: solid fill, linear gradient and brightness scaling.
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include <cstdint> /* Standard Int Types */
+#include <cstring> /* memcpy */
+
+/* Header File */
+#include <ColorKernels.h>
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+/* Masks of the even and odd bytes of a packed word */
+#define EVEN_BYTES_MASK 0x00FF00FFU
+#define ODD_BYTES_MASK  0xFF00FF00U
+
+/* Number of pixels written by one packed fill block (3 words) */
+#define FILL_BLOCK_PIXELS 4
+
+/*******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+#define IS_WORD_ALIGNED(PTR) ((((uintptr_t)(PTR)) & 0x3) == 0)
+
+/*******************************************************************************
+ * STRUCTURES AND TYPES
+ ******************************************************************************/
+
+/* Word type allowed to alias the byte buffers */
+typedef uint32_t __attribute__((__may_alias__)) PackedWord_t;
+
+/*******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/************************* Imported global variables **************************/
+/* None */
+
+/************************* Exported global variables **************************/
+/* None */
+
+/************************** Static global variables ***************************/
+/* None */
+
+/*******************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * CLASS METHODS
+ ******************************************************************************/
+
+void ColorKernels::Fill(uint8_t*       pPixels,
+                        const uint32_t kCount,
+                        const uint32_t kColorCode)
+{
+#if COLOR_KERNELS_PACKED_PATH
+    FillPacked(pPixels, kCount, kColorCode);
+#else
+    FillScalar(pPixels, kCount, kColorCode);
+#endif
+}
+
+void ColorKernels::Gradient(uint8_t*       pPixels,
+                            const uint32_t kCount,
+                            const uint32_t kStartColorCode,
+                            const uint32_t kEndColorCode)
+{
+    uint32_t i;
+    uint8_t  channel;
+    int32_t  delta;
+    int32_t  steps;
+    int32_t  pAcc[COLOR_KERNELS_PIXEL_SIZE];
+    int32_t  pStep[COLOR_KERNELS_PIXEL_SIZE];
+
+    if(kCount < 2)
+    {
+        FillScalar(pPixels, kCount, kStartColorCode);
+        return;
+    }
+
+    /* Setup the Q16.16 accumulators, the step is rounded and the accumulator
+     * starts at half a unit so the last pixel lands exactly on the end color.
+     */
+    steps = (int32_t)kCount - 1;
+    for(channel = 0; channel < COLOR_KERNELS_PIXEL_SIZE; ++channel)
+    {
+        pAcc[channel] = (int32_t)((kStartColorCode >> (16 - channel * 8)) &
+                                  0xFF);
+        delta         = (int32_t)((kEndColorCode >> (16 - channel * 8)) &
+                                  0xFF) - pAcc[channel];
+
+        pAcc[channel] = (pAcc[channel] << 16) + 0x8000;
+        if(delta >= 0)
+        {
+            pStep[channel] = ((delta << 16) + steps / 2) / steps;
+        }
+        else
+        {
+            pStep[channel] = -((((-delta) << 16) + steps / 2) / steps);
+        }
+    }
+
+    for(i = 0; i < kCount; ++i)
+    {
+        pPixels[0] = (uint8_t)(pAcc[0] >> 16);
+        pPixels[1] = (uint8_t)(pAcc[1] >> 16);
+        pPixels[2] = (uint8_t)(pAcc[2] >> 16);
+        pAcc[0] += pStep[0];
+        pAcc[1] += pStep[1];
+        pAcc[2] += pStep[2];
+        pPixels += COLOR_KERNELS_PIXEL_SIZE;
+    }
+}
+
+void ColorKernels::Scale(uint8_t*       pDst,
+                         const uint8_t* kpSrc,
+                         const uint32_t kCount,
+                         const uint8_t  kScale)
+{
+    if(kScale == 255)
+    {
+        if(pDst != kpSrc)
+        {
+            memmove(pDst, kpSrc, kCount * COLOR_KERNELS_PIXEL_SIZE);
+        }
+        return;
+    }
+
+#if COLOR_KERNELS_PACKED_PATH
+    ScalePacked(pDst,
+                kpSrc,
+                kCount * COLOR_KERNELS_PIXEL_SIZE,
+                (uint32_t)kScale + 1);
+#else
+    ScaleScalar(pDst,
+                kpSrc,
+                kCount * COLOR_KERNELS_PIXEL_SIZE,
+                (uint32_t)kScale + 1);
+#endif
+}
+
+void ColorKernels::Expand(uint8_t*       pDst,
+                          const uint8_t* kpIndices,
+                          const uint8_t* kpPalette,
+                          const uint32_t kCount)
+{
+    uint32_t       i;
+    const uint8_t* kpEntry;
+
+    for(i = 0; i < kCount; ++i)
+    {
+        kpEntry = kpPalette + (uint32_t)kpIndices[i] * COLOR_KERNELS_PIXEL_SIZE;
+        pDst[0] = kpEntry[0];
+        pDst[1] = kpEntry[1];
+        pDst[2] = kpEntry[2];
+        pDst += COLOR_KERNELS_PIXEL_SIZE;
+    }
+}
+
+void ColorKernels::Blend(uint8_t*       pDst,
+                         const uint8_t* kpFrom,
+                         const uint8_t* kpTo,
+                         const uint32_t kCount,
+                         const uint16_t kWeight)
+{
+    uint32_t i;
+    uint32_t fromWeight;
+
+    fromWeight = 256 - (uint32_t)kWeight;
+    for(i = 0; i < kCount * COLOR_KERNELS_PIXEL_SIZE; ++i)
+    {
+        pDst[i] = (uint8_t)(((uint32_t)kpFrom[i] * fromWeight +
+                             (uint32_t)kpTo[i] * kWeight) >> 8);
+    }
+}
+
+void ColorKernels::FillScalar(uint8_t*       pPixels,
+                              const uint32_t kCount,
+                              const uint32_t kColorCode)
+{
+    uint32_t i;
+    uint8_t  red;
+    uint8_t  green;
+    uint8_t  blue;
+
+    red   = (uint8_t)(kColorCode >> 16);
+    green = (uint8_t)(kColorCode >> 8);
+    blue  = (uint8_t)kColorCode;
+
+    for(i = 0; i < kCount; ++i)
+    {
+        pPixels[0] = red;
+        pPixels[1] = green;
+        pPixels[2] = blue;
+        pPixels += COLOR_KERNELS_PIXEL_SIZE;
+    }
+}
+
+void ColorKernels::ScaleScalar(uint8_t*       pDst,
+                               const uint8_t* kpSrc,
+                               const uint32_t kSize,
+                               const uint32_t kMult)
+{
+    uint32_t i;
+
+    for(i = 0; i < kSize; ++i)
+    {
+        pDst[i] = (uint8_t)(((uint32_t)kpSrc[i] * kMult) >> 8);
+    }
+}
+
+#if COLOR_KERNELS_PACKED_PATH
+
+void ColorKernels::FillPacked(uint8_t*       pPixels,
+                              const uint32_t kCount,
+                              const uint32_t kColorCode)
+{
+    uint32_t     i;
+    uint32_t     left;
+    uint8_t      pBlock[FILL_BLOCK_PIXELS * COLOR_KERNELS_PIXEL_SIZE];
+    PackedWord_t pWords[3];
+    PackedWord_t* pOut;
+
+    /* Align the output on a word, at most 3 pixels are needed */
+    left = kCount;
+    while(left > 0 && IS_WORD_ALIGNED(pPixels) == false)
+    {
+        FillScalar(pPixels, 1, kColorCode);
+        pPixels += COLOR_KERNELS_PIXEL_SIZE;
+        --left;
+    }
+
+    /* Build the 4 pixels pattern spanning 3 words */
+    FillScalar(pBlock, FILL_BLOCK_PIXELS, kColorCode);
+    memcpy(pWords, pBlock, sizeof(pBlock));
+
+    pOut = (PackedWord_t*)pPixels;
+    for(i = 0; i < left / FILL_BLOCK_PIXELS; ++i)
+    {
+        pOut[0] = pWords[0];
+        pOut[1] = pWords[1];
+        pOut[2] = pWords[2];
+        pOut += 3;
+    }
+
+    /* Tail */
+    FillScalar((uint8_t*)pOut, left % FILL_BLOCK_PIXELS, kColorCode);
+}
+
+void ColorKernels::ScalePacked(uint8_t*       pDst,
+                               const uint8_t* kpSrc,
+                               const uint32_t kSize,
+                               const uint32_t kMult)
+{
+    uint32_t            left;
+    uint32_t            word;
+    uint32_t            even;
+    uint32_t            odd;
+    PackedWord_t*       pOut;
+    const PackedWord_t* kpIn;
+
+    /* Align the output on a word */
+    left = kSize;
+    while(left > 0 && IS_WORD_ALIGNED(pDst) == false)
+    {
+        *pDst++ = (uint8_t)(((uint32_t)*kpSrc++ * kMult) >> 8);
+        --left;
+    }
+
+    /* Source and destination must share the same alignment to use words */
+    if(IS_WORD_ALIGNED(kpSrc) == false)
+    {
+        ScaleScalar(pDst, kpSrc, left, kMult);
+        return;
+    }
+
+    /* Two channels per 16-bit lane, c * m <= 0xFF00 so lanes never carry */
+    pOut = (PackedWord_t*)pDst;
+    kpIn = (const PackedWord_t*)kpSrc;
+    while(left >= sizeof(uint32_t))
+    {
+        word = *kpIn++;
+        even = (((word & EVEN_BYTES_MASK) * kMult) >> 8) & EVEN_BYTES_MASK;
+        odd  = (((word >> 8) & EVEN_BYTES_MASK) * kMult) & ODD_BYTES_MASK;
+        *pOut++ = even | odd;
+        left -= sizeof(uint32_t);
+    }
+
+    /* Tail */
+    ScaleScalar((uint8_t*)pOut, (const uint8_t*)kpIn, left, kMult);
+}
+
+#endif /* #if COLOR_KERNELS_PACKED_PATH */
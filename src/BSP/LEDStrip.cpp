@@ -0,0 +1,668 @@
+/*******************************************************************************
+ * @file LEDStrip.cpp
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief This file provides the LED strip driver.
+ *
+ * @details This file provides the LED strip driver used in the ESP32 module.
+ * The strips are configured at runtime, their pixel buffers come from a pixel
+ * arena and their FastLED controller is selected from the data GPIO.
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include <cstdint>        /* Standard Int Types */
+#include <cstring>        /* memcpy */
+#include <Arduino.h>      /* Arduino Services */
+#include <FastLED.h>      /* FastLED driver */
+#include <Logger.h>       /* Logger service */
+#include <ColorKernels.h> /* Color rendering kernels */
+
+/* Header File */
+#include <LEDStrip.hpp>
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+/* FastLED needs the data pin at compile time, one controller type is
+ * instantiated per supported GPIO whatever the number of strips.
+ */
+#define STRIP_GPIO_CASE(PIN)                                                 \
+    case PIN:                                                                \
+        return &FastLED.addLeds<WS2812B, PIN, GRB>(pLeds, (int)kNumLeds);
+
+/*******************************************************************************
+ * STRUCTURES AND TYPES
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/************************* Imported global variables **************************/
+/* None */
+
+/************************* Exported global variables **************************/
+/* None */
+
+/************************** Static global variables ***************************/
+/* None */
+
+/*******************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ ******************************************************************************/
+
+static CLEDController* AddController(const gpio_num_t kGpio,
+                                     CRGB*            pLeds,
+                                     const uint16_t   kNumLeds);
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+static CLEDController* AddController(const gpio_num_t kGpio,
+                                     CRGB*            pLeds,
+                                     const uint16_t   kNumLeds)
+{
+    /* ESP32-S3 output GPIOs not used by the flash, PSRAM and USB */
+    switch((uint8_t)kGpio)
+    {
+        STRIP_GPIO_CASE(1)
+        STRIP_GPIO_CASE(2)
+        STRIP_GPIO_CASE(3)
+        STRIP_GPIO_CASE(4)
+        STRIP_GPIO_CASE(5)
+        STRIP_GPIO_CASE(6)
+        STRIP_GPIO_CASE(7)
+        STRIP_GPIO_CASE(8)
+        STRIP_GPIO_CASE(9)
+        STRIP_GPIO_CASE(10)
+        STRIP_GPIO_CASE(11)
+        STRIP_GPIO_CASE(12)
+        STRIP_GPIO_CASE(13)
+        STRIP_GPIO_CASE(14)
+        STRIP_GPIO_CASE(15)
+        STRIP_GPIO_CASE(16)
+        STRIP_GPIO_CASE(17)
+        STRIP_GPIO_CASE(18)
+        STRIP_GPIO_CASE(21)
+        STRIP_GPIO_CASE(38)
+        STRIP_GPIO_CASE(39)
+        STRIP_GPIO_CASE(40)
+        STRIP_GPIO_CASE(41)
+        STRIP_GPIO_CASE(42)
+        STRIP_GPIO_CASE(47)
+        STRIP_GPIO_CASE(48)
+        default:
+            LOG_ERROR("GPIO %d cannot drive a LED strip\n", kGpio);
+            return nullptr;
+    }
+}
+
+/*******************************************************************************
+ * CLASS METHODS
+ ******************************************************************************/
+
+LEDStripC::LEDStripC(const SStripConfig& krConfig, PixelArena& rArena)
+{
+    name_          = krConfig.name;
+    numLeds_       = krConfig.numLed;
+    gpio_          = krConfig.ctrlGPIO;
+    mosfetGpio_    = krConfig.mosfetGPIO;
+    isIndexed_     = krConfig.isIndexed;
+    isEnabled_     = true;
+    requestedEnable_.store(false);
+    frameDirty_    = false;
+    revision_      = 0;
+    lastTime_      = 0;
+    isTimeStale_   = false;
+    maxBrightness_ = 0;
+    linkFlags_     = 0;
+    linkSpeed_     = LINK_SPEED_DEFAULT;
+    newFrame_      = false;
+    pCtrl_         = nullptr;
+    isFrontShown_  = false;
+
+    transitionType_  = LED_TRANSITION_CUT;
+    transitionUs_    = 0;
+    transitionStart_ = 0;
+
+    /* Get the buffers from the arena, the base frame of indexed strips
+     * is made of indices and a palette.
+     */
+    pFrontLeds_ = (CRGB*)rArena.Allocate(numLeds_ * sizeof(CRGB));
+    pBackLeds_  = (CRGB*)rArena.Allocate(numLeds_ * sizeof(CRGB));
+    pTransitionLeds_ = (CRGB*)rArena.Allocate(numLeds_ * sizeof(CRGB));
+    if(isIndexed_ == true)
+    {
+        pBaseLeds_ = nullptr;
+        pIndices_  = (uint8_t*)rArena.Allocate(2 * numLeds_);
+        pPalette_  = (CRGB*)rArena.Allocate(PATTERN_PALETTE_MAX *
+                                            sizeof(CRGB));
+    }
+    else
+    {
+        pBaseLeds_ = (CRGB*)rArena.Allocate(numLeds_ * sizeof(CRGB));
+        pIndices_  = nullptr;
+        pPalette_  = nullptr;
+    }
+
+    SetEnabled(false);
+
+    if(pFrontLeds_ == nullptr || pBackLeds_ == nullptr ||
+       pTransitionLeds_ == nullptr ||
+       (isIndexed_ == false && pBaseLeds_ == nullptr) ||
+       (isIndexed_ == true && (pIndices_ == nullptr || pPalette_ == nullptr)))
+    {
+        LOG_ERROR("Could not allocate buffers of strip %s\n", name_.c_str());
+        return;
+    }
+
+    ColorKernels::Fill((uint8_t*)pFrontLeds_, numLeds_, 0);
+    ColorKernels::Fill((uint8_t*)pBackLeds_, numLeds_, 0);
+
+    pCtrl_ = AddController(gpio_, pFrontLeds_, numLeds_);
+    if(pCtrl_ != nullptr)
+    {
+        pCtrl_->setCorrection(TypicalLEDStrip);
+    }
+}
+
+LEDStripC::~LEDStripC(void)
+{
+}
+
+size_t LEDStripC::GetBuffersSize(const uint16_t kLedCount,
+                                 const bool     kIsIndexed)
+{
+    size_t frameSize;
+
+    /* Front, back and transition frames, then the base frame or the indices
+     * and the palette. Each buffer is word aligned in the arena.
+     */
+    frameSize = ((size_t)kLedCount * sizeof(CRGB) + 3) & ~(size_t)3;
+    if(kIsIndexed == true)
+    {
+        return 3 * frameSize +
+               ((2 * (size_t)kLedCount + 3) & ~(size_t)3) +
+               PATTERN_PALETTE_MAX * sizeof(CRGB);
+    }
+
+    return 4 * frameSize;
+}
+
+bool LEDStripC::IsReady(void) const
+{
+    return pCtrl_ != nullptr;
+}
+
+void LEDStripC::GetStripInfo(std::shared_ptr<SStripInfo> info) const
+{
+    info->ctrlGPIO  = gpio_;
+    info->numLed    = numLeds_;
+    info->name      = name_;
+    info->isEnabled = requestedEnable_.load(std::memory_order_relaxed);
+}
+
+uint8_t LEDStripC::GetId(void) const
+{
+    return (uint8_t)gpio_;
+}
+
+const std::string& LEDStripC::GetName(void) const
+{
+    return name_;
+}
+
+uint16_t LEDStripC::GetLedCount(void) const
+{
+    return numLeds_;
+}
+
+bool LEDStripC::IsIndexed(void) const
+{
+    return isIndexed_;
+}
+
+void LEDStripC::Apply(const SPatternProgram* kpProgram,
+                      const SLinkParams&     krParams,
+                      const uint32_t         kRevision,
+                      const uint64_t         kFrameTime)
+{
+    size_t   i;
+    uint32_t step;
+    uint64_t timeStep;
+
+    if(isEnabled_ == false)
+    {
+        return;
+    }
+
+    /* A new revision restarts the program from its colors, the
+     * program was compiled for this strip when it was linked.
+     */
+    if(kRevision != revision_)
+    {
+        revision_ = kRevision;
+
+        ApplyColor(kpProgram);
+
+        /* The link scales the pattern brightness and offsets the animations
+         * start.
+         */
+        maxBrightness_ = (uint8_t)(((uint32_t)maxBrightness_ *
+                                    ((uint32_t)krParams.brightness + 1)) >> 8);
+        linkFlags_     = krParams.flags;
+        linkSpeed_     = krParams.speed;
+
+        animStates_.assign(kpProgram->animOps.size(), {0, 0});
+        for(i = 0; i < animStates_.size(); ++i)
+        {
+            step = (uint32_t)(((uint64_t)kpProgram->animOps[i].period *
+                               krParams.phase) >> 16);
+            animStates_[i].phase = (uint64_t)step << 32;
+            animStates_[i].step  = step;
+        }
+        lastTime_ = kFrameTime;
+    }
+
+    /* The time spent disabled is not caught up */
+    if(isTimeStale_ == true)
+    {
+        isTimeStale_ = false;
+        lastTime_    = kFrameTime;
+    }
+
+    /* Advance the animations by the elapsed time, dropped frames
+     * are caught up so the animations stay in sync.
+     */
+    timeStep  = kFrameTime - lastTime_;
+    lastTime_ = kFrameTime;
+    if(linkSpeed_ != LINK_SPEED_DEFAULT)
+    {
+        timeStep = (timeStep * linkSpeed_) >> 8;
+    }
+    /* Clamped once scaled so the phase step cannot overflow */
+    if(timeStep > ANIM_MAX_TIME_STEP_US)
+    {
+        timeStep = ANIM_MAX_TIME_STEP_US;
+    }
+    for(i = 0; i < animStates_.size(); ++i)
+    {
+        AdvanceAnimation(kpProgram->animOps[i],
+                         animStates_[i],
+                         timeStep);
+    }
+
+    /* A transition changes the output frame until it ends */
+    if(transitionType_ != LED_TRANSITION_CUT)
+    {
+        frameDirty_ = true;
+    }
+
+    /* Write the output frame if the state changed */
+    if(frameDirty_ == true)
+    {
+        RenderFrame(kpProgram);
+        if(linkFlags_ != 0)
+        {
+            ApplyLinkFlags();
+        }
+        if(transitionType_ != LED_TRANSITION_CUT)
+        {
+            ApplyTransition(kFrameTime);
+        }
+        frameDirty_ = false;
+    }
+}
+
+bool LEDStripC::Present(void)
+{
+    CRGB* pSwap;
+
+    /* Only called while the transmitter is idle. When no new frame
+     * was rendered, the front buffer is kept.
+     */
+    if(newFrame_ == true)
+    {
+        pSwap       = pFrontLeds_;
+        pFrontLeds_ = pBackLeds_;
+        pBackLeds_  = pSwap;
+        pCtrl_->setLeds(pFrontLeds_, (int)numLeds_);
+
+        newFrame_     = false;
+        isFrontShown_ = true;
+        return true;
+    }
+
+    return false;
+}
+
+void LEDStripC::StartTransition(const uint8_t  kType,
+                                const uint32_t kDurationUs,
+                                const uint64_t kStartTime)
+{
+    if(kType == LED_TRANSITION_CUT ||
+       kType > LED_TRANSITION_MAX ||
+       kDurationUs == 0 ||
+       pCtrl_ == nullptr)
+    {
+        transitionType_ = LED_TRANSITION_CUT;
+        return;
+    }
+
+    /* Start from the shown frame, a strip that was off starts from black */
+    if(isFrontShown_ == true)
+    {
+        memcpy((void*)pTransitionLeds_,
+               (void*)pFrontLeds_,
+               numLeds_ * sizeof(CRGB));
+    }
+    else
+    {
+        ColorKernels::Fill((uint8_t*)pTransitionLeds_, numLeds_, 0);
+    }
+
+    transitionType_  = kType;
+    transitionUs_    = kDurationUs;
+    transitionStart_ = kStartTime;
+}
+
+bool LEDStripC::RequestEnabled(const bool kEnable)
+{
+    return requestedEnable_.exchange(kEnable, std::memory_order_relaxed) !=
+           kEnable;
+}
+
+bool LEDStripC::UpdateEnabled(void)
+{
+    bool wasEnabled;
+
+    wasEnabled = isEnabled_;
+    SetEnabled(requestedEnable_.load(std::memory_order_relaxed));
+
+    return wasEnabled == false && isEnabled_ == true;
+}
+
+void LEDStripC::SetEnabled(const bool kEnable)
+{
+    if(kEnable == false && isEnabled_ == true)
+    {
+        /* Switch off the mosfet */
+        pinMode(mosfetGpio_, OUTPUT);
+        digitalWrite(mosfetGpio_, LOW);
+
+        /* Stop controller pin on the mosfet */
+        pinMode(gpio_, OUTPUT);
+        digitalWrite(gpio_, LOW);
+
+        isFrontShown_ = false;
+
+        LOG_DEBUG("Disabling Strip %d\n", gpio_);
+    }
+    else if(kEnable == true && isEnabled_ == false)
+    {
+        /* Switch on the mosfet */
+        pinMode(mosfetGpio_, OUTPUT);
+        digitalWrite(mosfetGpio_, HIGH);
+
+        isTimeStale_ = true;
+
+        LOG_DEBUG("Enabling Strip %d\n", gpio_);
+    }
+    isEnabled_ = kEnable;
+}
+
+void LEDStripC::ApplyColor(const SPatternProgram* kpProgram)
+{
+    uint8_t* pBase;
+
+    /* Indexed programs default to the first palette entry, the manager
+     * only links patterns of the strip color mode.
+     */
+    if(isIndexed_ == true)
+    {
+        pBase = pIndices_;
+        memset(pBase, 0, numLeds_);
+    }
+    else
+    {
+        pBase = (uint8_t*)pBaseLeds_;
+        ColorKernels::Fill(pBase, numLeds_, 0);
+    }
+
+    for(const SColorOp& krOp : kpProgram->colorOps)
+    {
+        krOp.pKernel(pBase, krOp);
+    }
+
+    /* Brightness is applied when the frame is rendered */
+    maxBrightness_ = kpProgram->brightness;
+    frameDirty_    = true;
+}
+
+void LEDStripC::AdvanceAnimation(const SAnimOp&   krOp,
+                                 SAnimationState& rState,
+                                 const uint64_t   kTimeStep)
+{
+    uint32_t step;
+
+    rState.phase += kTimeStep * krOp.rate;
+    step = (uint32_t)(rState.phase >> 32);
+    if(step >= krOp.period)
+    {
+        step %= krOp.period;
+        rState.phase = ((uint64_t)step << 32) |
+                       (rState.phase & 0xFFFFFFFFULL);
+    }
+
+    /* Only a new integer step changes the output */
+    if(step != rState.step)
+    {
+        rState.step = step;
+        frameDirty_ = true;
+    }
+}
+
+void LEDStripC::RenderFrame(const SPatternProgram* kpProgram)
+{
+    size_t i;
+
+    /* Render in the back buffer while the front buffer is sent */
+    newFrame_ = true;
+
+    if(isIndexed_ == true)
+    {
+        RenderIndexedFrame(kpProgram);
+        return;
+    }
+
+    /* Start from the base LEDs no trail moves, the trails write the others
+     * so each LED is written once. Then run the program: unscaled
+     * operations, pattern brightness, then the operations on the scaled
+     * frame.
+     */
+    PatternCompiler::CopyBase(*kpProgram,
+                              (uint8_t*)pBackLeds_,
+                              (const uint8_t*)pBaseLeds_,
+                              sizeof(CRGB));
+    for(i = 0; i < kpProgram->scaleIdx; ++i)
+    {
+        kpProgram->animOps[i].pKernel((uint8_t*)pBackLeds_,
+                                      (const uint8_t*)pBaseLeds_,
+                                      kpProgram->animOps[i],
+                                      animStates_[i].step);
+    }
+
+    ColorKernels::Scale((uint8_t*)pBackLeds_,
+                        (uint8_t*)pBackLeds_,
+                        numLeds_,
+                        maxBrightness_);
+
+    for(; i < kpProgram->animOps.size(); ++i)
+    {
+        kpProgram->animOps[i].pKernel((uint8_t*)pBackLeds_,
+                                      (const uint8_t*)pBaseLeds_,
+                                      kpProgram->animOps[i],
+                                      animStates_[i].step);
+    }
+}
+
+void LEDStripC::RenderIndexedFrame(const SPatternProgram* kpProgram)
+{
+    size_t         i;
+    size_t         paletteCount;
+    uint8_t*       pIndices;
+    const uint8_t* kpBasePalette;
+
+    /* The base indices and the animated indices share the indices
+     * buffer, they use one byte per LED.
+     */
+    pIndices      = pIndices_;
+    kpBasePalette = kpProgram->palette.data();
+    paletteCount  = kpProgram->palette.size() /
+                    COLOR_KERNELS_PIXEL_SIZE;
+
+    /* Index operations, only when the indices move */
+    if(kpProgram->paletteIdx != 0)
+    {
+        PatternCompiler::CopyBase(*kpProgram,
+                                  pIndices + numLeds_,
+                                  pIndices,
+                                  sizeof(uint8_t));
+        for(i = 0; i < kpProgram->paletteIdx; ++i)
+        {
+            kpProgram->animOps[i].pKernel(pIndices + numLeds_,
+                                          pIndices,
+                                          kpProgram->animOps[i],
+                                          animStates_[i].step);
+        }
+        pIndices += numLeds_;
+    }
+
+    /* Palette operations, the frame cost only depends on the
+     * palette size.
+     */
+    memcpy((void*)pPalette_, kpBasePalette, kpProgram->palette.size());
+    for(i = kpProgram->paletteIdx; i < kpProgram->scaleIdx; ++i)
+    {
+        kpProgram->animOps[i].pKernel((uint8_t*)pPalette_,
+                                      kpBasePalette,
+                                      kpProgram->animOps[i],
+                                      animStates_[i].step);
+    }
+
+    ColorKernels::Scale((uint8_t*)pPalette_,
+                        (uint8_t*)pPalette_,
+                        paletteCount,
+                        maxBrightness_);
+
+    for(; i < kpProgram->animOps.size(); ++i)
+    {
+        kpProgram->animOps[i].pKernel((uint8_t*)pPalette_,
+                                      kpBasePalette,
+                                      kpProgram->animOps[i],
+                                      animStates_[i].step);
+    }
+
+    /* Expand to RGB in the output buffer */
+    ColorKernels::Expand((uint8_t*)pBackLeds_,
+                         pIndices,
+                         (const uint8_t*)pPalette_,
+                         numLeds_);
+}
+
+void LEDStripC::ApplyLinkFlags(void)
+{
+    uint16_t i;
+    CRGB     swap;
+
+    /* The second half shows the first half mirrored */
+    if((linkFlags_ & LINK_FLAG_MIRROR) != 0)
+    {
+        for(i = 0; i < numLeds_ / 2; ++i)
+        {
+            pBackLeds_[numLeds_ - 1 - i] = pBackLeds_[i];
+        }
+    }
+
+    if((linkFlags_ & LINK_FLAG_REVERSE) != 0)
+    {
+        for(i = 0; i < numLeds_ / 2; ++i)
+        {
+            swap                         = pBackLeds_[i];
+            pBackLeds_[i]                = pBackLeds_[numLeds_ - 1 - i];
+            pBackLeds_[numLeds_ - 1 - i] = swap;
+        }
+    }
+}
+
+void LEDStripC::ApplyTransition(const uint64_t kFrameTime)
+{
+    uint32_t i;
+    uint32_t weight;
+    uint32_t edge;
+
+    /* The frame at the end of the transition is the incoming one */
+    if(kFrameTime - transitionStart_ >= transitionUs_)
+    {
+        transitionType_ = LED_TRANSITION_CUT;
+        return;
+    }
+
+    /* Q8 progress of the transition, below 256 */
+    weight = (uint32_t)(((kFrameTime - transitionStart_) << 8) /
+                        transitionUs_);
+
+    /* Mix the outgoing frame in the rendered back buffer */
+    switch(transitionType_)
+    {
+        case LED_TRANSITION_FADE:
+            ColorKernels::Blend((uint8_t*)pBackLeds_,
+                                (const uint8_t*)pTransitionLeds_,
+                                (const uint8_t*)pBackLeds_,
+                                numLeds_,
+                                (uint16_t)weight);
+            break;
+
+        case LED_TRANSITION_WIPE:
+            /* The incoming frame covers the strip from its first LED */
+            edge = (numLeds_ * weight) >> 8;
+            memcpy((void*)(pBackLeds_ + edge),
+                   (void*)(pTransitionLeds_ + edge),
+                   (numLeds_ - edge) * sizeof(CRGB));
+            break;
+
+        case LED_TRANSITION_DISSOLVE:
+            /* Each LED switches at a fixed pseudo random progress */
+            for(i = 0; i < numLeds_; ++i)
+            {
+                if(((i * 2654435761U) >> 24) >= weight)
+                {
+                    pBackLeds_[i] = pTransitionLeds_[i];
+                }
+            }
+            break;
+
+        default:
+            transitionType_ = LED_TRANSITION_CUT;
+            break;
+    }
+}
@@ -0,0 +1,146 @@
+/*******************************************************************************
+ * @file LEDTransmitter.cpp
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief LED strips output stage.
+ *
+ * @details This file provides the FastLED backend of the LED strips
+ * transmitter.
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include <cstdint>   /* Standard Int Types */
+#include <Arduino.h> /* Task and semaphore services */
+#include <FastLED.h> /* FastLED driver */
+#include <HWLayer.h> /* HW Layer service */
+#include <Logger.h>  /* Logger services */
+#include <TaskMonitor.h> /* Tasks configuration */
+
+/* Header File */
+#include <LEDTransmitter.h>
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * STRUCTURES AND TYPES
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/************************* Imported global variables **************************/
+/* None */
+
+/************************* Exported global variables **************************/
+/* None */
+
+/************************** Static global variables ***************************/
+/* None */
+
+/*******************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * CLASS METHODS
+ ******************************************************************************/
+
+FastLEDTransmitter::FastLEDTransmitter(void)
+{
+    brightness_    = 0;
+    framePeriodUs_ = 0;
+
+    /* The transmitter starts idle */
+    doneLock_ = xSemaphoreCreateBinary();
+    xSemaphoreGive(doneLock_);
+
+    /* The transmit task mostly waits for the RMT interrupts, it has a higher
+     * priority than the renderer so the channels are refilled on time.
+     */
+    transmitThread_ = TaskMonitor::GetInstance()->CreateTask(TASK_LED_TRANSMIT,
+                                                             TransmitRoutine,
+                                                             this);
+}
+
+FastLEDTransmitter::~FastLEDTransmitter(void)
+{
+}
+
+void FastLEDTransmitter::Transmit(const uint8_t  kBrightness,
+                                  const uint32_t kFramePeriodUs)
+{
+    /* Mark busy, given back by the transmit task */
+    xSemaphoreTake(doneLock_, portMAX_DELAY);
+
+    brightness_    = kBrightness;
+    framePeriodUs_ = kFramePeriodUs;
+    xTaskNotifyGive(transmitThread_);
+}
+
+void FastLEDTransmitter::WaitDone(void)
+{
+    xSemaphoreTake(doneLock_, portMAX_DELAY);
+    xSemaphoreGive(doneLock_);
+}
+
+bool FastLEDTransmitter::IsBusy(void)
+{
+    return uxSemaphoreGetCount(doneLock_) == 0;
+}
+
+void FastLEDTransmitter::TransmitRoutine(void* pObjThis)
+{
+    uint64_t            startTime;
+    FastLEDTransmitter* pTransmitter;
+    TaskMonitor*        pMonitor;
+
+    pTransmitter = (FastLEDTransmitter*)pObjThis;
+    pMonitor     = TaskMonitor::GetInstance();
+
+    LOG_DEBUG("Transmit thread on core %d\n", xPortGetCoreID());
+
+    while(1)
+    {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        startTime = HWLayer::GetTime();
+        FastLED.show(pTransmitter->brightness_);
+
+        /* The frame must be sent before the next one is ready */
+        pMonitor->ReportPeriod(TASK_LED_TRANSMIT,
+                               HWLayer::GetTime() - startTime >
+                               pTransmitter->framePeriodUs_);
+
+        xSemaphoreGive(pTransmitter->doneLock_);
+    }
+}
@@ -0,0 +1,161 @@
+/*******************************************************************************
+ * @file PixelArena.cpp
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief Pixel buffers arena.
+ *
+ * @details This file provides the arena used to allocate the LED strips pixel
+ * buffers.
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include <cstdint>   /* Standard Int Types */
+#include <Arduino.h> /* Heap capabilities services */
+#include <Logger.h>  /* Logger services */
+
+/* Header File */
+#include <PixelArena.h>
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+#define ARENA_ALIGN 4
+
+/*******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+#define ALIGN_UP(SIZE) (((SIZE) + (ARENA_ALIGN - 1)) & ~(ARENA_ALIGN - 1))
+
+/*******************************************************************************
+ * STRUCTURES AND TYPES
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/************************* Imported global variables **************************/
+/* None */
+
+/************************* Exported global variables **************************/
+/* None */
+
+/************************** Static global variables ***************************/
+/* None */
+
+/*******************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * CLASS METHODS
+ ******************************************************************************/
+
+PixelArena::PixelArena(const size_t kSize, const bool kUsePsram)
+{
+    pMemory_  = nullptr;
+    usedSize_ = 0;
+    size_     = ALIGN_UP(kSize);
+    isPsram_  = false;
+
+    if(size_ == 0)
+    {
+        return;
+    }
+
+    if(kUsePsram == true)
+    {
+        pMemory_ = (uint8_t*)heap_caps_malloc(size_,
+                                              MALLOC_CAP_SPIRAM |
+                                              MALLOC_CAP_8BIT);
+        if(pMemory_ != nullptr)
+        {
+            isPsram_ = true;
+        }
+        else
+        {
+            LOG_ERROR("Could not allocate %d bytes in PSRAM\n", size_);
+        }
+    }
+
+    if(pMemory_ == nullptr)
+    {
+        pMemory_ = (uint8_t*)heap_caps_malloc(size_,
+                                              MALLOC_CAP_INTERNAL |
+                                              MALLOC_CAP_8BIT);
+    }
+
+    if(pMemory_ == nullptr)
+    {
+        LOG_ERROR("Could not allocate pixel arena of %d bytes\n", size_);
+        size_ = 0;
+    }
+    else
+    {
+        LOG_DEBUG("Allocated pixel arena of %d bytes (PSRAM: %d)\n",
+                  size_,
+                  isPsram_);
+    }
+}
+
+PixelArena::~PixelArena(void)
+{
+    if(pMemory_ != nullptr)
+    {
+        heap_caps_free(pMemory_);
+    }
+}
+
+void* PixelArena::Allocate(const size_t kSize)
+{
+    void*  pBuffer;
+    size_t alignedSize;
+
+    alignedSize = ALIGN_UP(kSize);
+    if(alignedSize > size_ - usedSize_)
+    {
+        LOG_ERROR("Pixel arena full, could not allocate %d bytes\n", kSize);
+        return nullptr;
+    }
+
+    pBuffer    = pMemory_ + usedSize_;
+    usedSize_ += alignedSize;
+
+    return pBuffer;
+}
+
+size_t PixelArena::GetSize(void) const
+{
+    return size_;
+}
+
+size_t PixelArena::GetUsedSize(void) const
+{
+    return usedSize_;
+}
+
+bool PixelArena::IsPsram(void) const
+{
+    return isPsram_;
+}
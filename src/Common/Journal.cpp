@@ -0,0 +1,591 @@
+/*******************************************************************************
+ * @file Journal.cpp
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief Storage journal.
+ *
+ * @details This file provides the append-only journal holding the stored
+ * configuration.
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include <cstdint>       /* Standard Int Types */
+#include <cstring>       /* memcpy */
+#include <unordered_map> /* std::unordered_map */
+#include <FS.h>          /* Filesystem services */
+#include <SPIFFS.h>      /* SPIFFS driver */
+#include <esp_rom_crc.h> /* CRC services */
+#include <Logger.h>      /* Logger services */
+#include <HWLayer.h>     /* Hardware layer services */
+
+/* Header File */
+#include <Journal.h>
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+#define JOURNAL_PATH         "/journal"
+#define JOURNAL_COMPACT_PATH "/journal_compact"
+
+/* Starts each record, erased flash reads as 0xFF */
+#define JOURNAL_RECORD_MARKER 0xA5
+#define JOURNAL_TYPE_ERASE    0x80
+
+/* The journal is compacted once bigger than this size and twice its live
+ * records size.
+ */
+#define JOURNAL_COMPACT_MIN_SIZE 32768
+
+/* Expected stall of a flash access before the first one is measured */
+#define JOURNAL_STALL_ESTIMATE_US 2000
+
+/* A stall estimate decays by 1/2^JOURNAL_STALL_DECAY_SHIFT of its distance
+ * to each shorter stall, a longer stall replaces it.
+ */
+#define JOURNAL_STALL_DECAY_SHIFT 3
+
+/*******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+#define RECORD_ID(TYPE, KEY) (((uint32_t)(TYPE) << 16) | (KEY))
+#define MIN(X, Y) (((X) < (Y)) ? (X) : (Y))
+
+/*******************************************************************************
+ * STRUCTURES AND TYPES
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/************************* Imported global variables **************************/
+/* None */
+
+/************************* Exported global variables **************************/
+/* None */
+
+/************************** Static global variables ***************************/
+/* None */
+
+/*******************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ ******************************************************************************/
+
+static uint32_t ComputeCrc(const uint8_t* kpHeader,
+                           const uint8_t* kpData,
+                           const size_t   kSize);
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+static uint32_t ComputeCrc(const uint8_t* kpHeader,
+                           const uint8_t* kpData,
+                           const size_t   kSize)
+{
+    uint32_t crc;
+
+    /* Covers the type, key and size of the header and the data */
+    crc = esp_rom_crc32_le(0, kpHeader + 1, 5);
+    return esp_rom_crc32_le(crc, kpData, kSize);
+}
+
+/*******************************************************************************
+ * CLASS METHODS
+ ******************************************************************************/
+
+Journal::Journal(void)
+{
+    isWriting_    = false;
+    isCompacting_ = false;
+    isDamaged_    = false;
+    size_         = 0;
+    liveSize_     = 0;
+    chunkSize_    = 0;
+
+    gateRoutine_     = nullptr;
+    gateDoneRoutine_ = nullptr;
+    pGateParam_      = nullptr;
+    stallStart_      = 0;
+    chunkStallUs_    = JOURNAL_STALL_ESTIMATE_US;
+    fileStallUs_     = JOURNAL_STALL_ESTIMATE_US;
+    longestStallUs_  = 0;
+}
+
+bool Journal::Open(void)
+{
+    /* A compaction is complete once the previous journal is removed */
+    if(SPIFFS.exists(JOURNAL_COMPACT_PATH) == true)
+    {
+        if(SPIFFS.exists(JOURNAL_PATH) == true)
+        {
+            LOG_INFO("Dropping interrupted journal compaction\n");
+            SPIFFS.remove(JOURNAL_COMPACT_PATH);
+        }
+        else
+        {
+            LOG_INFO("Completing journal compaction\n");
+            SPIFFS.rename(JOURNAL_COMPACT_PATH, JOURNAL_PATH);
+        }
+    }
+
+    return SPIFFS.exists(JOURNAL_PATH);
+}
+
+bool Journal::Replay(JournalRecordRoutine pRoutine, void* pParam)
+{
+    File     file;
+    uint8_t* pBuffer;
+    size_t   fileSize;
+    size_t   readSize;
+    size_t   offset;
+    int      readBytes;
+    uint8_t  type;
+    uint16_t key;
+    uint16_t size;
+    uint32_t crc;
+
+    records_.clear();
+    size_      = 0;
+    liveSize_  = 0;
+    isDamaged_ = false;
+
+    file = SPIFFS.open(JOURNAL_PATH);
+    if(!file || file.isDirectory())
+    {
+        LOG_ERROR("Failed to open %s\n", JOURNAL_PATH);
+        return false;
+    }
+
+    fileSize = file.size();
+    if(fileSize == 0)
+    {
+        file.close();
+        return true;
+    }
+
+    /* Load the whole journal with a single sequential read */
+    pBuffer  = new uint8_t[fileSize];
+    readSize = 0;
+    while(readSize < fileSize)
+    {
+        readBytes = file.read(pBuffer + readSize, fileSize - readSize);
+        if(readBytes <= 0)
+        {
+            break;
+        }
+        readSize += readBytes;
+    }
+    file.close();
+
+    offset = 0;
+    while(offset + JOURNAL_HEADER_SIZE <= readSize)
+    {
+        if(pBuffer[offset] != JOURNAL_RECORD_MARKER)
+        {
+            break;
+        }
+
+        type = pBuffer[offset + 1];
+        key  = pBuffer[offset + 2] | (pBuffer[offset + 3] << 8);
+        size = pBuffer[offset + 4] | (pBuffer[offset + 5] << 8);
+        crc  = pBuffer[offset + 6] |
+               (pBuffer[offset + 7] << 8) |
+               (pBuffer[offset + 8] << 16) |
+               ((uint32_t)pBuffer[offset + 9] << 24);
+
+        if(offset + JOURNAL_HEADER_SIZE + size > readSize ||
+           ComputeCrc(&pBuffer[offset],
+                      &pBuffer[offset + JOURNAL_HEADER_SIZE],
+                      size) != crc)
+        {
+            break;
+        }
+
+        if((type & JOURNAL_TYPE_ERASE) != 0)
+        {
+            pRoutine(pParam, type & JOURNAL_TYPE_MAX, key, nullptr, 0);
+        }
+        else
+        {
+            pRoutine(pParam,
+                     type,
+                     key,
+                     &pBuffer[offset + JOURNAL_HEADER_SIZE],
+                     size);
+        }
+
+        TrackRecord(type & JOURNAL_TYPE_MAX,
+                    key,
+                    JOURNAL_HEADER_SIZE + size,
+                    (type & JOURNAL_TYPE_ERASE) != 0);
+
+        offset += JOURNAL_HEADER_SIZE + size;
+    }
+
+    delete[] pBuffer;
+
+    /* The records after a torn record are unreachable */
+    size_ = offset;
+    if(offset != fileSize)
+    {
+        LOG_ERROR("Journal damaged at %d, dropped %d bytes\n",
+                  offset,
+                  fileSize - offset);
+        isDamaged_ = true;
+    }
+
+    LOG_DEBUG("Replayed journal, %d bytes, %d live\n", size_, liveSize_);
+
+    return true;
+}
+
+bool Journal::Begin(const bool kCompact)
+{
+    if(isWriting_ == true)
+    {
+        LOG_ERROR("Journal already being written\n");
+        return false;
+    }
+
+    isCompacting_   = kCompact;
+    chunkSize_      = 0;
+    longestStallUs_ = 0;
+
+    /* Opening a file updates the filesystem metadata */
+    StartStall(false);
+    if(kCompact == true)
+    {
+        file_ = SPIFFS.open(JOURNAL_COMPACT_PATH, FILE_WRITE);
+
+        /* The records are tracked for the new journal */
+        records_.clear();
+        size_     = 0;
+        liveSize_ = 0;
+    }
+    else
+    {
+        file_ = SPIFFS.open(JOURNAL_PATH, FILE_APPEND);
+    }
+    EndStall(false);
+
+    if(!file_)
+    {
+        LOG_ERROR("Failed to open the journal for writting\n");
+        isDamaged_ = true;
+        return false;
+    }
+
+    /* The new journal starts clean */
+    if(kCompact == true)
+    {
+        isDamaged_ = false;
+    }
+
+    isWriting_ = true;
+
+    return true;
+}
+
+size_t Journal::Append(const uint8_t  kType,
+                       const uint16_t kKey,
+                       const uint8_t* kpData,
+                       const size_t   kSize)
+{
+    size_t written;
+
+    written = Write(kType, kKey, kpData, kSize);
+    if(written != 0)
+    {
+        TrackRecord(kType, kKey, written, false);
+    }
+
+    return written;
+}
+
+size_t Journal::Erase(const uint8_t kType, const uint16_t kKey)
+{
+    size_t written;
+
+    written = Write(kType | JOURNAL_TYPE_ERASE, kKey, nullptr, 0);
+    if(written != 0)
+    {
+        TrackRecord(kType, kKey, written, true);
+    }
+
+    return written;
+}
+
+bool Journal::End(void)
+{
+    bool isReplaced;
+
+    if(isWriting_ == false)
+    {
+        return false;
+    }
+
+    /* Last partial chunk */
+    if(chunkSize_ != 0)
+    {
+        WriteChunk();
+    }
+
+    StartStall(false);
+    file_.close();
+    EndStall(false);
+    isWriting_ = false;
+
+    if(isCompacting_ == true)
+    {
+        /* Keep the current journal, the next commit compacts again */
+        if(isDamaged_ == true)
+        {
+            LOG_ERROR("Journal compaction failed\n");
+            SPIFFS.remove(JOURNAL_COMPACT_PATH);
+            return false;
+        }
+
+        StartStall(false);
+        SPIFFS.remove(JOURNAL_PATH);
+        isReplaced = SPIFFS.rename(JOURNAL_COMPACT_PATH, JOURNAL_PATH);
+        EndStall(false);
+        if(isReplaced == false)
+        {
+            LOG_ERROR("Could not replace the journal\n");
+            isDamaged_ = true;
+            return false;
+        }
+
+        LOG_INFO("Compacted journal to %d bytes\n", size_);
+    }
+
+    return isDamaged_ == false;
+}
+
+void Journal::Reset(void)
+{
+    if(isWriting_ == true)
+    {
+        file_.close();
+        isWriting_ = false;
+    }
+    chunkSize_ = 0;
+
+    SPIFFS.remove(JOURNAL_COMPACT_PATH);
+    SPIFFS.remove(JOURNAL_PATH);
+
+    records_.clear();
+    size_      = 0;
+    liveSize_  = 0;
+    isDamaged_ = false;
+}
+
+bool Journal::NeedsCompaction(void) const
+{
+    return isDamaged_ == true ||
+           (size_ > JOURNAL_COMPACT_MIN_SIZE && size_ > 2 * liveSize_);
+}
+
+void Journal::SetWriteGate(JournalGateRoutine     pRoutine,
+                           JournalGateDoneRoutine pDoneRoutine,
+                           void*                  pParam)
+{
+    gateRoutine_     = pRoutine;
+    gateDoneRoutine_ = pDoneRoutine;
+    pGateParam_      = pParam;
+}
+
+uint32_t Journal::GetLongestStall(void) const
+{
+    return longestStallUs_;
+}
+
+size_t Journal::GetSize(void) const
+{
+    return size_;
+}
+
+size_t Journal::GetLiveSize(void) const
+{
+    return liveSize_;
+}
+
+void Journal::TrackRecord(const uint8_t  kType,
+                          const uint16_t kKey,
+                          const size_t   kRecordSize,
+                          const bool     kIsErase)
+{
+    std::unordered_map<uint32_t, uint32_t>::iterator it;
+
+    /* The new record outdates the previous one */
+    it = records_.find(RECORD_ID(kType, kKey));
+    if(it != records_.end())
+    {
+        liveSize_ -= it->second;
+        if(kIsErase == true)
+        {
+            records_.erase(it);
+        }
+        else
+        {
+            it->second = kRecordSize;
+            liveSize_ += kRecordSize;
+        }
+    }
+    else if(kIsErase == false)
+    {
+        records_[RECORD_ID(kType, kKey)] = kRecordSize;
+        liveSize_ += kRecordSize;
+    }
+}
+
+size_t Journal::Write(const uint8_t  kType,
+                      const uint16_t kKey,
+                      const uint8_t* kpData,
+                      const size_t   kSize)
+{
+    uint8_t  pHeader[JOURNAL_HEADER_SIZE];
+    uint32_t crc;
+
+    if(isWriting_ == false)
+    {
+        LOG_ERROR("Journal is not being written\n");
+        return 0;
+    }
+    /* Records written after a torn record would never be replayed */
+    if(isDamaged_ == true)
+    {
+        return 0;
+    }
+    if(kSize > 0xFFFF)
+    {
+        LOG_ERROR("Journal record too big: %d\n", kSize);
+        return 0;
+    }
+
+    pHeader[0] = JOURNAL_RECORD_MARKER;
+    pHeader[1] = kType;
+    pHeader[2] = kKey & 0xFF;
+    pHeader[3] = kKey >> 8;
+    pHeader[4] = kSize & 0xFF;
+    pHeader[5] = kSize >> 8;
+
+    crc = ComputeCrc(pHeader, kpData, kSize);
+    pHeader[6] = crc & 0xFF;
+    pHeader[7] = (crc >> 8) & 0xFF;
+    pHeader[8] = (crc >> 16) & 0xFF;
+    pHeader[9] = crc >> 24;
+
+    Stage(pHeader, JOURNAL_HEADER_SIZE);
+    Stage(kpData, kSize);
+
+    /* A partial record ends the valid part of the journal */
+    if(isDamaged_ == true)
+    {
+        LOG_ERROR("Could not write journal record %d:%d\n", kType, kKey);
+        return 0;
+    }
+
+    size_ += JOURNAL_HEADER_SIZE + kSize;
+
+    return JOURNAL_HEADER_SIZE + kSize;
+}
+
+void Journal::Stage(const uint8_t* kpData, const size_t kSize)
+{
+    size_t offset;
+    size_t copySize;
+
+    offset = 0;
+    while(offset < kSize)
+    {
+        copySize = MIN(kSize - offset, JOURNAL_CHUNK_SIZE - chunkSize_);
+        memcpy(chunk_ + chunkSize_, kpData + offset, copySize);
+        chunkSize_ += copySize;
+        offset     += copySize;
+
+        if(chunkSize_ == JOURNAL_CHUNK_SIZE)
+        {
+            WriteChunk();
+        }
+    }
+}
+
+void Journal::WriteChunk(void)
+{
+    size_t written;
+
+    /* Chunks after a failed chunk would never be replayed */
+    if(isDamaged_ == false)
+    {
+        /* The file is flushed so the flash is written within the stall and
+         * not on a later write.
+         */
+        StartStall(true);
+        written = file_.write(chunk_, chunkSize_);
+        file_.flush();
+        EndStall(true);
+
+        if(written != chunkSize_)
+        {
+            LOG_ERROR("Could not write journal chunk\n");
+            isDamaged_ = true;
+        }
+    }
+
+    chunkSize_ = 0;
+}
+
+void Journal::StartStall(const bool kIsChunk)
+{
+    if(gateRoutine_ != nullptr)
+    {
+        gateRoutine_(pGateParam_,
+                     (kIsChunk == true) ? chunkStallUs_ : fileStallUs_);
+    }
+    stallStart_ = HWLayer::GetTime();
+}
+
+void Journal::EndStall(const bool kIsChunk)
+{
+    uint32_t  stall;
+    uint32_t* pEstimate;
+
+    stall = HWLayer::GetTime() - stallStart_;
+    if(gateRoutine_ != nullptr && gateDoneRoutine_ != nullptr)
+    {
+        gateDoneRoutine_(pGateParam_);
+    }
+
+    if(stall > longestStallUs_)
+    {
+        longestStallUs_ = stall;
+    }
+
+    /* Each access kind has its own estimate, the short file accesses do not
+     * lower the chunk writes estimate.
+     */
+    pEstimate = (kIsChunk == true) ? &chunkStallUs_ : &fileStallUs_;
+    if(stall >= *pEstimate)
+    {
+        *pEstimate = stall;
+    }
+    else
+    {
+        *pEstimate -= (*pEstimate - stall) >> JOURNAL_STALL_DECAY_SHIFT;
+    }
+}
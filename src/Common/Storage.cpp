@@ -19,6 +19,7 @@
  ******************************************************************************/
 
 #include <cstdint> /* Standard Int Types */
+#include <cstddef> /* offsetof */
 #include <vector>  /* std::vector */
 #include <memory>  /* std::shared_ptr */
 #include <utility> /* std::pair */
@@ -27,8 +28,11 @@
 #include <SPIFFS.h> /* SPIFFS driver */
 #include <sys/stat.h> /* stat services */
 #include <Pattern.h> /* Patern object */
+#include <PatternImage.h> /* Pattern stored image */
 #include <HWLayer.h> /* Hardware layer services */
 #include <Logger.h> /* Logger service */
+#include <Journal.h> /* Storage journal */
+#include <TaskMonitor.h> /* Tasks configuration */
 
 /* Header file */
 #include <Storage.h>
@@ -37,23 +41,68 @@
  * CONSTANTS
  ******************************************************************************/
 
-#define COMMIT_TIME_SYNC  120000000UL // 120s in us
+/* Changes are flushed once they stopped for the quiet period, or after the
+ * maximal delay while they keep coming.
+ */
+#define STORAGE_FLUSH_QUIET_US     2000000
+#define STORAGE_FLUSH_MAX_DELAY_US 10000000
+
 #define BUFFER_SIZE       512
 #define BIG_BUFFER_SIZE   16384
+/* Fits the largest palette */
+#define PATTERN_BUFFER_SIZE 2048
 
 #define INIT_FILE_PATH      "/init"
+
+/* Files of the storage format preceding the journal */
 #define BLE_PIN_PATH        "/pin"
 #define BLE_TOKEN_PATH      "/token"
 #define BRIGHTNESS_PATH     "/brightness"
 #define PATTERN_PATH        "/pattern_"
 #define SCENES_PATH         "/scenes"
 #define SELECTED_SCENE_PATH "/selected_scene"
+#define ANIM_SPEED_PATH     "/anim_speed"
+#define STRIPS_PATH         "/strips"
+
+/* Journal records types, the patterns records key is the pattern identifier */
+#define RECORD_PIN            0x01
+#define RECORD_TOKEN          0x02
+#define RECORD_BRIGHTNESS     0x03
+#define RECORD_SELECTED_SCENE 0x04
+#define RECORD_PATTERN        0x08
+#define RECORD_SCENES         0x0A
+#define RECORD_STRIPS         0x0B
+
+/* Records stored before the versioned layouts, converted on boot. The legacy
+ * patterns are raw structures, the legacy scenes and strips have host endian
+ * fields and their optional parts are found from the record size.
+ */
+#define RECORD_STRIPS_RGB_LEGACY 0x05
+#define RECORD_SCENES_LEGACY     0x06
+#define RECORD_PATTERN_LEGACY    0x07
+#define RECORD_STRIPS_LEGACY     0x09
+
+/* Records with another version are not read */
+#define SCENES_RECORD_VERSION 1
+#define STRIPS_RECORD_VERSION 1
+
+/* Sizes of the records parts, the layouts are described in Storage.txt */
+#define SCENES_HEADER_SIZE 2
+#define SCENE_HEADER_SIZE  6
+#define SCENE_LINK_SIZE    9
+#define STRIPS_HEADER_SIZE 2
+#define STRIP_HEADER_SIZE  6
+
+/* Strips layout color modes */
+#define STRIP_MODE_RGB     0
+#define STRIP_MODE_INDEXED 1
 
 /*******************************************************************************
  * MACROS
  ******************************************************************************/
 
-/* None */
+#define MIN(X, Y) (((X) < (Y)) ? (X) : (Y))
+#define MAX(X, Y) (((X) > (Y)) ? (X) : (Y))
 
 /*******************************************************************************
  * STRUCTURES AND TYPES
@@ -74,16 +123,78 @@
 /************************** Static global variables ***************************/
 Storage* Storage::PINSTANCE_ = nullptr;
 
+static const char* sLegacyPaths[] = {
+    BLE_PIN_PATH,
+    BLE_TOKEN_PATH,
+    BRIGHTNESS_PATH,
+    SCENES_PATH,
+    SELECTED_SCENE_PATH,
+    ANIM_SPEED_PATH,
+    STRIPS_PATH
+};
+
 /*******************************************************************************
  * STATIC FUNCTIONS DECLARATIONS
  ******************************************************************************/
 
-/* None */
+static void GetDefaultStrips(std::vector<SStripConfig>& rStrips);
+static uint16_t ReadLE16(const uint8_t* kpData);
+static void WriteLE16(uint8_t* pData, const uint16_t kValue);
+static void AddRecord(std::vector<SStorageRecord>& rRecords,
+                      const uint8_t                kType,
+                      const uint16_t               kKey,
+                      const uint8_t*               kpData,
+                      const size_t                 kSize);
 
 /*******************************************************************************
  * FUNCTIONS
  ******************************************************************************/
 
+static void GetDefaultStrips(std::vector<SStripConfig>& rStrips)
+{
+    rStrips.clear();
+    rStrips.push_back({
+        .ctrlGPIO   = GPIO_NUM_4,
+        .mosfetGPIO = GPIO_NUM_6,
+        .numLed     = 120,
+        .isIndexed  = false,
+        .name       = "Cross/"
+    });
+    rStrips.push_back({
+        .ctrlGPIO   = GPIO_NUM_5,
+        .mosfetGPIO = GPIO_NUM_7,
+        .numLed     = 70,
+        .isIndexed  = false,
+        .name       = "Cross\\"
+    });
+}
+
+/* The fields are read byte per byte, the records may not be aligned */
+static uint16_t ReadLE16(const uint8_t* kpData)
+{
+    return kpData[0] | (kpData[1] << 8);
+}
+
+static void WriteLE16(uint8_t* pData, const uint16_t kValue)
+{
+    pData[0] = kValue & 0xFF;
+    pData[1] = kValue >> 8;
+}
+
+static void AddRecord(std::vector<SStorageRecord>& rRecords,
+                      const uint8_t                kType,
+                      const uint16_t               kKey,
+                      const uint8_t*               kpData,
+                      const size_t                 kSize)
+{
+    rRecords.push_back({
+        .type    = kType,
+        .key     = kKey,
+        .isErase = false,
+        .data    = std::vector<uint8_t>(kpData, kpData + kSize)
+    });
+}
+
 Storage* Storage::GetInstance(void)
 {
     if (Storage::PINSTANCE_ == nullptr)
@@ -94,50 +205,69 @@ Storage* Storage::GetInstance(void)
     return Storage::PINSTANCE_;
 }
 
-void Storage::Update(const bool kForce)
+void Storage::Flush(void)
 {
-    uint64_t currTime;
-
     if(isInit_ == false)
     {
         return;
     }
 
-    /* Check if we need to write the flash  */
-    currTime = HWLayer::GetTime();
-    if((needUpdate_ && (currTime - lastUpdateTime_ > COMMIT_TIME_SYNC)) ||
-        kForce)
+    LOG_INFO("Flushing storage\n");
+    Commit(true);
+}
+
+void Storage::GetPatterns(std::vector<std::shared_ptr<Pattern>>& rPatterns) const
+{
+    if(isInit_ == false)
     {
-        /* Commit data to the flash */
-        Commit(kForce);
+        return;
+    }
 
-        /* Update state and last update time */
-        lastUpdateTime_ = currTime;
-        needUpdate_     = false;
+    rPatterns.clear();
+
+    xSemaphoreTake(lock_, portMAX_DELAY);
+    for(const std::pair<const uint16_t, SPatternCacheEntry>& krEntry : patterns_)
+    {
+        /* Skip the removed patterns */
+        if(krEntry.second.pattern != nullptr)
+        {
+            rPatterns.push_back(krEntry.second.pattern);
+        }
     }
+    xSemaphoreGive(lock_);
 }
 
-void Storage::GetPatterns(std::vector<std::shared_ptr<Pattern>>& rPatterns) const
+void Storage::SavePattern(const std::shared_ptr<Pattern>& krPattern)
 {
     if(isInit_ == false)
     {
         return;
     }
 
-    rPatterns = patterns_.first;
+    xSemaphoreTake(lock_, portMAX_DELAY);
+    patterns_[krPattern->GetId()] = {
+        .pattern = krPattern,
+        .isDirty = true
+    };
+    NotifyChange();
+    xSemaphoreGive(lock_);
 }
 
-void Storage::SavePatterns(const std::vector<std::shared_ptr<Pattern>>& krPatterns)
+void Storage::RemovePattern(const uint16_t kPatternId)
 {
     if(isInit_ == false)
     {
         return;
     }
 
-    patterns_.first  = krPatterns;
-    patterns_.second = true;
-
-    needUpdate_ = true;
+    /* Keep a tombstone until the pattern is erased */
+    xSemaphoreTake(lock_, portMAX_DELAY);
+    patterns_[kPatternId] = {
+        .pattern = nullptr,
+        .isDirty = true
+    };
+    NotifyChange();
+    xSemaphoreGive(lock_);
 }
 
 void Storage::GetScenes(std::vector<std::shared_ptr<SScene>>& rScenes) const
@@ -147,7 +277,9 @@ void Storage::GetScenes(std::vector<std::shared_ptr<SScene>>& rScenes) const
         return;
     }
 
+    xSemaphoreTake(lock_, portMAX_DELAY);
     rScenes = scenes_.first;
+    xSemaphoreGive(lock_);
 }
 
 void Storage::SaveScenes(const std::vector<std::shared_ptr<SScene>>& krScenes)
@@ -157,10 +289,47 @@ void Storage::SaveScenes(const std::vector<std::shared_ptr<SScene>>& krScenes)
         return;
     }
 
+    xSemaphoreTake(lock_, portMAX_DELAY);
     scenes_.first  = krScenes;
     scenes_.second = true;
+    NotifyChange();
+    xSemaphoreGive(lock_);
+}
+
+void Storage::GetStrips(std::vector<SStripConfig>& rStrips) const
+{
+    if(isInit_ == false)
+    {
+        return;
+    }
+
+    xSemaphoreTake(lock_, portMAX_DELAY);
+    rStrips = strips_.first;
+    xSemaphoreGive(lock_);
+}
+
+void Storage::SaveStrips(const std::vector<SStripConfig>& krStrips)
+{
+    if(isInit_ == false)
+    {
+        return;
+    }
 
-    needUpdate_ = true;
+    xSemaphoreTake(lock_, portMAX_DELAY);
+    strips_.first  = krStrips;
+    strips_.second = true;
+    NotifyChange();
+    xSemaphoreGive(lock_);
+}
+
+uint8_t Storage::GetSelectedScene(void) const
+{
+    if(isInit_ == false)
+    {
+        return 255;
+    }
+
+    return selectedScene_.first;
 }
 
 void Storage::SaveSelectedScene(const uint8_t kSelectedScene)
@@ -170,10 +339,11 @@ void Storage::SaveSelectedScene(const uint8_t kSelectedScene)
         return;
     }
 
+    xSemaphoreTake(lock_, portMAX_DELAY);
     selectedScene_.first  = kSelectedScene;
     selectedScene_.second = true;
-
-    needUpdate_ = true;
+    NotifyChange();
+    xSemaphoreGive(lock_);
 }
 
 uint8_t Storage::GetBrightness(void) const
@@ -193,10 +363,11 @@ void Storage::SaveBrightness(const uint8_t kBrightness)
         return;
     }
 
+    xSemaphoreTake(lock_, portMAX_DELAY);
     brightness_.first  = kBrightness;
     brightness_.second = true;
-
-    needUpdate_ = true;
+    NotifyChange();
+    xSemaphoreGive(lock_);
 }
 
 void Storage::GetToken(std::string& rStrToken) const
@@ -206,7 +377,9 @@ void Storage::GetToken(std::string& rStrToken) const
         return;
     }
 
+    xSemaphoreTake(lock_, portMAX_DELAY);
     rStrToken = token_.first;
+    xSemaphoreGive(lock_);
 }
 
 void Storage::SaveToken(const std::string& krStrToken)
@@ -216,10 +389,11 @@ void Storage::SaveToken(const std::string& krStrToken)
         return;
     }
 
+    xSemaphoreTake(lock_, portMAX_DELAY);
     token_.first  = krStrToken;
     token_.second = true;
-
-    needUpdate_ = true;
+    NotifyChange();
+    xSemaphoreGive(lock_);
 }
 
 void Storage::GetPin(std::string& rStrPin) const
@@ -229,7 +403,9 @@ void Storage::GetPin(std::string& rStrPin) const
         return;
     }
 
+    xSemaphoreTake(lock_, portMAX_DELAY);
     rStrPin = pin_.first;
+    xSemaphoreGive(lock_);
 }
 
 void Storage::SavePin(const std::string& krStrPin)
@@ -239,14 +415,23 @@ void Storage::SavePin(const std::string& krStrPin)
         return;
     }
 
+    xSemaphoreTake(lock_, portMAX_DELAY);
     pin_.first  = krStrPin;
     pin_.second = true;
-
-    needUpdate_ = true;
+    NotifyChange();
+    xSemaphoreGive(lock_);
 }
 
 void Storage::GetStorageStats(SStorageStats& rStats)
 {
+    xSemaphoreTake(lock_, portMAX_DELAY);
+    rStats.lastCommitBytes   = lastCommitBytes_;
+    rStats.totalBytesWritten = totalBytesWritten_;
+    rStats.commitCount       = commitCount_;
+    rStats.lastCommitStallUs = lastCommitStallUs_;
+    rStats.longestStallUs    = longestStallUs_;
+    xSemaphoreGive(lock_);
+
     if(isInit_ == false)
     {
         rStats.totalSize = 0;
@@ -258,8 +443,31 @@ void Storage::GetStorageStats(SStorageStats& rStats)
     rStats.usedSize  = SPIFFS.usedBytes();
 }
 
+void Storage::SetWriteGate(JournalGateRoutine     pRoutine,
+                           JournalGateDoneRoutine pDoneRoutine,
+                           void*                  pParam)
+{
+    xSemaphoreTake(commitLock_, portMAX_DELAY);
+    journal_.SetWriteGate(pRoutine, pDoneRoutine, pParam);
+    xSemaphoreGive(commitLock_);
+}
+
 Storage::Storage(void)
 {
+    lastCommitBytes_   = 0;
+    totalBytesWritten_ = 0;
+    commitCount_       = 0;
+    lastCommitStallUs_ = 0;
+    longestStallUs_    = 0;
+    needUpdate_        = false;
+    hasLegacyRecords_  = false;
+    firstChangeTime_   = 0;
+    lastChangeTime_    = 0;
+    flushThread_       = nullptr;
+
+    lock_       = xSemaphoreCreateMutex();
+    commitLock_ = xSemaphoreCreateMutex();
+
     /* Init the SPIFFS */
     if(SPIFFS.begin(true) == false)
     {
@@ -268,6 +476,8 @@ Storage::Storage(void)
         return;
     }
 
+    isInit_ = true;
+
     /* Check if we has a populated storage */
     if(SPIFFS.exists(INIT_FILE_PATH) == false)
     {
@@ -278,14 +488,13 @@ Storage::Storage(void)
     {
         LOG_DEBUG("Flash already initialized.\n");
     }
-
-    isInit_ = true;
 }
 
 void Storage::LoadData(void)
 {
-    uint8_t* pBuffer;
-    size_t   readSize;
+    bool     isConverted;
+    size_t   writtenBytes;
+    uint32_t stallUs;
 
     if(isInit_ == false)
     {
@@ -293,162 +502,476 @@ void Storage::LoadData(void)
         return;
     }
 
-    needUpdate_     = false;
-    lastUpdateTime_ = 0;
-
-    pBuffer = new uint8_t[BUFFER_SIZE];
-
-    /* Load Pin */
-    readSize = BUFFER_SIZE;
-    ReadFile(BLE_PIN_PATH, pBuffer, readSize);
-    if(readSize != 0)
+    /* The storage task is not started yet, the data is loaded unlocked */
+    needUpdate_       = false;
+    hasLegacyRecords_ = false;
+
+    /* Default values of the data missing from the storage */
+    pin_.first            = "0000";
+    pin_.second           = false;
+    token_.first          = "0000";
+    token_.second         = false;
+    brightness_.first     = 0;
+    brightness_.second    = false;
+    selectedScene_.first  = 255;
+    selectedScene_.second = false;
+    scenes_.first.clear();
+    scenes_.second        = false;
+    patterns_.clear();
+
+    /* Cleared once the strips layout is loaded */
+    strips_.first.clear();
+    strips_.second = true;
+
+    if(journal_.Open() == true)
     {
-        pBuffer[readSize] = 0;
-        pin_.first = (char*)pBuffer;
+        journal_.Replay(ReplayRecord, this);
+
+        /* The journal is rewritten with the current layouts */
+        isConverted = hasLegacyRecords_;
+        if(isConverted == true)
+        {
+            LOG_INFO("Converting legacy records\n");
+        }
     }
     else
     {
-        pin_.first = "0000";
-        LOG_ERROR("Could not load pin\n");
+        /* Animations saved before the speed marker store the number of
+         * frames per step.
+         */
+        LOG_INFO("Converting storage to the journal\n");
+        LoadLegacyData(SPIFFS.exists(ANIM_SPEED_PATH) == false);
+        isConverted = true;
     }
-    pin_.second = false;
 
-    /* Load Token */
-    readSize = BUFFER_SIZE;
-    memset(pBuffer, 0, BUFFER_SIZE);
-    ReadFile(BLE_TOKEN_PATH, pBuffer, readSize);
-    if(readSize != 0)
+    /* Flash initialized before the strips registry, use the default layout */
+    if(strips_.second == true)
     {
-        pBuffer[readSize] = 0;
-        token_.first = (char*)pBuffer;
+        LOG_INFO("No strips layout, using default\n");
+        GetDefaultStrips(strips_.first);
+        NotifyChange();
     }
-    else
+
+    /* The previous files are removed once the journal holds their data */
+    writtenBytes = 0;
+    stallUs      = 0;
+    if(isConverted == true &&
+       WriteJournal(true, writtenBytes, stallUs) == true)
     {
-        token_.first = "0000";
-        LOG_ERROR("Could not load token\n");
+        RemoveLegacyData();
     }
-    token_.second = false;
 
-    /* Load Brightness */
-    readSize = BUFFER_SIZE;
-    ReadFile(BRIGHTNESS_PATH, pBuffer, readSize);
-    if(readSize == sizeof(uint8_t))
+    /* The changes are flushed by the storage task from now on */
+    if(flushThread_ == nullptr)
     {
-        brightness_.first = *pBuffer;
+        flushThread_ = TaskMonitor::GetInstance()->CreateTask(TASK_STORAGE,
+                                                              FlushRoutine,
+                                                              this);
     }
-    else
+
+    LOG_INFO("Storage Initialized.\n");
+}
+
+void Storage::Commit(const bool kForce)
+{
+    size_t   commitBytes;
+    uint32_t commitStallUs;
+    bool     isWritten;
+
+    /* Serializes the storage task and the synchronous flushes */
+    xSemaphoreTake(commitLock_, portMAX_DELAY);
+
+    xSemaphoreTake(lock_, portMAX_DELAY);
+    if(needUpdate_ == false && kForce == false)
+    {
+        xSemaphoreGive(lock_);
+        xSemaphoreGive(commitLock_);
+        return;
+    }
+    needUpdate_ = false;
+    xSemaphoreGive(lock_);
+
+    /* A damaged or oversized journal is rewritten with all the data */
+    commitBytes   = 0;
+    commitStallUs = 0;
+    isWritten     = WriteJournal(journal_.NeedsCompaction(),
+                                 commitBytes,
+                                 commitStallUs);
+    if(journal_.NeedsCompaction() == true)
     {
-        brightness_.first = 0;
-        LOG_ERROR("Could not load brightness\n");
+        isWritten = WriteJournal(true, commitBytes, commitStallUs);
     }
-    brightness_.second = false;
 
-    delete[] pBuffer;
+    xSemaphoreTake(lock_, portMAX_DELAY);
+    lastCommitBytes_    = commitBytes;
+    totalBytesWritten_ += commitBytes;
+    ++commitCount_;
+    lastCommitStallUs_ = commitStallUs;
+    longestStallUs_    = MAX(longestStallUs_, commitStallUs);
 
-    /* Load Patterns */
-    LoadPatterns();
-    patterns_.second = false;
+    /* Retry later, the journal is rewritten with all the data */
+    if(isWritten == false)
+    {
+        NotifyChange();
+    }
+    xSemaphoreGive(lock_);
 
-    /* Load links */
-    LoadScenes();
-    scenes_.second = false;
+    xSemaphoreGive(commitLock_);
 
-    LOG_INFO("Storage Initialized.\n");
+    LOG_INFO("Commited cache, wrote %d bytes, longest stall %dus\n",
+             commitBytes,
+             commitStallUs);
 }
 
-void Storage::Commit(const bool kForce)
+void Storage::NotifyChange(void)
 {
-    size_t size;
+    uint64_t timeNow;
 
-    if(needUpdate_ == true || kForce == true)
+    /* The lock is held by the caller */
+    timeNow = HWLayer::GetTime();
+    if(needUpdate_ == false)
     {
-        if(pin_.second == true)
-        {
-            size = pin_.first.size();
-            WriteFile(BLE_PIN_PATH, (uint8_t*)pin_.first.c_str(), size);
+        firstChangeTime_ = timeNow;
+        needUpdate_      = true;
+    }
+    lastChangeTime_ = timeNow;
 
-            pin_.second = false;
-        }
+    if(flushThread_ != nullptr)
+    {
+        xTaskNotifyGive(flushThread_);
+    }
+}
 
-        if(token_.second == true)
-        {
-            size = token_.first.size();
-            WriteFile(BLE_TOKEN_PATH, (uint8_t*)token_.first.c_str(), size);
+void Storage::FlushRoutine(void* pObjThis)
+{
+    Storage*     pStorage;
+    TaskMonitor* pMonitor;
+    bool         isPending;
+    uint64_t     deadline;
+    uint64_t     timeNow;
+
+    pStorage = (Storage*)pObjThis;
+    pMonitor = TaskMonitor::GetInstance();
 
-            token_.second = false;
+    while(1)
+    {
+        xSemaphoreTake(pStorage->lock_, portMAX_DELAY);
+        isPending = pStorage->needUpdate_;
+        deadline  = MIN(pStorage->lastChangeTime_ + STORAGE_FLUSH_QUIET_US,
+                        pStorage->firstChangeTime_ +
+                        STORAGE_FLUSH_MAX_DELAY_US);
+        xSemaphoreGive(pStorage->lock_);
+
+        /* Sleep until a change */
+        if(isPending == false)
+        {
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            continue;
         }
 
-        if(brightness_.second == true)
+        /* Coalesce the changes, a new change wakes us to update the
+         * deadline.
+         */
+        timeNow = HWLayer::GetTime();
+        if(timeNow < deadline)
         {
-            size = sizeof(brightness_.first);
-            WriteFile(BRIGHTNESS_PATH, &brightness_.first, size);
+            ulTaskNotifyTake(pdTRUE,
+                             pdMS_TO_TICKS((deadline - timeNow) / 1000) + 1);
+            continue;
+        }
+
+        pStorage->Commit(false);
+
+        /* A commit must not outlast the longest coalescing delay */
+        pMonitor->ReportPeriod(TASK_STORAGE,
+                               HWLayer::GetTime() - timeNow >
+                               STORAGE_FLUSH_MAX_DELAY_US);
+    }
+}
+
+bool Storage::WriteJournal(const bool kCompact,
+                           size_t&    rWrittenBytes,
+                           uint32_t&  rStallUs)
+{
+    std::vector<SStorageRecord> records;
+    bool                        isWritten;
 
-            brightness_.second = false;
+    CollectRecords(kCompact, records);
+
+    /* Nothing changed since the last commit */
+    if(kCompact == false && records.empty() == true)
+    {
+        return true;
+    }
+
+    if(journal_.Begin(kCompact) == false)
+    {
+        return false;
+    }
+
+    for(const SStorageRecord& krRecord : records)
+    {
+        if(krRecord.isErase == true)
+        {
+            rWrittenBytes += journal_.Erase(krRecord.type, krRecord.key);
+        }
+        else
+        {
+            rWrittenBytes += journal_.Append(krRecord.type,
+                                             krRecord.key,
+                                             krRecord.data.data(),
+                                             krRecord.data.size());
         }
+    }
+
+    isWritten = journal_.End();
+    rStallUs  = MAX(rStallUs, journal_.GetLongestStall());
+
+    return isWritten;
+}
 
-        if(patterns_.second == true)
+void Storage::CollectRecords(const bool                   kCompact,
+                             std::vector<SStorageRecord>& rRecords)
+{
+    uint8_t*               pBuffer;
+    size_t                 size;
+    PatternCache::iterator it;
+
+    pBuffer = new uint8_t[BIG_BUFFER_SIZE];
+
+    xSemaphoreTake(lock_, portMAX_DELAY);
+
+    /* The new journal only holds the current data */
+    if(kCompact == true)
+    {
+        pin_.second           = true;
+        token_.second         = true;
+        brightness_.second    = true;
+        selectedScene_.second = true;
+        strips_.second        = true;
+        scenes_.second        = true;
+
+        it = patterns_.begin();
+        while(it != patterns_.end())
         {
-            for(const std::shared_ptr<Pattern>& krPattern : patterns_.first)
+            if(it->second.pattern == nullptr)
             {
-                CommitPattern(krPattern);
+                it = patterns_.erase(it);
+            }
+            else
+            {
+                it->second.isDirty = true;
+                ++it;
             }
-
-            patterns_.second = false;
         }
+    }
 
-        if(scenes_.second == true)
-        {
-            CommitScenes();
+    if(pin_.second == true)
+    {
+        AddRecord(rRecords,
+                  RECORD_PIN,
+                  0,
+                  (const uint8_t*)pin_.first.c_str(),
+                  pin_.first.size());
+        pin_.second = false;
+    }
 
-            scenes_.second = false;
-        }
+    if(token_.second == true)
+    {
+        AddRecord(rRecords,
+                  RECORD_TOKEN,
+                  0,
+                  (const uint8_t*)token_.first.c_str(),
+                  token_.first.size());
+        token_.second = false;
+    }
+
+    if(brightness_.second == true)
+    {
+        AddRecord(rRecords,
+                  RECORD_BRIGHTNESS,
+                  0,
+                  &brightness_.first,
+                  sizeof(brightness_.first));
+        brightness_.second = false;
+    }
+
+    if(selectedScene_.second == true)
+    {
+        AddRecord(rRecords,
+                  RECORD_SELECTED_SCENE,
+                  0,
+                  &selectedScene_.first,
+                  sizeof(selectedScene_.first));
+        selectedScene_.second = false;
+    }
 
-        if(selectedScene_.second == true)
+    if(strips_.second == true)
+    {
+        size = SerializeStrips(pBuffer, BIG_BUFFER_SIZE);
+        if(size != 0)
         {
-            size = sizeof(selectedScene_.first);
-            WriteFile(SELECTED_SCENE_PATH, &selectedScene_.first, size);
+            AddRecord(rRecords, RECORD_STRIPS, 0, pBuffer, size);
+        }
+        strips_.second = false;
+    }
 
-            selectedScene_.second = false;
+    if(scenes_.second == true)
+    {
+        size = SerializeScenes(pBuffer, BIG_BUFFER_SIZE);
+        if(size != 0)
+        {
+            AddRecord(rRecords, RECORD_SCENES, 0, pBuffer, size);
         }
+        scenes_.second = false;
+    }
 
-        LOG_DEBUG("Commited cache\n");
+    /* Only write the changed patterns and erase the removed ones */
+    it = patterns_.begin();
+    while(it != patterns_.end())
+    {
+        if(it->second.isDirty == false)
+        {
+            ++it;
+        }
+        else if(it->second.pattern == nullptr)
+        {
+            rRecords.push_back({
+                .type    = RECORD_PATTERN,
+                .key     = it->first,
+                .isErase = true,
+                .data    = std::vector<uint8_t>()
+            });
+            it = patterns_.erase(it);
+        }
+        else
+        {
+            size = PatternImage::Write(*it->second.pattern,
+                                       pBuffer,
+                                       BIG_BUFFER_SIZE);
+            if(size != 0)
+            {
+                AddRecord(rRecords, RECORD_PATTERN, it->first, pBuffer, size);
+            }
+            it->second.isDirty = false;
+            ++it;
+        }
     }
+
+    xSemaphoreGive(lock_);
+
+    delete[] pBuffer;
 }
 
-void Storage::WriteFile(const char* kpPath,
-                        const uint8_t* kpBuffer,
-                        size_t& rSize) const
+void Storage::ReplayRecord(void*          pParam,
+                           const uint8_t  kType,
+                           const uint16_t kKey,
+                           const uint8_t* kpData,
+                           const uint16_t kSize)
 {
-    File file;
+    ((Storage*)pParam)->ApplyRecord(kType, kKey, kpData, kSize);
+}
 
-    /* Remove if exists */
-    if(SPIFFS.exists(kpPath))
-    {
-        LOG_DEBUG("Removing %s\n", kpPath);
-        SPIFFS.remove(kpPath);
-    }
+void Storage::ApplyRecord(const uint8_t  kType,
+                          const uint16_t kKey,
+                          const uint8_t* kpData,
+                          const uint16_t kSize)
+{
+    std::shared_ptr<Pattern> patternPtr;
 
-    LOG_DEBUG("Creating %s\n", kpPath);
-    file = SPIFFS.open(kpPath, FILE_WRITE);
-    if(!file)
+    /* Only the patterns are erased */
+    if(kpData == nullptr &&
+       kType != RECORD_PATTERN &&
+       kType != RECORD_PATTERN_LEGACY)
     {
-        LOG_ERROR("Failed to open %s for writting\n", kpPath);
-        rSize = 0;
+        LOG_ERROR("Unexpected erase record %d\n", kType);
         return;
     }
 
-    /* Write to file */
-    LOG_DEBUG("Writing %s\n", kpPath);
-    if((rSize = file.write(kpBuffer, rSize)) == 0)
+    switch(kType)
     {
-        LOG_ERROR("Could not wirte file %s\n", file.name());
-    }
-    else
-    {
-        LOG_INFO("Wrote file %s\n", file.name());
+        case RECORD_PIN:
+            pin_.first = std::string((const char*)kpData, kSize);
+            break;
+        case RECORD_TOKEN:
+            token_.first = std::string((const char*)kpData, kSize);
+            break;
+        case RECORD_BRIGHTNESS:
+            if(kSize == sizeof(uint8_t))
+            {
+                brightness_.first = *kpData;
+            }
+            break;
+        case RECORD_SELECTED_SCENE:
+            if(kSize == sizeof(uint8_t))
+            {
+                selectedScene_.first = *kpData;
+            }
+            break;
+        case RECORD_STRIPS:
+            DeserializeStrips(kpData, kSize);
+            break;
+        case RECORD_STRIPS_LEGACY:
+            DeserializeLegacyStrips(kpData, kSize, true);
+            hasLegacyRecords_ = true;
+            break;
+        case RECORD_STRIPS_RGB_LEGACY:
+            DeserializeLegacyStrips(kpData, kSize, false);
+            hasLegacyRecords_ = true;
+            break;
+        case RECORD_SCENES:
+            DeserializeScenes(kpData, kSize);
+            break;
+        case RECORD_SCENES_LEGACY:
+            DeserializeLegacyScenes(kpData, kSize);
+            hasLegacyRecords_ = true;
+            break;
+        case RECORD_PATTERN:
+            if(kpData == nullptr)
+            {
+                patterns_.erase(kKey);
+                break;
+            }
+            /* The image is kept packed, it is compiled in place */
+            patternPtr = std::make_shared<Pattern>(kKey, "");
+            if(patternPtr->LoadImage(kpData, kSize) == true &&
+               patternPtr->GetId() == kKey)
+            {
+                patterns_[kKey] = {
+                    .pattern = patternPtr,
+                    .isDirty = false
+                };
+            }
+            else
+            {
+                LOG_ERROR("Could not load pattern %d\n", kKey);
+            }
+            break;
+        case RECORD_PATTERN_LEGACY:
+            if(kpData == nullptr)
+            {
+                patterns_.erase(kKey);
+                break;
+            }
+            /* Rewritten as an image, see LoadData */
+            patternPtr = DeserializeLegacyPattern(kpData, kSize, false);
+            if(patternPtr != nullptr && patternPtr->GetId() == kKey)
+            {
+                patterns_[kKey] = {
+                    .pattern = patternPtr,
+                    .isDirty = true
+                };
+                hasLegacyRecords_ = true;
+            }
+            else
+            {
+                LOG_ERROR("Could not load pattern %d\n", kKey);
+            }
+            break;
+        default:
+            LOG_ERROR("Unknown record type %d\n", kType);
+            break;
     }
-
-    file.close();
 }
 
 void Storage::ReadFile(const char* kpPath,
@@ -495,23 +1018,80 @@ void Storage::ReadFile(const char* kpPath,
     LOG_DEBUG("Read %d bytes in %s\n", rSize, kpPath);
 }
 
-void Storage::LoadPatterns(void)
+void Storage::LoadLegacyData(const bool kLegacySpeed)
+{
+    uint8_t* pBuffer;
+    size_t   readSize;
+
+    pBuffer = new uint8_t[BIG_BUFFER_SIZE];
+
+    /* Load Pin */
+    readSize = BUFFER_SIZE;
+    ReadFile(BLE_PIN_PATH, pBuffer, readSize);
+    if(readSize != 0)
+    {
+        pin_.first = std::string((const char*)pBuffer, readSize);
+    }
+
+    /* Load Token */
+    readSize = BUFFER_SIZE;
+    ReadFile(BLE_TOKEN_PATH, pBuffer, readSize);
+    if(readSize != 0)
+    {
+        token_.first = std::string((const char*)pBuffer, readSize);
+    }
+
+    /* Load Brightness */
+    readSize = BUFFER_SIZE;
+    ReadFile(BRIGHTNESS_PATH, pBuffer, readSize);
+    if(readSize == sizeof(uint8_t))
+    {
+        brightness_.first = *pBuffer;
+    }
+
+    /* Load the selected scene */
+    readSize = BUFFER_SIZE;
+    ReadFile(SELECTED_SCENE_PATH, pBuffer, readSize);
+    if(readSize == sizeof(uint8_t))
+    {
+        selectedScene_.first = *pBuffer;
+    }
+
+    /* Load links */
+    readSize = BIG_BUFFER_SIZE;
+    ReadFile(SCENES_PATH, pBuffer, readSize);
+    if(readSize != 0 && readSize != BIG_BUFFER_SIZE)
+    {
+        DeserializeLegacyScenes(pBuffer, readSize);
+    }
+    else
+    {
+        LOG_ERROR("Could not load links, buffer full or empty\n");
+    }
+
+    /* Load strips layout */
+    readSize = BUFFER_SIZE;
+    ReadFile(STRIPS_PATH, pBuffer, readSize);
+    if(readSize != 0)
+    {
+        DeserializeLegacyStrips(pBuffer, readSize, false);
+    }
+
+    delete[] pBuffer;
+
+    LoadLegacyPatterns(kLegacySpeed);
+}
+
+void Storage::LoadLegacyPatterns(const bool kLegacySpeed)
 {
     File                     root;
     File                     file;
     uint8_t*                 pBuffer;
     const char*              kpPatternName = PATTERN_PATH;
-    size_t                   i;
-    size_t                   bufferOff;
     size_t                   readSize;
     size_t                   patternPathSize;
     size_t                   readBytes;
-    size_t                   elemCount;
-    SColor                   loadedColor;
-    SAnimation               loadedAnim;
     std::shared_ptr<Pattern> patternPtr;
-    std::vector<SColor>      colors;
-    std::vector<SAnimation>  anims;
 
     root = SPIFFS.open("/");
     if(!root)
@@ -523,7 +1103,7 @@ void Storage::LoadPatterns(void)
     ++kpPatternName;
     patternPathSize = strlen(kpPatternName);
 
-    pBuffer = new uint8_t[BUFFER_SIZE];
+    pBuffer = new uint8_t[PATTERN_BUFFER_SIZE];
 
     file = root.openNextFile();
     while(file)
@@ -532,16 +1112,14 @@ void Storage::LoadPatterns(void)
         {
             LOG_DEBUG("Reading %s\n", file.name());
 
-            bufferOff = 0;
-            readSize  = BUFFER_SIZE - 1;
-
-            while(file.available() && readSize > 0)
+            readSize = 0;
+            while(file.available() && readSize < PATTERN_BUFFER_SIZE)
             {
-                readBytes = file.read(pBuffer + bufferOff, readSize);
+                readBytes = file.read(pBuffer + readSize,
+                                      PATTERN_BUFFER_SIZE - readSize);
                 if(readBytes > 0)
                 {
-                    bufferOff += readBytes;
-                    readSize  -= readBytes;
+                    readSize += readBytes;
                 }
                 else
                 {
@@ -549,79 +1127,35 @@ void Storage::LoadPatterns(void)
                 }
             }
 
-            if(bufferOff != 0)
+            patternPtr = nullptr;
+            if(readSize != 0)
             {
-                bufferOff = 0;
-
-                /* Read identifier and name and create pattern  */
-                elemCount = *((uint8_t*)&pBuffer[bufferOff]);
-                bufferOff += sizeof(uint8_t);
-                i = *((uint16_t*)&pBuffer[bufferOff + elemCount]);
-                patternPtr = std::make_shared<Pattern>(i, std::string(&pBuffer[bufferOff],
-                                                                      &pBuffer[bufferOff] + elemCount));
-                bufferOff += elemCount + sizeof(uint16_t);
-
-                /* Read brightness */
-                patternPtr->SetBrightness(*((uint8_t*)&pBuffer[bufferOff]));
-                bufferOff += sizeof(uint8_t);
-
-                /* Load animations */
-                elemCount = *((uint8_t*)&pBuffer[bufferOff]);
-                bufferOff += sizeof(uint8_t);
-                LOG_DEBUG("Loading %d animations\n", elemCount);
-                anims.resize(elemCount);
-                for(i = 0; i < elemCount; ++i)
-                {
-                    if(bufferOff + sizeof(SAnimation) > BUFFER_SIZE)
-                    {
-                        LOG_ERROR("Could not load animation, buffer is full %s\n",
-                                  bufferOff);
-                        delete[] pBuffer;
-                        return;
-                    }
-
-                    memcpy(&loadedAnim,
-                           &pBuffer[bufferOff],
-                           sizeof(SAnimation));
-                    bufferOff += sizeof(SAnimation);
-
-                    anims[i] = loadedAnim;
-                }
-
-                /* Load colors */
-                elemCount = *((uint8_t*)&pBuffer[bufferOff]);
-                bufferOff += sizeof(uint8_t);
-                LOG_DEBUG("Loading %d colors\n", elemCount);
-                colors.resize(elemCount);
-                for(i = 0; i < elemCount; ++i)
-                {
-                    if(bufferOff + sizeof(SColor) > BUFFER_SIZE)
-                    {
-                        LOG_ERROR("Could not load color, buffer is full\n");
-                        delete[] pBuffer;
-                        return;
-                    }
-
-                    memcpy(&loadedColor,
-                           &pBuffer[bufferOff],
-                           sizeof(SColor));
-                    bufferOff += sizeof(SColor);
-
-                    colors[i] = loadedColor;
-                }
-
-                /* Add colors and animation to pattern */
-                patternPtr->SetAnimations(anims);
-                patternPtr->SetColors(colors);
-
-                /* Add the pattern */
-                patterns_.first.push_back(patternPtr);
+                patternPtr = DeserializeLegacyPattern(pBuffer,
+                                                      readSize,
+                                                      kLegacySpeed);
+            }
 
-                LOG_DEBUG("Loaded %s\n", file.name());
+            /* A pattern saved under another identifier left an orphan file,
+             * the first file loaded is kept.
+             */
+            if(patternPtr == nullptr)
+            {
+                LOG_ERROR("Could not load %s\n", file.name());
+            }
+            else if(patterns_.count(patternPtr->GetId()) != 0)
+            {
+                LOG_ERROR("Duplicate pattern %d in %s\n",
+                          patternPtr->GetId(),
+                          file.name());
             }
             else
             {
-                LOG_ERROR("Could not load pattern, buffer too small\n");
+                patterns_[patternPtr->GetId()] = {
+                    .pattern = patternPtr,
+                    .isDirty = false
+                };
+
+                LOG_DEBUG("Loaded %s\n", file.name());
             }
         }
         else
@@ -634,136 +1168,397 @@ void Storage::LoadPatterns(void)
     delete[] pBuffer;
 }
 
-void Storage::CommitPattern(const std::shared_ptr<Pattern>& krPattern) const
+void Storage::RemoveLegacyData(void)
 {
-    File     file;
-    uint8_t* pBuffer;
-    size_t   buffSize;
-    size_t   nameSize;
-
-    pBuffer = new uint8_t[BUFFER_SIZE];
+    File                     root;
+    File                     file;
+    size_t                   i;
+    const char*              kpPatternName = PATTERN_PATH;
+    std::vector<std::string> paths;
 
-    /* Create the file or remove it before */
-    snprintf((char*)pBuffer,
-             BUFFER_SIZE,
-             "%s%s",
-             PATTERN_PATH,
-             std::to_string(krPattern->GetId()).c_str());
+    for(i = 0; i < sizeof(sLegacyPaths) / sizeof(sLegacyPaths[0]); ++i)
+    {
+        paths.push_back(sLegacyPaths[i]);
+    }
 
-    /* Remove if exists */
-    if(SPIFFS.exists((char*)pBuffer))
+    /* Gather the patterns files, they are removed once the directory is
+     * read.
+     */
+    ++kpPatternName;
+    root = SPIFFS.open("/");
+    if(root)
     {
-        SPIFFS.remove((char*)pBuffer);
+        file = root.openNextFile();
+        while(file)
+        {
+            if(strncmp(kpPatternName,
+                       file.name(),
+                       strlen(kpPatternName)) == 0)
+            {
+                paths.push_back(std::string("/") + file.name());
+            }
+            file = root.openNextFile();
+        }
     }
 
-    file = SPIFFS.open((char*)pBuffer, FILE_WRITE);
-    if(!file)
+    for(const std::string& krPath : paths)
     {
-        LOG_ERROR("Failed to open %s for writting\n", pBuffer);
-        delete[] pBuffer;
-        return;
+        if(SPIFFS.exists(krPath.c_str()) == true)
+        {
+            LOG_DEBUG("Removing %s\n", krPath.c_str());
+            SPIFFS.remove(krPath.c_str());
+        }
     }
 
-    buffSize = 0;
+    LOG_INFO("Removed the previous storage files\n");
+}
 
-    /* Save name */
-    nameSize = (uint8_t)krPattern->GetName().size();
-    if(nameSize > 256)
+std::shared_ptr<Pattern> Storage::DeserializeLegacyPattern(
+                                                const uint8_t* kpBuffer,
+                                                const size_t   kSize,
+                                                const bool     kLegacySpeed)
+{
+    size_t                   i;
+    size_t                   bufferOff;
+    size_t                   elemCount;
+    SColor                   loadedColor;
+    SAnimation               loadedAnim;
+    uint8_t                  legacyParam;
+    std::vector<uint32_t>    palette;
+    std::shared_ptr<Pattern> patternPtr;
+    std::vector<SColor>      colors;
+    std::vector<SAnimation>  anims;
+
+    bufferOff = 0;
+
+    /* Read identifier and name and create pattern  */
+    elemCount = kpBuffer[bufferOff];
+    bufferOff += sizeof(uint8_t);
+    if(bufferOff + elemCount + sizeof(uint16_t) + 2 * sizeof(uint8_t) > kSize)
+    {
+        LOG_ERROR("Could not load pattern, buffer too small\n");
+        return nullptr;
+    }
+    i = *((uint16_t*)&kpBuffer[bufferOff + elemCount]);
+    patternPtr = std::make_shared<Pattern>(i, std::string(&kpBuffer[bufferOff],
+                                                          &kpBuffer[bufferOff] + elemCount));
+    bufferOff += elemCount + sizeof(uint16_t);
+
+    /* Read brightness */
+    patternPtr->SetBrightness(kpBuffer[bufferOff]);
+    bufferOff += sizeof(uint8_t);
+
+    /* Load animations */
+    elemCount = kpBuffer[bufferOff];
+    bufferOff += sizeof(uint8_t);
+    if(bufferOff + elemCount * sizeof(SAnimation) + sizeof(uint8_t) > kSize)
     {
-        LOG_ERROR("Pattern name size too big, truncating to 256\n");
-        nameSize = 256;
+        LOG_ERROR("Could not load animations, buffer too small\n");
+        return nullptr;
     }
-    *((uint8_t*)&pBuffer[buffSize]) = nameSize;
-    buffSize += sizeof(uint8_t);
-    memcpy(&pBuffer[buffSize], krPattern->GetName().c_str(), nameSize);
-    buffSize += nameSize;
+    LOG_DEBUG("Loading %d animations\n", elemCount);
+    anims.resize(elemCount);
+    for(i = 0; i < elemCount; ++i)
+    {
+        memcpy(&loadedAnim, &kpBuffer[bufferOff], sizeof(SAnimation));
 
-    /* Save identifier */
-    *((uint16_t*)&pBuffer[buffSize]) = krPattern->GetId();
-    buffSize += sizeof(uint16_t);
+        /* Legacy param was a single byte of frames per step */
+        if(kLegacySpeed == true)
+        {
+            legacyParam = kpBuffer[bufferOff + offsetof(SAnimation, param)];
+            if(legacyParam == 0)
+            {
+                legacyParam = 1;
+            }
+            loadedAnim.param = ANIM_SPEED_UNIT / legacyParam;
+        }
+        bufferOff += sizeof(SAnimation);
 
-    /* Save brightness */
-    *((uint8_t*)&pBuffer[buffSize]) = krPattern->GetBrightness();
-    buffSize += sizeof(uint8_t);
+        anims[i] = loadedAnim;
+    }
 
-    /* Save animations */
-    const std::vector<SAnimation>& krAnims = krPattern->GetAnimations();
-    *((uint8_t*)&pBuffer[buffSize]) = (uint8_t)krAnims.size();
-    buffSize += sizeof(uint8_t);
-    for(const SAnimation& krAnim : krAnims)
+    /* Load colors */
+    elemCount = kpBuffer[bufferOff];
+    bufferOff += sizeof(uint8_t);
+    if(bufferOff + elemCount * sizeof(SColor) > kSize)
     {
-        if(buffSize + sizeof(SAnimation) > BUFFER_SIZE)
+        LOG_ERROR("Could not load colors, buffer too small\n");
+        return nullptr;
+    }
+    LOG_DEBUG("Loading %d colors\n", elemCount);
+    colors.resize(elemCount);
+    for(i = 0; i < elemCount; ++i)
+    {
+        memcpy(&loadedColor, &kpBuffer[bufferOff], sizeof(SColor));
+        bufferOff += sizeof(SColor);
+
+        colors[i] = loadedColor;
+    }
+
+    /* Load the palette of indexed patterns */
+    if(bufferOff + sizeof(uint16_t) <= kSize)
+    {
+        elemCount = *((uint16_t*)&kpBuffer[bufferOff]);
+        bufferOff += sizeof(uint16_t);
+        if(bufferOff + elemCount * sizeof(uint32_t) > kSize)
         {
-            LOG_ERROR("Could not save animation, buffer is full %d\n",
-                      buffSize);
-            delete[] pBuffer;
-            return;
+            LOG_ERROR("Could not load palette, buffer too small\n");
+            elemCount = 0;
         }
+        palette.resize(elemCount);
+        memcpy(palette.data(),
+               &kpBuffer[bufferOff],
+               elemCount * sizeof(uint32_t));
+    }
 
-        memcpy(&pBuffer[buffSize], &krAnim, sizeof(SAnimation));
-        buffSize += sizeof(SAnimation);
+    /* Add colors and animation to pattern */
+    patternPtr->SetAnimations(anims);
+    patternPtr->SetColors(colors);
+    patternPtr->SetPalette(palette);
+
+    return patternPtr;
+}
+
+void Storage::DeserializeScenes(const uint8_t* kpBuffer, const size_t kSize)
+{
+    size_t      bufferOff;
+    size_t      nameSize;
+    uint8_t     scenesCount;
+    uint8_t     linksCount;
+    uint8_t     stripId;
+    uint16_t    patternId;
+    uint8_t     i;
+    SLinkParams params;
+    std::shared_ptr<SScene> newScenePtr;
+
+    scenes_.first.clear();
+
+    if(kSize < SCENES_HEADER_SIZE || kpBuffer[0] != SCENES_RECORD_VERSION)
+    {
+        LOG_ERROR("Failed to load scenes, unknown record version\n");
+        return;
     }
+    scenesCount = kpBuffer[1];
+    bufferOff   = SCENES_HEADER_SIZE;
 
-    /* Save colors */
-    const std::vector<SColor>& krColors = krPattern->GetColors();
-    *((uint8_t*)&pBuffer[buffSize]) = (uint8_t)krColors.size();
-    buffSize += sizeof(uint8_t);
-    for(const SColor& krColor : krColors)
+    for(i = 0; i < scenesCount; ++i)
     {
-        if(buffSize + sizeof(SColor) > BUFFER_SIZE)
+        if(bufferOff + SCENE_HEADER_SIZE > kSize)
         {
-            LOG_ERROR("Could not save color, buffer is full\n");
-            delete[] pBuffer;
+            LOG_ERROR("Failed to load scenes, buffer is too small\n");
+            scenes_.first.clear();
             return;
         }
+        nameSize   = kpBuffer[bufferOff];
+        linksCount = kpBuffer[bufferOff + 5];
+        if(bufferOff + SCENE_HEADER_SIZE + nameSize +
+           linksCount * SCENE_LINK_SIZE > kSize)
+        {
+            LOG_ERROR("Failed to load scenes, buffer is too small\n");
+            scenes_.first.clear();
+            return;
+        }
+
+        newScenePtr = std::make_shared<SScene>();
+        newScenePtr->fps          = kpBuffer[bufferOff + 1];
+        newScenePtr->transition   = kpBuffer[bufferOff + 2];
+        newScenePtr->transitionMs = ReadLE16(&kpBuffer[bufferOff + 3]);
+        bufferOff += SCENE_HEADER_SIZE;
 
-        memcpy(&pBuffer[buffSize], &krColor, sizeof(SColor));
-        buffSize += sizeof(SColor);
+        newScenePtr->name = std::string(&kpBuffer[bufferOff],
+                                        &kpBuffer[bufferOff + nameSize]);
+        bufferOff += nameSize;
+
+        while(linksCount != 0)
+        {
+            stripId           = kpBuffer[bufferOff];
+            patternId         = ReadLE16(&kpBuffer[bufferOff + 1]);
+            params.brightness = kpBuffer[bufferOff + 3];
+            params.flags      = kpBuffer[bufferOff + 4];
+            params.speed      = ReadLE16(&kpBuffer[bufferOff + 5]);
+            params.phase      = ReadLE16(&kpBuffer[bufferOff + 7]);
+            newScenePtr->links.Set(stripId, patternId, params);
+
+            bufferOff += SCENE_LINK_SIZE;
+            --linksCount;
+        }
+
+        scenes_.first.push_back(newScenePtr);
     }
+}
 
-    /* Write to file */
-    if(file.write(pBuffer, buffSize) == 0)
+size_t Storage::SerializeScenes(uint8_t* pBuffer, const size_t kSize) const
+{
+    size_t  bufferOff;
+    size_t  nameSize;
+    uint8_t scenesCount;
+    const std::vector<std::shared_ptr<SScene>>& krScenes = scenes_.first;
+
+    if(kSize < SCENES_HEADER_SIZE)
     {
-        LOG_ERROR("Could not write file %s\n", file.name());
+        LOG_ERROR("Failed to save scenes, buffer is too small\n");
+        return 0;
     }
-    else
+
+    scenesCount = (uint8_t)krScenes.size();
+    pBuffer[0]  = SCENES_RECORD_VERSION;
+    pBuffer[1]  = scenesCount;
+    bufferOff   = SCENES_HEADER_SIZE;
+
+    for(const std::shared_ptr<SScene>& krScene : krScenes)
     {
-        LOG_INFO("Saved file %s\n", file.name());
+        nameSize = krScene->name.size();
+        if(nameSize > 255)
+        {
+            nameSize = 255;
+            LOG_ERROR("Cutting scene name, name too big\n");
+        }
+        if(bufferOff + SCENE_HEADER_SIZE + nameSize +
+           krScene->links.Size() * SCENE_LINK_SIZE > kSize)
+        {
+            LOG_ERROR("Failed to save scenes, buffer is too small\n");
+            return 0;
+        }
+
+        pBuffer[bufferOff]     = nameSize;
+        pBuffer[bufferOff + 1] = krScene->fps;
+        pBuffer[bufferOff + 2] = krScene->transition;
+        WriteLE16(&pBuffer[bufferOff + 3], krScene->transitionMs);
+        pBuffer[bufferOff + 5] = krScene->links.Size();
+        bufferOff += SCENE_HEADER_SIZE;
+
+        memcpy(&pBuffer[bufferOff], krScene->name.c_str(), nameSize);
+        bufferOff += nameSize;
+
+        for(const SSceneLink& krLink : krScene->links)
+        {
+            pBuffer[bufferOff] = krLink.stripId;
+            WriteLE16(&pBuffer[bufferOff + 1], krLink.patternId);
+            pBuffer[bufferOff + 3] = krLink.params.brightness;
+            pBuffer[bufferOff + 4] = krLink.params.flags;
+            WriteLE16(&pBuffer[bufferOff + 5], krLink.params.speed);
+            WriteLE16(&pBuffer[bufferOff + 7], krLink.params.phase);
+            bufferOff += SCENE_LINK_SIZE;
+        }
     }
 
-    file.close();
+    return bufferOff;
+}
 
-    delete[] pBuffer;
+void Storage::DeserializeStrips(const uint8_t* kpBuffer, const size_t kSize)
+{
+    size_t       bufferOff;
+    size_t       nameSize;
+    uint8_t      stripsCount;
+    uint8_t      i;
+    SStripConfig strip;
+
+    /* An unreadable layout is replaced by the default one */
+    strips_.first.clear();
+    strips_.second = true;
+
+    if(kSize < STRIPS_HEADER_SIZE || kpBuffer[0] != STRIPS_RECORD_VERSION)
+    {
+        LOG_ERROR("Failed to load strips, unknown record version\n");
+        return;
+    }
+    stripsCount = kpBuffer[1];
+    bufferOff   = STRIPS_HEADER_SIZE;
+
+    for(i = 0; i < stripsCount; ++i)
+    {
+        if(bufferOff + STRIP_HEADER_SIZE > kSize ||
+           bufferOff + STRIP_HEADER_SIZE + kpBuffer[bufferOff + 5] > kSize)
+        {
+            LOG_ERROR("Failed to load strips, buffer too small\n");
+            strips_.first.clear();
+            return;
+        }
+
+        strip.ctrlGPIO   = (gpio_num_t)kpBuffer[bufferOff];
+        strip.mosfetGPIO = (gpio_num_t)kpBuffer[bufferOff + 1];
+        strip.numLed     = ReadLE16(&kpBuffer[bufferOff + 2]);
+        strip.isIndexed  = (kpBuffer[bufferOff + 4] == STRIP_MODE_INDEXED);
+        nameSize         = kpBuffer[bufferOff + 5];
+        bufferOff += STRIP_HEADER_SIZE;
+
+        strip.name = std::string(&kpBuffer[bufferOff],
+                                 &kpBuffer[bufferOff + nameSize]);
+        bufferOff += nameSize;
+
+        strips_.first.push_back(strip);
+    }
+
+    strips_.second = false;
 }
 
-void Storage::LoadScenes(void)
+size_t Storage::SerializeStrips(uint8_t* pBuffer, const size_t kSize) const
 {
-    size_t   bufferSize;
-    size_t   bufferOff;
-    size_t   sizeProp;
-    uint8_t  scenesCount;
-    uint8_t  idx;
-    uint8_t  i;
-    uint8_t* pBuffer;
-    std::shared_ptr<SScene> newScenePtr;
+    size_t bufferOff;
+    size_t nameSize;
+
+    if(kSize < STRIPS_HEADER_SIZE)
+    {
+        LOG_ERROR("Failed to save strips, buffer is too small\n");
+        return 0;
+    }
+
+    pBuffer[0] = STRIPS_RECORD_VERSION;
+    pBuffer[1] = (uint8_t)strips_.first.size();
+    bufferOff  = STRIPS_HEADER_SIZE;
+
+    for(const SStripConfig& krStrip : strips_.first)
+    {
+        nameSize = krStrip.name.size();
+        if(nameSize > 255)
+        {
+            nameSize = 255;
+            LOG_ERROR("Cutting strip name, name too big\n");
+        }
+        if(bufferOff + STRIP_HEADER_SIZE + nameSize > kSize)
+        {
+            LOG_ERROR("Failed to save strips, buffer is too small\n");
+            return 0;
+        }
+
+        pBuffer[bufferOff]     = (uint8_t)krStrip.ctrlGPIO;
+        pBuffer[bufferOff + 1] = (uint8_t)krStrip.mosfetGPIO;
+        WriteLE16(&pBuffer[bufferOff + 2], krStrip.numLed);
+        pBuffer[bufferOff + 4] = krStrip.isIndexed ? STRIP_MODE_INDEXED :
+                                                     STRIP_MODE_RGB;
+        pBuffer[bufferOff + 5] = (uint8_t)nameSize;
+        bufferOff += STRIP_HEADER_SIZE;
+
+        memcpy(&pBuffer[bufferOff], krStrip.name.c_str(), nameSize);
+        bufferOff += nameSize;
+    }
 
-    bufferSize = BIG_BUFFER_SIZE;
+    return bufferOff;
+}
 
-    pBuffer = new uint8_t[bufferSize];
+void Storage::DeserializeLegacyScenes(const uint8_t* kpBuffer,
+                                      const size_t   kSize)
+{
+    size_t      bufferOff;
+    size_t      sizeProp;
+    size_t      linksCount;
+    uint8_t     scenesCount;
+    uint8_t     stripId;
+    uint8_t     i;
+    SLinkParams params;
+    std::shared_ptr<SScene> newScenePtr;
 
-    ReadFile(SCENES_PATH, pBuffer, bufferSize);
+    scenes_.first.clear();
 
-    if(bufferSize == 0 || bufferSize == BIG_BUFFER_SIZE)
+    if(kSize == 0)
     {
-        LOG_ERROR("Could not load links, buffer full or empty\n");
-        delete[] pBuffer;
         return;
     }
 
     bufferOff = 0;
 
     /* Read number of scenes */
-    scenesCount = *(uint8_t*)&pBuffer[bufferOff++];
+    scenesCount = kpBuffer[bufferOff++];
 
     /* Get all scenes */
     for(i = 0; i < scenesCount; ++i)
@@ -771,33 +1566,34 @@ void Storage::LoadScenes(void)
         /* Create scene */
         newScenePtr = std::make_shared<SScene>();
 
-        /* Get name size */
-        sizeProp = (size_t)(*(uint8_t*)&pBuffer[bufferOff++]);
-        if(sizeProp > 256)
+        /* Get name size and name */
+        if(bufferOff + sizeof(uint8_t) > kSize)
         {
-            LOG_ERROR("Cannot load scene, name too big\n");
-            continue;
+            LOG_ERROR("Failed to load scenes, buffer is too small\n");
+            return;
         }
-
-        /* Get name */
-        newScenePtr->name = std::string(&pBuffer[bufferOff],
-                                        &pBuffer[bufferOff + sizeProp]);
+        sizeProp = kpBuffer[bufferOff++];
+        if(bufferOff + sizeProp + sizeof(uint8_t) > kSize)
+        {
+            LOG_ERROR("Failed to load scenes, buffer is too small\n");
+            return;
+        }
+        newScenePtr->name = std::string(&kpBuffer[bufferOff],
+                                        &kpBuffer[bufferOff + sizeProp]);
         bufferOff += sizeProp;
 
         /* Get the number of links */
-        sizeProp = (size_t)(*(uint8_t*)&pBuffer[bufferOff++]);
-        if(bufferOff + (sizeof(uint8_t) + sizeof(uint16_t)) * sizeProp >
-           bufferSize)
+        sizeProp = kpBuffer[bufferOff++];
+        if(bufferOff + (sizeof(uint8_t) + sizeof(uint16_t)) * sizeProp > kSize)
         {
-            LOG_ERROR("Failed to load scenes, buffer is too small (%d, %d, %d\n", bufferSize, sizeProp, bufferOff);
-            delete[] pBuffer;
+            LOG_ERROR("Failed to load scenes, buffer is too small (%d, %d, %d\n", kSize, sizeProp, bufferOff);
             return;
         }
 
         while(sizeProp != 0)
         {
-            idx = *(uint8_t*)&pBuffer[bufferOff++];
-            newScenePtr->links[idx] = *(uint16_t*)&pBuffer[bufferOff];
+            stripId = kpBuffer[bufferOff++];
+            newScenePtr->links.Set(stripId, *(uint16_t*)&kpBuffer[bufferOff]);
             bufferOff += sizeof(uint16_t);
             --sizeProp;
         }
@@ -806,74 +1602,110 @@ void Storage::LoadScenes(void)
         scenes_.first.push_back(newScenePtr);
     }
 
-    /* Load and cache selected scene */
-    bufferSize = BIG_BUFFER_SIZE;
-    ReadFile(SELECTED_SCENE_PATH, pBuffer, bufferSize);
-    selectedScene_.first  = *(uint8_t*)&pBuffer[0];
-
-    delete[] pBuffer;
+    /* The scenes settings follow the scenes, older files do not have them
+     * and the scenes keep the default settings.
+     */
+    if(bufferOff + scenes_.first.size() * sizeof(uint8_t) <= kSize)
+    {
+        for(const std::shared_ptr<SScene>& krScene : scenes_.first)
+        {
+            krScene->fps = kpBuffer[bufferOff++];
+        }
+    }
+    if(bufferOff + scenes_.first.size() * (sizeof(uint8_t) +
+                                           sizeof(uint16_t)) <= kSize)
+    {
+        for(const std::shared_ptr<SScene>& krScene : scenes_.first)
+        {
+            krScene->transition   = kpBuffer[bufferOff++];
+            krScene->transitionMs = *(uint16_t*)&kpBuffer[bufferOff];
+            bufferOff += sizeof(uint16_t);
+        }
+    }
+    linksCount = 0;
+    for(const std::shared_ptr<SScene>& krScene : scenes_.first)
+    {
+        linksCount += krScene->links.Size();
+    }
+    if(bufferOff + linksCount * LINK_PARAMS_SIZE <= kSize)
+    {
+        for(const std::shared_ptr<SScene>& krScene : scenes_.first)
+        {
+            /* Setting the link of a linked strip does not move the links */
+            for(const SSceneLink& krLink : krScene->links)
+            {
+                params.brightness = kpBuffer[bufferOff++];
+                params.flags      = kpBuffer[bufferOff++];
+                params.speed      = *(uint16_t*)&kpBuffer[bufferOff];
+                bufferOff += sizeof(uint16_t);
+                params.phase      = *(uint16_t*)&kpBuffer[bufferOff];
+                bufferOff += sizeof(uint16_t);
+
+                krScene->links.Set(krLink.stripId, krLink.patternId, params);
+            }
+        }
+    }
 }
 
-void Storage::CommitScenes(void) const
+void Storage::DeserializeLegacyStrips(const uint8_t* kpBuffer,
+                                      const size_t   kSize,
+                                      const bool     kHasModes)
 {
-    size_t   bufferOff;
-    size_t   sizeProp;
-    uint8_t  scenesCount;
-    uint8_t  idx;
-    uint8_t  i;
-    uint8_t* pBuffer;
-    std::shared_ptr<SScene> newScenePtr;
-    const std::vector<std::shared_ptr<SScene>>& krScenes = scenes_.first;
+    size_t       bufferOff;
+    size_t       sizeProp;
+    uint8_t      stripsCount;
+    uint8_t      i;
+    SStripConfig strip;
+
+    strips_.first.clear();
+    strips_.second = false;
+
+    if(kSize == 0)
+    {
+        return;
+    }
 
-    pBuffer = new uint8_t[BIG_BUFFER_SIZE];
     bufferOff = 0;
 
-    /* Save number of scenes */
-    scenesCount = (uint8_t)krScenes.size();
-    *(uint8_t*)&pBuffer[bufferOff++] = scenesCount;
+    /* Read number of strips */
+    stripsCount = kpBuffer[bufferOff++];
 
-    /* Save all scenes */
-    for(i = 0; i < scenesCount; ++i)
+    for(i = 0; i < stripsCount; ++i)
     {
-        /* Save name size and name */
-        sizeProp = krScenes[i]->name.size();
-        if(sizeProp > 256)
+        if(bufferOff + (kHasModes ? 4 : 3) * sizeof(uint8_t) +
+           sizeof(uint16_t) > kSize)
         {
-            sizeProp = 256;
-            LOG_ERROR("Cutting scene name, name too big\n");
+            LOG_ERROR("Failed to load strips, buffer too small\n");
+            break;
         }
-        *(uint8_t*)&pBuffer[bufferOff++] = sizeProp;
-        memcpy(&pBuffer[bufferOff], krScenes[i]->name.c_str(), sizeProp);
-        bufferOff += sizeProp;
 
-        /* Get the number of links */
-        sizeProp = krScenes[i]->links.size();
-        if(bufferOff + (sizeof(uint8_t) + sizeof(uint16_t)) * sizeProp >
-           BIG_BUFFER_SIZE)
+        strip.ctrlGPIO   = (gpio_num_t)kpBuffer[bufferOff++];
+        strip.mosfetGPIO = (gpio_num_t)kpBuffer[bufferOff++];
+        strip.numLed     = *(uint16_t*)&kpBuffer[bufferOff];
+        bufferOff += sizeof(uint16_t);
+
+        strip.isIndexed = false;
+        if(kHasModes == true)
         {
-            LOG_ERROR("Failed to save scenes, buffer is too small\n");
-            delete[] pBuffer;
-            return;
+            strip.isIndexed = (kpBuffer[bufferOff++] == STRIP_MODE_INDEXED);
         }
-        *(uint8_t*)&pBuffer[bufferOff++] = sizeProp;
 
-        for(const std::pair<uint8_t, uint16_t>& krLink : krScenes[i]->links)
+        sizeProp = kpBuffer[bufferOff++];
+        if(bufferOff + sizeProp > kSize)
         {
-            *(uint8_t*)&pBuffer[bufferOff++] = krLink.first;
-            *(uint16_t*)&pBuffer[bufferOff]  = krLink.second;
-
-            bufferOff += sizeof(uint16_t);
+            LOG_ERROR("Failed to load strips, buffer too small\n");
+            break;
         }
-    }
-
-    WriteFile(SCENES_PATH, pBuffer, bufferOff);
+        strip.name = std::string(&kpBuffer[bufferOff],
+                                 &kpBuffer[bufferOff + sizeProp]);
+        bufferOff += sizeProp;
 
-    delete[] pBuffer;
+        strips_.first.push_back(strip);
+    }
 }
 
 void Storage::FactoryReset(void)
 {
-    Storage* pStorage;
     Pattern* pPattern;
     File     file;
 
@@ -885,9 +1717,13 @@ void Storage::FactoryReset(void)
     std::shared_ptr<Pattern> patternPtr120LOW;
     std::vector<SColor> colors;
     std::vector<SAnimation> anims;
+    std::vector<SStripConfig> strips;
     std::unordered_map<uint8_t, uint16_t> map;
     std::vector<std::shared_ptr<SScene>>  scenes;
 
+    /* Start from an empty journal */
+    journal_.Reset();
+
     /* Create patterns */
     patternPtrs.push_back(std::make_shared<Pattern>(0, "P0"));
     patternPtrs.push_back(std::make_shared<Pattern>(1, "P1"));
@@ -928,13 +1764,13 @@ void Storage::FactoryReset(void)
         .type = ANIM_TRAIL,
         .startIdx = 0,
         .endIdx = 59,
-        .param = 1
+        .param = ANIM_SPEED_UNIT
     });
     anims.push_back({
         .type = ANIM_TRAIL,
         .startIdx = 119,
         .endIdx = 60,
-        .param = 1
+        .param = ANIM_SPEED_UNIT
     });
     pPattern->SetAnimations(anims);
 
@@ -954,7 +1790,7 @@ void Storage::FactoryReset(void)
         .type = ANIM_BREATH,
         .startIdx = 0,
         .endIdx = 34,
-        .param = 1
+        .param = ANIM_SPEED_UNIT
     });
     pPattern->SetAnimations(anims);
 
@@ -973,7 +1809,7 @@ void Storage::FactoryReset(void)
         .type = ANIM_TRAIL,
         .startIdx = 0,
         .endIdx = 20,
-        .param = 1
+        .param = ANIM_SPEED_UNIT
     });
     pPattern->SetAnimations(anims);
 
@@ -1020,34 +1856,40 @@ void Storage::FactoryReset(void)
     scenes.push_back(std::make_shared<SScene>());
 
     scenes[0]->name = "Scene0";
-    scenes[0]->links.emplace(4, 0);
-    scenes[0]->links.emplace(5, 1);
+    scenes[0]->links.Set(4, 0);
+    scenes[0]->links.Set(5, 1);
 
     scenes[1]->name = "Scene1";
-    scenes[1]->links.emplace(4, 2);
-    scenes[1]->links.emplace(5, 2);
+    scenes[1]->links.Set(4, 2);
+    scenes[1]->links.Set(5, 2);
 
     scenes[2]->name = "Scene120FULL";
-    scenes[2]->links.emplace(4, 3);
+    scenes[2]->links.Set(4, 3);
     scenes[3]->name = "Scene120MID";
-    scenes[3]->links.emplace(4, 4);
+    scenes[3]->links.Set(4, 4);
     scenes[4]->name = "Scene120LOW";
-    scenes[4]->links.emplace(4, 5);
+    scenes[4]->links.Set(4, 5);
     scenes[5]->name = "Scene120OFF";
 
     SaveBrightness(255);
     SavePin("0000");
     SaveToken("1234567891113150");
-    SavePatterns(patternPtrs);
+    for(const std::shared_ptr<Pattern>& krPattern : patternPtrs)
+    {
+        SavePattern(krPattern);
+    }
     SaveScenes(scenes);
     SaveSelectedScene(1);
 
-    Update(true);
+    GetDefaultStrips(strips);
+    SaveStrips(strips);
+
+    Flush();
 
-    /* Create init file */
+    /* Create the init file */
     LOG_DEBUG("Creating %s\n", INIT_FILE_PATH);
     file = SPIFFS.open(INIT_FILE_PATH, FILE_WRITE);
-    close(file);
+    file.close();
 
     LOG_INFO("Initialized flash\n");
-}
\ No newline at end of file
+}
\ No newline at end of file
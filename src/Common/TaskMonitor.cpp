@@ -0,0 +1,232 @@
+/*******************************************************************************
+ * @file TaskMonitor.cpp
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief Tasks configuration and monitoring.
+ *
+ * @details This file provides the configuration of the system tasks and the
+ * monitor of their deadlines and stack usage.
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include <cstdint>   /* Standard Int Types */
+#include <cstring>   /* memset */
+#include <Arduino.h> /* FreeRTOS services */
+#include <Logger.h>  /* Logger services */
+
+/* Header File */
+#include <TaskMonitor.h>
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * STRUCTURES AND TYPES
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/************************* Imported global variables **************************/
+/* None */
+
+/************************* Exported global variables **************************/
+/* None */
+
+/************************** Static global variables ***************************/
+TaskMonitor* TaskMonitor::PINSTANCE_ = nullptr;
+
+static const STaskConfig sTasksConfig[TASK_MAX_ID] = {
+    {
+        .kpName    = "LEDWorker",
+        .priority  = LED_WORKER_TASK_PRIO,
+        .core      = LED_WORKER_TASK_CORE,
+        .stackSize = LED_WORKER_TASK_STACK
+    },
+    {
+        .kpName    = "LEDRender",
+        .priority  = LED_RENDER_TASK_PRIO,
+        .core      = LED_RENDER_TASK_CORE,
+        .stackSize = LED_RENDER_TASK_STACK
+    },
+    {
+        .kpName    = "LEDTransmit",
+        .priority  = LED_TRANSMIT_TASK_PRIO,
+        .core      = LED_TRANSMIT_TASK_CORE,
+        .stackSize = LED_TRANSMIT_TASK_STACK
+    },
+    {
+        .kpName    = "BLEUpdate",
+        .priority  = BLE_TASK_PRIO,
+        .core      = BLE_TASK_CORE,
+        .stackSize = BLE_TASK_STACK
+    },
+    {
+        .kpName    = "StorageFlush",
+        .priority  = STORAGE_TASK_PRIO,
+        .core      = STORAGE_TASK_CORE,
+        .stackSize = STORAGE_TASK_STACK
+    },
+    {
+        .kpName    = "UI",
+        .priority  = UI_TASK_PRIO,
+        .core      = UI_TASK_CORE,
+        .stackSize = UI_TASK_STACK
+    }
+};
+
+/*******************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * CLASS METHODS
+ ******************************************************************************/
+
+TaskMonitor* TaskMonitor::GetInstance(void)
+{
+    if(TaskMonitor::PINSTANCE_ == nullptr)
+    {
+        TaskMonitor::PINSTANCE_ = new TaskMonitor();
+    }
+
+    return TaskMonitor::PINSTANCE_;
+}
+
+const STaskConfig& TaskMonitor::GetConfig(const ETaskId kTaskId)
+{
+    return sTasksConfig[kTaskId];
+}
+
+TaskHandle_t TaskMonitor::CreateTask(const ETaskId  kTaskId,
+                                     TaskFunction_t pRoutine,
+                                     void*          pParam)
+{
+    TaskHandle_t       handle;
+    const STaskConfig& krConfig = sTasksConfig[kTaskId];
+
+    handle = nullptr;
+    if(xTaskCreatePinnedToCore(pRoutine,
+                               krConfig.kpName,
+                               krConfig.stackSize,
+                               pParam,
+                               krConfig.priority,
+                               &handle,
+                               krConfig.core) != pdPASS)
+    {
+        LOG_ERROR("Could not create task %s\n", krConfig.kpName);
+        return nullptr;
+    }
+
+    RegisterTask(kTaskId, handle);
+
+    return handle;
+}
+
+void TaskMonitor::RegisterTask(const ETaskId kTaskId, const TaskHandle_t kHandle)
+{
+    xSemaphoreTake(lock_, portMAX_DELAY);
+    handles_[kTaskId] = kHandle;
+    memset(&stats_[kTaskId], 0, sizeof(STaskStats));
+    xSemaphoreGive(lock_);
+}
+
+void TaskMonitor::ReportPeriod(const ETaskId kTaskId, const bool kOverrun)
+{
+    bool        raiseEvent;
+    STaskStats& rStats = stats_[kTaskId];
+
+    raiseEvent = false;
+
+    xSemaphoreTake(lock_, portMAX_DELAY);
+
+    ++rStats.periods;
+    if(kOverrun == true)
+    {
+        ++rStats.overruns;
+        ++rStats.consecutiveOverruns;
+
+        /* Raise the event once per overrun streak */
+        if(rStats.consecutiveOverruns == TASK_MISS_EVENT_COUNT)
+        {
+            ++rStats.missEvents;
+            raiseEvent = true;
+        }
+    }
+    else
+    {
+        rStats.consecutiveOverruns = 0;
+    }
+
+    xSemaphoreGive(lock_);
+
+    if(raiseEvent == true)
+    {
+        LOG_ERROR("Task %s missed %d consecutive deadlines\n",
+                  sTasksConfig[kTaskId].kpName,
+                  TASK_MISS_EVENT_COUNT);
+        xEventGroupSetBits(events_, 1 << kTaskId);
+    }
+}
+
+void TaskMonitor::GetStats(const ETaskId kTaskId, STaskStats& rStats)
+{
+    xSemaphoreTake(lock_, portMAX_DELAY);
+
+    rStats = stats_[kTaskId];
+    if(handles_[kTaskId] != nullptr)
+    {
+        /* ESP-IDF stacks are counted in bytes */
+        rStats.stackHighWater = uxTaskGetStackHighWaterMark(handles_[kTaskId]);
+    }
+
+    xSemaphoreGive(lock_);
+}
+
+EventGroupHandle_t TaskMonitor::GetEventGroup(void) const
+{
+    return events_;
+}
+
+TaskMonitor::TaskMonitor(void)
+{
+    uint8_t i;
+
+    for(i = 0; i < TASK_MAX_ID; ++i)
+    {
+        handles_[i] = nullptr;
+        memset(&stats_[i], 0, sizeof(STaskStats));
+    }
+
+    lock_   = xSemaphoreCreateMutex();
+    events_ = xEventGroupCreate();
+}
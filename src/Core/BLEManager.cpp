@@ -26,6 +26,8 @@
 #include <SystemState.h> /* System state services */
 #include <Logger.h>      /* Logger */
 #include <StripsManager.h> /* Strips manager */
+#include <TaskMonitor.h>   /* Tasks configuration and monitoring */
+#include <PatternImage.h>  /* Pattern stored image */
 
 /* Header File */
 #include <BLEManager.h>
@@ -46,11 +48,16 @@
 #define MANAGE_PATTERNS_CHARACTERISTIC_UUID "ff957108-a010-4dff-8cc2-1600f48045c3"
 #define MANAGE_SCENES_CHARACTERISTIC_UUID   "40325d79-46c1-4d7d-a71f-edfbe27b98d1"
 #define SET_SCENE_CHARACTERISTIC_UUID       "d5d97123-28bf-466b-9d73-2cf3f056bae0"
+#define MANAGE_BATCH_CHARACTERISTIC_UUID    "6b1f0a5e-93c4-4d27-b8e1-5a7c2f04d9b3"
+#define SET_STRIPS_CHARACTERISTIC_UUID      "c4a7e2d0-5b36-4f1e-9a8d-3e6f0b72c915"
 
 #define SET_BRIGHTNESS_COMMAND_SIZE (BLE_TOCKEN_SIZE + sizeof(uint8_t))
 #define SET_TOKEN_COMMAND_SIZE      (BLE_TOCKEN_SIZE + BLE_TOCKEN_SIZE)
 #define SET_SCENE_COMMAND_SIZE      (BLE_TOCKEN_SIZE + sizeof(uint8_t))
 
+/* Period of the characteristics values update */
+#define BLE_UPDATE_PERIOD_MS 25
+
 #define BLE_CMD_SCENE_MGT_ADD 0
 #define BLE_CMD_SCENE_MGT_REM 1
 #define BLE_CMD_SCENE_MGT_UPD 2
@@ -63,6 +70,19 @@
 #define BLE_CMD_PATTERN_MGT_LST 3
 #define BLE_CMD_PATTERN_MGT_GET 4
 
+#define BLE_BATCH_TARGET_PATTERN  0
+#define BLE_BATCH_TARGET_SCENE    1
+#define BLE_BATCH_CMD_HEADER_SIZE (2 * sizeof(uint8_t) + sizeof(uint16_t))
+#define BLE_BATCH_ERROR           0xFFFF
+
+/* Serialized sizes of the patterns and scenes elements */
+#define BLE_ANIMATION_SIZE  (sizeof(uint8_t) + 3 * sizeof(uint16_t))
+#define BLE_COLOR_SIZE      (2 * sizeof(uint16_t) + 2 * sizeof(uint32_t))
+#define BLE_SCENE_LINK_SIZE (sizeof(uint8_t) + sizeof(uint16_t))
+#define BLE_STRIP_SIZE      (4 * sizeof(uint8_t) + sizeof(uint16_t))
+
+#define BLE_STRIP_MODE_INDEXED 1
+
 /*******************************************************************************
  * MACROS
  ******************************************************************************/
@@ -152,11 +172,18 @@ class ManagePatternsCallback: public BLECharacteristicCallbacks
     void onWrite(BLECharacteristic* pManagePatternsCharacteristic)
     {
         uint8_t*       data;
+        size_t         size;
         BLEManager*    pBle;
 
         pBle = BLEManager::GetInstance();
 
+        size = pManagePatternsCharacteristic->getLength();
         data = pManagePatternsCharacteristic->getData();
+        if(size < BLE_TOCKEN_SIZE + sizeof(uint8_t))
+        {
+            LOG_ERROR("Incorrect data length in patterns callback.\n");
+            return;
+        }
         if(pBle->ValidateToken((char*)data) == false)
         {
             LOG_ERROR("Invalid BLE Token\n");
@@ -164,18 +191,19 @@ class ManagePatternsCallback: public BLECharacteristicCallbacks
         }
 
         data = data + BLE_TOCKEN_SIZE;
+        size = size - BLE_TOCKEN_SIZE - sizeof(uint8_t);
 
         /* Get the command */
         switch(*data)
         {
             case BLE_CMD_PATTERN_MGT_ADD:
-                onPatternAdd(data + sizeof(uint8_t), pManagePatternsCharacteristic);
+                onPatternAdd(data + sizeof(uint8_t), size, pManagePatternsCharacteristic);
                 break;
             case BLE_CMD_PATTERN_MGT_REM:
                 onPatternRemove(data + sizeof(uint8_t), pManagePatternsCharacteristic);
                 break;
             case BLE_CMD_PATTERN_MGT_UPD:
-                onPatternUpdate(data + sizeof(uint8_t), pManagePatternsCharacteristic);
+                onPatternUpdate(data + sizeof(uint8_t), size, pManagePatternsCharacteristic);
                 break;
             case BLE_CMD_PATTERN_MGT_LST:
                 onGetPatternList(data + sizeof(uint8_t), pManagePatternsCharacteristic);
@@ -189,6 +217,7 @@ class ManagePatternsCallback: public BLECharacteristicCallbacks
     }
 
     void onPatternAdd(const uint8_t* kpData,
+                      const size_t kSize,
                       BLECharacteristic* pManagePatternsCharacteristic) const
     {
 
@@ -199,8 +228,15 @@ class ManagePatternsCallback: public BLECharacteristicCallbacks
 
         pStripManager = StripsManager::GetInstance();
 
-        newPattern = DeserializePattern(kpData, false);
-        retValue   = pStripManager->AddPattern(newPattern);
+        newPattern = DeserializePattern(kpData, kSize, false);
+        if(newPattern != nullptr)
+        {
+            retValue = pStripManager->AddPattern(newPattern);
+        }
+        else
+        {
+            retValue = PATTERN_TABLE_NO_ID;
+        }
 
         pManagePatternsCharacteristic->setValue((uint8_t*)&retValue, sizeof(uint16_t));
     }
@@ -219,6 +255,7 @@ class ManagePatternsCallback: public BLECharacteristicCallbacks
     }
 
     void onPatternUpdate(const uint8_t* kpData,
+                         const size_t kSize,
                          BLECharacteristic* pManagePatternsCharacteristic) const
     {
         bool           retValue;
@@ -228,8 +265,15 @@ class ManagePatternsCallback: public BLECharacteristicCallbacks
 
         pStripManager = StripsManager::GetInstance();
 
-        newPattern = DeserializePattern(kpData, true);
-        retValue   = pStripManager->UpdatePattern(newPattern);
+        newPattern = DeserializePattern(kpData, kSize, true);
+        if(newPattern != nullptr)
+        {
+            retValue = pStripManager->UpdatePattern(newPattern);
+        }
+        else
+        {
+            retValue = false;
+        }
 
         pManagePatternsCharacteristic->setValue((uint8_t*)&retValue, sizeof(bool));
     }
@@ -261,11 +305,12 @@ class ManagePatternsCallback: public BLECharacteristicCallbacks
     void onGetPattern(const uint8_t* kpData,
                       BLECharacteristic* pManagePatternsCharacteristic) const
     {
-        size_t         bufferSize;
-        uint8_t        error;
-        uint8_t*       pBuffer;
-        const Pattern* pkPattern;
-        StripsManager* pStripManager;
+        size_t                   bufferSize;
+        uint8_t                  error;
+        uint8_t*                 pBuffer;
+        const Pattern*           pkPattern;
+        StripsManager*           pStripManager;
+        std::shared_ptr<Pattern> unpacked;
 
         pStripManager = StripsManager::GetInstance();
 
@@ -281,6 +326,14 @@ class ManagePatternsCallback: public BLECharacteristicCallbacks
             return;
         }
 
+        /* The table patterns are packed, unpack a copy to send it */
+        if(pkPattern->IsPacked() == true)
+        {
+            unpacked = PatternImage(pkPattern->GetImage(),
+                                    pkPattern->GetImageSize()).ToPattern();
+            pkPattern = unpacked.get();
+        }
+
         /* Get the required buffer size */
         const std::vector<SAnimation>& tmpAnims = pkPattern->GetAnimations();
         const std::vector<SColor>& tmpColors = pkPattern->GetColors();
@@ -288,7 +341,9 @@ class ManagePatternsCallback: public BLECharacteristicCallbacks
                      pkPattern->GetName().size() +
                      sizeof(uint8_t) +
                      tmpColors.size() * sizeof(SColor) +
-                     tmpAnims.size() * sizeof(SAnimation);
+                     tmpAnims.size() * sizeof(SAnimation) +
+                     sizeof(uint16_t) +
+                     pkPattern->GetPalette().size() * sizeof(uint32_t);
         pBuffer = new uint8_t[bufferSize];
 
         SerializePattern(pkPattern, *(uint16_t*)kpData, pBuffer);
@@ -309,6 +364,7 @@ class ManagePatternsCallback: public BLECharacteristicCallbacks
 
         const std::vector<SAnimation>& tmpAnims = pkPattern->GetAnimations();
         const std::vector<SColor>& tmpColors = pkPattern->GetColors();
+        const std::vector<uint32_t>& krPalette = pkPattern->GetPalette();
         const std::string& krName = pkPattern->GetName();
 
         buffOffset = 0;
@@ -342,7 +398,8 @@ class ManagePatternsCallback: public BLECharacteristicCallbacks
             buffOffset += sizeof(uint16_t);
             *(uint16_t*)&pBuffer[buffOffset] = krAnim.endIdx;
             buffOffset += sizeof(uint16_t);
-            *(uint8_t*)&pBuffer[buffOffset++] = krAnim.param;
+            *(uint16_t*)&pBuffer[buffOffset] = krAnim.param;
+            buffOffset += sizeof(uint16_t);
         }
 
         /* Write colors */
@@ -358,10 +415,21 @@ class ManagePatternsCallback: public BLECharacteristicCallbacks
             buffOffset += sizeof(uint32_t);
         }
 
+        /* Write palette */
+        *(uint16_t*)&pBuffer[buffOffset] = krPalette.size();
+        buffOffset += sizeof(uint16_t);
+        for(const uint32_t kColorCode : krPalette)
+        {
+            *(uint32_t*)&pBuffer[buffOffset] = kColorCode;
+            buffOffset += sizeof(uint32_t);
+        }
     }
 
-    std::shared_ptr<Pattern> DeserializePattern(const uint8_t* pBuffer,
-                                                const bool kHasId) const
+    public:
+    /* Returns nullptr if the buffer is shorter than its declared content */
+    static std::shared_ptr<Pattern> DeserializePattern(const uint8_t* pBuffer,
+                                                       const size_t kSize,
+                                                       const bool kHasId)
     {
         size_t      buffOffset;
         size_t      sizeProp;
@@ -373,12 +441,19 @@ class ManagePatternsCallback: public BLECharacteristicCallbacks
 
         std::vector<SAnimation>  anims;
         std::vector<SColor>      colors;
+        std::vector<uint32_t>    palette;
         std::shared_ptr<Pattern> patternPtr;
 
         buffOffset = 0;
 
         if(kHasId == true)
         {
+            if(kSize < sizeof(uint16_t))
+            {
+                LOG_ERROR("Pattern buffer too small\n");
+                return nullptr;
+            }
+
             /* Get the ID */
             patternId = *(uint16_t*)&pBuffer[buffOffset];
             buffOffset += sizeof(uint16_t);
@@ -388,8 +463,20 @@ class ManagePatternsCallback: public BLECharacteristicCallbacks
             patternId = 0xFFFF;
         }
 
-        /* Get name size and name */
+        /* Get name size and name, then the brightness and the animation and
+         * color counts.
+         */
+        if(buffOffset + sizeof(uint8_t) > kSize)
+        {
+            LOG_ERROR("Pattern buffer too small\n");
+            return nullptr;
+        }
         sizeProp = *(uint8_t*)&pBuffer[buffOffset++];
+        if(buffOffset + sizeProp + 3 * sizeof(uint8_t) > kSize)
+        {
+            LOG_ERROR("Pattern buffer too small\n");
+            return nullptr;
+        }
 
         name = std::string(&pBuffer[buffOffset],
                            &pBuffer[buffOffset] + sizeProp);
@@ -415,6 +502,17 @@ class ManagePatternsCallback: public BLECharacteristicCallbacks
 
         LOG_DEBUG("Offset: %d\n", buffOffset);
 
+        /* The animations, the colors and the palette size must be sent */
+        if(buffOffset + sizeProp * BLE_ANIMATION_SIZE +
+           sizePropSec * BLE_COLOR_SIZE + sizeof(uint16_t) > kSize)
+        {
+            LOG_ERROR("Pattern buffer too small for %d animations and %d "
+                      "colors\n",
+                      sizeProp,
+                      sizePropSec);
+            return nullptr;
+        }
+
         /* Get animations */
         while(sizeProp > 0)
         {
@@ -423,7 +521,8 @@ class ManagePatternsCallback: public BLECharacteristicCallbacks
             buffOffset += sizeof(uint16_t);
             tmpAnim.endIdx = *(uint16_t*)&pBuffer[buffOffset];
             buffOffset += sizeof(uint16_t);
-            tmpAnim.param = *(uint8_t*)&pBuffer[buffOffset++];
+            tmpAnim.param = *(uint16_t*)&pBuffer[buffOffset];
+            buffOffset += sizeof(uint16_t);
 
             anims.push_back(tmpAnim);
             --sizeProp;
@@ -459,6 +558,23 @@ class ManagePatternsCallback: public BLECharacteristicCallbacks
         }
         patternPtr->SetColors(colors);
 
+        /* Get palette, empty for RGB patterns */
+        sizeProp = *(uint16_t*)&pBuffer[buffOffset];
+        buffOffset += sizeof(uint16_t);
+        if(buffOffset + sizeProp * sizeof(uint32_t) > kSize)
+        {
+            LOG_ERROR("Pattern buffer too small for %d palette entries\n",
+                      sizeProp);
+            return nullptr;
+        }
+        while(sizeProp > 0)
+        {
+            palette.push_back(*(uint32_t*)&pBuffer[buffOffset]);
+            buffOffset += sizeof(uint32_t);
+            --sizeProp;
+        }
+        patternPtr->SetPalette(palette);
+
         return patternPtr;
     }
 };
@@ -468,11 +584,18 @@ class ManageSceneCallback: public BLECharacteristicCallbacks
     void onWrite(BLECharacteristic* pManageSceneCharacteristic)
     {
         uint8_t*       data;
+        size_t         size;
         BLEManager*    pBle;
 
         pBle = BLEManager::GetInstance();
 
+        size = pManageSceneCharacteristic->getLength();
         data = pManageSceneCharacteristic->getData();
+        if(size < BLE_TOCKEN_SIZE + sizeof(uint8_t))
+        {
+            LOG_ERROR("Incorrect data length in scenes callback.\n");
+            return;
+        }
         if(pBle->ValidateToken((char*)data) == false)
         {
             LOG_ERROR("Invalid BLE Token\n");
@@ -480,18 +603,19 @@ class ManageSceneCallback: public BLECharacteristicCallbacks
         }
 
         data = data + BLE_TOCKEN_SIZE;
+        size = size - BLE_TOCKEN_SIZE - sizeof(uint8_t);
 
         /* Get the command */
         switch(*data)
         {
             case BLE_CMD_SCENE_MGT_ADD:
-                onSceneAdd(data + sizeof(uint8_t), pManageSceneCharacteristic);
+                onSceneAdd(data + sizeof(uint8_t), size, pManageSceneCharacteristic);
                 break;
             case BLE_CMD_SCENE_MGT_REM:
                 onSceneRemove(data + sizeof(uint8_t), pManageSceneCharacteristic);
                 break;
             case BLE_CMD_SCENE_MGT_UPD:
-                onSceneUpdate(data + sizeof(uint8_t), pManageSceneCharacteristic);
+                onSceneUpdate(data + sizeof(uint8_t), size, pManageSceneCharacteristic);
                 break;
             case BLE_CMD_SCENE_MGT_CNT:
                 onGetSceneCount(data + sizeof(uint8_t), pManageSceneCharacteristic);
@@ -505,6 +629,7 @@ class ManageSceneCallback: public BLECharacteristicCallbacks
     }
 
     void onSceneAdd(const uint8_t* kpData,
+                    const size_t kSize,
                     BLECharacteristic* pManageSceneCharacteristic) const
     {
         uint8_t        retValue;
@@ -514,8 +639,15 @@ class ManageSceneCallback: public BLECharacteristicCallbacks
 
         pStripManager = StripsManager::GetInstance();
 
-        newScene = DeserializeScene(kpData);
-        retValue = pStripManager->AddScene(newScene);
+        newScene = DeserializeScene(kpData, kSize);
+        if(newScene != nullptr)
+        {
+            retValue = pStripManager->AddScene(newScene);
+        }
+        else
+        {
+            retValue = -1;
+        }
 
         pManageSceneCharacteristic->setValue(&retValue, sizeof(uint8_t));
     }
@@ -534,6 +666,7 @@ class ManageSceneCallback: public BLECharacteristicCallbacks
     }
 
     void onSceneUpdate(const uint8_t* kpData,
+                       const size_t kSize,
                        BLECharacteristic* pManageSceneCharacteristic) const
     {
         uint8_t        retValue;
@@ -544,14 +677,16 @@ class ManageSceneCallback: public BLECharacteristicCallbacks
         pStripManager = StripsManager::GetInstance();
 
         /* Check if the scene exists */
-        if(*kpData < pStripManager->GetSceneCount())
-        {
-            newScene = DeserializeScene(kpData + sizeof(uint8_t));
-            retValue = pStripManager->UpdateScene(*kpData, newScene);
-        }
-        else
+        retValue = 0;
+        if(kSize >= sizeof(uint8_t) &&
+           *kpData < pStripManager->GetSceneCount())
         {
-            retValue = 0;
+            newScene = DeserializeScene(kpData + sizeof(uint8_t),
+                                        kSize - sizeof(uint8_t));
+            if(newScene != nullptr)
+            {
+                retValue = pStripManager->UpdateScene(*kpData, newScene);
+            }
         }
 
         pManageSceneCharacteristic->setValue(&retValue, sizeof(uint8_t));
@@ -596,8 +731,12 @@ class ManageSceneCallback: public BLECharacteristicCallbacks
                      sizeof(uint8_t) +
                      pkScene->name.size() +
                      sizeof(uint8_t) +
-                     pkScene->links.size() *
-                      (sizeof(uint8_t) + sizeof(uint16_t));
+                     pkScene->links.Size() *
+                      (sizeof(uint8_t) + sizeof(uint16_t)) +
+                     sizeof(uint8_t) +
+                     sizeof(uint8_t) +
+                     sizeof(uint16_t) +
+                     pkScene->links.Size() * LINK_PARAMS_SIZE;
         pBuffer = new uint8_t[bufferSize];
 
         SerializeScene(pkScene, *kpData, pBuffer);
@@ -628,55 +767,299 @@ class ManageSceneCallback: public BLECharacteristicCallbacks
         buffOffset += sizeProp;
 
         /* Write nb links and all links */
-        sizeProp = pkScene->links.size();
+        sizeProp = pkScene->links.Size();
         *(uint8_t*)&pBuffer[buffOffset++] = sizeProp;
 
-        for(const std::pair<uint8_t, uint16_t>& krLink : pkScene->links)
+        for(const SSceneLink& krLink : pkScene->links)
         {
-            *(uint8_t*)&pBuffer[buffOffset++] = krLink.first;
-            *(uint16_t*)&pBuffer[buffOffset] = krLink.second;
+            *(uint8_t*)&pBuffer[buffOffset++] = krLink.stripId;
+            *(uint16_t*)&pBuffer[buffOffset] = krLink.patternId;
+
+            buffOffset += sizeof(uint16_t);
+        }
+
+        /* Write frame rate */
+        *(uint8_t*)&pBuffer[buffOffset++] = pkScene->fps;
 
+        /* Write transition */
+        *(uint8_t*)&pBuffer[buffOffset++] = pkScene->transition;
+        *(uint16_t*)&pBuffer[buffOffset] = pkScene->transitionMs;
+        buffOffset += sizeof(uint16_t);
+
+        /* Write the links parameters, in the links order */
+        for(const SSceneLink& krLink : pkScene->links)
+        {
+            *(uint8_t*)&pBuffer[buffOffset++] = krLink.params.brightness;
+            *(uint8_t*)&pBuffer[buffOffset++] = krLink.params.flags;
+            *(uint16_t*)&pBuffer[buffOffset] = krLink.params.speed;
+            buffOffset += sizeof(uint16_t);
+            *(uint16_t*)&pBuffer[buffOffset] = krLink.params.phase;
             buffOffset += sizeof(uint16_t);
         }
     }
 
-    std::shared_ptr<SScene> DeserializeScene(const uint8_t* pBuffer) const
+    public:
+    /* Returns nullptr if the buffer is shorter than its declared content */
+    static std::shared_ptr<SScene> DeserializeScene(const uint8_t* pBuffer,
+                                                    const size_t kSize)
     {
-        size_t   buffOffset;
-        size_t   sizeProp;
-        uint8_t  stripId;
-        uint16_t patternId;
+        size_t      buffOffset;
+        size_t      sizeProp;
+        SSceneLink  link;
 
+        std::vector<SSceneLink> links;
         std::shared_ptr<SScene> scenePtr;
 
-        scenePtr = std::make_shared<SScene>();
-
         buffOffset = 0;
 
         /* Get name size and name */
+        if(kSize < sizeof(uint8_t))
+        {
+            LOG_ERROR("Scene buffer too small\n");
+            return nullptr;
+        }
         sizeProp = *(uint8_t*)&pBuffer[buffOffset++];
+        if(buffOffset + sizeProp + sizeof(uint8_t) > kSize)
+        {
+            LOG_ERROR("Scene buffer too small\n");
+            return nullptr;
+        }
 
+        scenePtr = std::make_shared<SScene>();
         scenePtr->name = std::string(&pBuffer[buffOffset],
                                      &pBuffer[buffOffset] + sizeProp);
         buffOffset += sizeProp;
 
+        /* The scene settings keep their default values when they are not
+         * sent, as by the older applications.
+         */
+        scenePtr->fps          = 0;
+        scenePtr->transition   = LED_TRANSITION_CUT;
+        scenePtr->transitionMs = 0;
+
         /* Get nb links and for each, all them */
         sizeProp = *(uint8_t*)&pBuffer[buffOffset++];
+        if(buffOffset + sizeProp * BLE_SCENE_LINK_SIZE > kSize)
+        {
+            LOG_ERROR("Scene buffer too small for %d links\n", sizeProp);
+            return nullptr;
+        }
+        links.reserve(sizeProp);
         while(sizeProp > 0)
         {
-            stripId   = *(uint8_t*)&pBuffer[buffOffset++];
-            patternId = *(uint16_t*)&pBuffer[buffOffset];
+            link.stripId   = *(uint8_t*)&pBuffer[buffOffset++];
+            link.patternId = *(uint16_t*)&pBuffer[buffOffset];
             buffOffset += sizeof(uint16_t);
 
-            scenePtr->links.emplace(stripId, patternId);
+            links.push_back(link);
+            scenePtr->links.Set(link.stripId, link.patternId);
 
             --sizeProp;
         }
 
+        /* Get frame rate, optional */
+        if(buffOffset + sizeof(uint8_t) > kSize)
+        {
+            return scenePtr;
+        }
+        scenePtr->fps = *(uint8_t*)&pBuffer[buffOffset++];
+
+        /* Get transition, optional */
+        if(buffOffset + sizeof(uint8_t) + sizeof(uint16_t) > kSize)
+        {
+            return scenePtr;
+        }
+        scenePtr->transition   = *(uint8_t*)&pBuffer[buffOffset++];
+        scenePtr->transitionMs = *(uint16_t*)&pBuffer[buffOffset];
+        buffOffset += sizeof(uint16_t);
+
+        /* Get the links parameters in the order the links were sent,
+         * optional.
+         */
+        if(buffOffset + links.size() * LINK_PARAMS_SIZE > kSize)
+        {
+            return scenePtr;
+        }
+        for(SSceneLink& rLink : links)
+        {
+            rLink.params.brightness = *(uint8_t*)&pBuffer[buffOffset++];
+            rLink.params.flags      = *(uint8_t*)&pBuffer[buffOffset++];
+            rLink.params.speed      = *(uint16_t*)&pBuffer[buffOffset];
+            buffOffset += sizeof(uint16_t);
+            rLink.params.phase      = *(uint16_t*)&pBuffer[buffOffset];
+            buffOffset += sizeof(uint16_t);
+
+            scenePtr->links.Set(rLink.stripId, rLink.patternId, rLink.params);
+        }
+
         return scenePtr;
     }
 };
 
+class ManageBatchCallback: public BLECharacteristicCallbacks
+{
+    void onWrite(BLECharacteristic* pManageBatchCharacteristic)
+    {
+        uint8_t*       data;
+        size_t         length;
+        size_t         offset;
+        uint16_t       cmdSize;
+        uint8_t        cmdCount;
+        uint8_t        i;
+        uint16_t*      pResults;
+        BLEManager*    pBle;
+        StripsManager* pStripManager;
+
+        pBle          = BLEManager::GetInstance();
+        pStripManager = StripsManager::GetInstance();
+
+        length = pManageBatchCharacteristic->getLength();
+        data   = pManageBatchCharacteristic->getData();
+        if(length < BLE_TOCKEN_SIZE + sizeof(uint8_t))
+        {
+            LOG_ERROR("Incorrect data length in batch callback.\n");
+            return;
+        }
+        if(pBle->ValidateToken((char*)data) == false)
+        {
+            LOG_ERROR("Invalid BLE Token\n");
+            return;
+        }
+
+        cmdCount = data[BLE_TOCKEN_SIZE];
+        offset   = BLE_TOCKEN_SIZE + sizeof(uint8_t);
+        pResults = new uint16_t[cmdCount + 1];
+
+        /* All the commands are rendered and saved once */
+        pStripManager->BeginBatch();
+        for(i = 0; i < cmdCount; ++i)
+        {
+            if(offset + BLE_BATCH_CMD_HEADER_SIZE > length)
+            {
+                break;
+            }
+            cmdSize = *(uint16_t*)&data[offset + 2 * sizeof(uint8_t)];
+            if(offset + BLE_BATCH_CMD_HEADER_SIZE + cmdSize > length)
+            {
+                break;
+            }
+
+            pResults[i + 1] = ExecuteCommand(data[offset],
+                                             data[offset + sizeof(uint8_t)],
+                                             &data[offset +
+                                                   BLE_BATCH_CMD_HEADER_SIZE],
+                                             cmdSize);
+
+            offset += BLE_BATCH_CMD_HEADER_SIZE + cmdSize;
+        }
+        pStripManager->CommitBatch();
+
+        if(i != cmdCount)
+        {
+            LOG_ERROR("Truncated batch, executed %d of %d commands\n",
+                      i,
+                      cmdCount);
+        }
+
+        /* Set the number of executed commands and their results */
+        pResults[0] = i;
+        pManageBatchCharacteristic->setValue((uint8_t*)pResults,
+                                             sizeof(uint16_t) * (i + 1));
+
+        delete[] pResults;
+    }
+
+    uint16_t ExecuteCommand(const uint8_t  kTarget,
+                            const uint8_t  kCommand,
+                            const uint8_t* kpData,
+                            const uint16_t kSize) const
+    {
+        StripsManager*           pStripManager;
+        std::shared_ptr<Pattern> newPattern;
+        std::shared_ptr<SScene>  newScene;
+
+        pStripManager = StripsManager::GetInstance();
+
+        if(kTarget == BLE_BATCH_TARGET_PATTERN)
+        {
+            switch(kCommand)
+            {
+                case BLE_CMD_PATTERN_MGT_ADD:
+                    newPattern = ManagePatternsCallback::DeserializePattern(
+                                                                    kpData,
+                                                                    kSize,
+                                                                    false);
+                    if(newPattern == nullptr)
+                    {
+                        return BLE_BATCH_ERROR;
+                    }
+                    return pStripManager->AddPattern(newPattern);
+                case BLE_CMD_PATTERN_MGT_REM:
+                    if(kSize < sizeof(uint16_t))
+                    {
+                        return BLE_BATCH_ERROR;
+                    }
+                    return pStripManager->RemovePattern(*(uint16_t*)kpData);
+                case BLE_CMD_PATTERN_MGT_UPD:
+                    newPattern = ManagePatternsCallback::DeserializePattern(
+                                                                    kpData,
+                                                                    kSize,
+                                                                    true);
+                    if(newPattern == nullptr)
+                    {
+                        return BLE_BATCH_ERROR;
+                    }
+                    return pStripManager->UpdatePattern(newPattern);
+                default:
+                    break;
+            }
+        }
+        else if(kTarget == BLE_BATCH_TARGET_SCENE)
+        {
+            switch(kCommand)
+            {
+                case BLE_CMD_SCENE_MGT_ADD:
+                    newScene = ManageSceneCallback::DeserializeScene(kpData,
+                                                                     kSize);
+                    if(newScene == nullptr)
+                    {
+                        return BLE_BATCH_ERROR;
+                    }
+                    return pStripManager->AddScene(newScene);
+                case BLE_CMD_SCENE_MGT_REM:
+                    if(kSize < sizeof(uint8_t))
+                    {
+                        return BLE_BATCH_ERROR;
+                    }
+                    return pStripManager->RemoveScene(*kpData);
+                case BLE_CMD_SCENE_MGT_UPD:
+                    if(kSize < sizeof(uint8_t) ||
+                       *kpData >= pStripManager->GetSceneCount())
+                    {
+                        LOG_ERROR("Invalid scene update in batch\n");
+                        return BLE_BATCH_ERROR;
+                    }
+                    newScene = ManageSceneCallback::DeserializeScene(
+                                                    kpData + sizeof(uint8_t),
+                                                    kSize - sizeof(uint8_t));
+                    if(newScene == nullptr)
+                    {
+                        return BLE_BATCH_ERROR;
+                    }
+                    return pStripManager->UpdateScene(*kpData, newScene);
+                default:
+                    break;
+            }
+        }
+
+        LOG_ERROR("Unknown batch command %d for target %d\n",
+                  kCommand,
+                  kTarget);
+
+        return BLE_BATCH_ERROR;
+    }
+};
+
 class SetSceneCallback: public BLECharacteristicCallbacks
 {
     void onWrite(BLECharacteristic* pSetSceneCharacteristic)
@@ -714,6 +1097,71 @@ class SetSceneCallback: public BLECharacteristicCallbacks
     }
 };
 
+class SetStripsCallback: public BLECharacteristicCallbacks
+{
+    void onWrite(BLECharacteristic* pSetStripsCharacteristic)
+    {
+        uint8_t                   value;
+        uint8_t*                  data;
+        size_t                    size;
+        size_t                    offset;
+        uint8_t                   stripCount;
+        uint8_t                   i;
+        SStripConfig              strip;
+        std::vector<SStripConfig> strips;
+        BLEManager*               pBle;
+
+        pBle  = BLEManager::GetInstance();
+        value = 0;
+
+        size = pSetStripsCharacteristic->getLength();
+        data = pSetStripsCharacteristic->getData();
+        if(size < BLE_TOCKEN_SIZE + sizeof(uint8_t))
+        {
+            LOG_ERROR("Incorrect data length in set strips callback.\n");
+            pSetStripsCharacteristic->setValue(&value, 1);
+            return;
+        }
+        if(pBle->ValidateToken((char*)data) == false)
+        {
+            LOG_ERROR("Invalid BLE Token\n");
+            pSetStripsCharacteristic->setValue(&value, 1);
+            return;
+        }
+
+        stripCount = data[BLE_TOCKEN_SIZE];
+        offset     = BLE_TOCKEN_SIZE + sizeof(uint8_t);
+        for(i = 0; i < stripCount; ++i)
+        {
+            if(offset + BLE_STRIP_SIZE > size ||
+               offset + BLE_STRIP_SIZE + data[offset + 5] > size)
+            {
+                LOG_ERROR("Truncated strips layout\n");
+                pSetStripsCharacteristic->setValue(&value, 1);
+                return;
+            }
+
+            strip.ctrlGPIO   = (gpio_num_t)data[offset];
+            strip.mosfetGPIO = (gpio_num_t)data[offset + 1];
+            strip.numLed     = data[offset + 2] | (data[offset + 3] << 8);
+            strip.isIndexed  = (data[offset + 4] == BLE_STRIP_MODE_INDEXED);
+            strip.name       = std::string((char*)&data[offset +
+                                                        BLE_STRIP_SIZE],
+                                           data[offset + 5]);
+            strips.push_back(strip);
+
+            offset += BLE_STRIP_SIZE + data[offset + 5];
+        }
+
+        /* Validated as on boot, applied on the next boot */
+        if(StripsManager::GetInstance()->SaveStripsLayout(strips) == true)
+        {
+            value = 1;
+        }
+        pSetStripsCharacteristic->setValue(&value, 1);
+    }
+};
+
 class ServerCallback: public BLEServerCallbacks
 {
     void onDisconnect(BLEServer* pServer)
@@ -778,6 +1226,31 @@ void BLEManager::Update(void)
     pCharacteristicBattery_->setValue(&batteryPercent, sizeof(uint8_t));
 }
 
+void BLEManager::UpdateRoutine(void* pObjThis)
+{
+    uint64_t     startTime;
+    TickType_t   lastWakeTime;
+    BLEManager*  pManager;
+    TaskMonitor* pMonitor;
+
+    pManager = (BLEManager*)pObjThis;
+    pMonitor = TaskMonitor::GetInstance();
+
+    lastWakeTime = xTaskGetTickCount();
+    while(1)
+    {
+        startTime = HWLayer::GetTime();
+
+        pManager->Update();
+
+        pMonitor->ReportPeriod(TASK_BLE,
+                               HWLayer::GetTime() - startTime >
+                               BLE_UPDATE_PERIOD_MS * 1000);
+
+        vTaskDelayUntil(&lastWakeTime, pdMS_TO_TICKS(BLE_UPDATE_PERIOD_MS));
+    }
+}
+
 bool BLEManager::ValidateToken(const char* kpToken) const
 {
     if(isInit_)
@@ -791,7 +1264,8 @@ bool BLEManager::ValidateToken(const char* kpToken) const
 
 BLEManager::BLEManager(void)
 {
-    isInit_ = false;
+    isInit_       = false;
+    updateThread_ = nullptr;
     Init();
 }
 
@@ -888,6 +1362,16 @@ void BLEManager::Init(void)
     pCharacteristicManageScenes_->setValue(&value, sizeof(uint8_t));
     pCharacteristicManageScenes_->setCallbacks(new ManageSceneCallback());
 
+    /* Setup the BATCH characteristic */
+    pCharacteristicManageBatch_ = pMainService_->createCharacteristic(
+                                            MANAGE_BATCH_CHARACTERISTIC_UUID,
+                                            BLECharacteristic::PROPERTY_READ |
+                                            BLECharacteristic::PROPERTY_WRITE
+                                        );
+    value = 0;
+    pCharacteristicManageBatch_->setValue(&value, sizeof(uint8_t));
+    pCharacteristicManageBatch_->setCallbacks(new ManageBatchCallback());
+
     pCharacteristicSetScene_ = pMainService_->createCharacteristic(
                                             SET_SCENE_CHARACTERISTIC_UUID,
                                             BLECharacteristic::PROPERTY_READ |
@@ -897,6 +1381,16 @@ void BLEManager::Init(void)
     value = pStripManager->GetSelectedScene();
     pCharacteristicSetScene_->setValue(&value, sizeof(uint8_t));
 
+    /* Setup the STRIPS layout characteristic */
+    pCharacteristicSetStrips_ = pMainService_->createCharacteristic(
+                                            SET_STRIPS_CHARACTERISTIC_UUID,
+                                            BLECharacteristic::PROPERTY_READ |
+                                            BLECharacteristic::PROPERTY_WRITE
+                                        );
+    value = 0;
+    pCharacteristicSetStrips_->setValue(&value, sizeof(uint8_t));
+    pCharacteristicSetStrips_->setCallbacks(new SetStripsCallback());
+
     /* Start the services */
     pMainService_->start();
 
@@ -910,6 +1404,11 @@ void BLEManager::Init(void)
 
     isInit_ = true;
 
+    /* The characteristics values are updated by the BLE task */
+    updateThread_ = TaskMonitor::GetInstance()->CreateTask(TASK_BLE,
+                                                           UpdateRoutine,
+                                                           this);
+
     LOG_INFO("BLE Manager Initialized.\n");
 }
 
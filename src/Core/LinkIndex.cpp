@@ -0,0 +1,185 @@
+/*******************************************************************************
+ * @file LinkIndex.cpp
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief Pattern links reverse index.
+ *
+ * @details This file provides the reverse index of the scene links.
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include <cstdint> /* Standard Int Types */
+#include <vector>  /* std::vector */
+#include <SceneLinks.h> /* Scene links container */
+
+/* Header File */
+#include <LinkIndex.h>
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * STRUCTURES AND TYPES
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/************************* Imported global variables **************************/
+/* None */
+
+/************************* Exported global variables **************************/
+/* None */
+
+/************************** Static global variables ***************************/
+const std::vector<SPatternUse> LinkIndex::NO_USE_;
+
+/*******************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * CLASS METHODS
+ ******************************************************************************/
+
+void LinkIndex::AddScene(const uint8_t kSceneIdx, const SceneLinks& krLinks)
+{
+    for(const SSceneLink& krLink : krLinks)
+    {
+        if(krLink.patternId >= uses_.size())
+        {
+            uses_.resize(krLink.patternId + 1);
+        }
+        uses_[krLink.patternId].push_back({
+            .sceneIdx = kSceneIdx,
+            .stripId  = krLink.stripId
+        });
+    }
+}
+
+void LinkIndex::RemoveScene(const uint8_t kSceneIdx, const SceneLinks& krLinks)
+{
+    for(const SSceneLink& krLink : krLinks)
+    {
+        RemoveLink(kSceneIdx, krLink.stripId, krLink.patternId);
+    }
+}
+
+void LinkIndex::ShiftScenes(const uint8_t kSceneIdx)
+{
+    /* Visits all the uses, only done when a scene is erased */
+    for(std::vector<SPatternUse>& rUses : uses_)
+    {
+        for(SPatternUse& rUse : rUses)
+        {
+            if(rUse.sceneIdx > kSceneIdx)
+            {
+                --rUse.sceneIdx;
+            }
+        }
+    }
+}
+
+void LinkIndex::RemoveLink(const uint8_t  kSceneIdx,
+                           const uint8_t  kStripId,
+                           const uint16_t kPatternId)
+{
+    size_t i;
+
+    if(kPatternId >= uses_.size())
+    {
+        return;
+    }
+
+    std::vector<SPatternUse>& rUses = uses_[kPatternId];
+    for(i = 0; i < rUses.size(); ++i)
+    {
+        if(rUses[i].sceneIdx == kSceneIdx && rUses[i].stripId == kStripId)
+        {
+            /* The uses are not ordered */
+            rUses[i] = rUses.back();
+            rUses.pop_back();
+            return;
+        }
+    }
+}
+
+void LinkIndex::RemovePattern(const uint16_t kPatternId)
+{
+    if(kPatternId < uses_.size())
+    {
+        std::vector<SPatternUse>().swap(uses_[kPatternId]);
+    }
+}
+
+const std::vector<SPatternUse>& LinkIndex::GetUses(
+                                            const uint16_t kPatternId) const
+{
+    if(kPatternId >= uses_.size())
+    {
+        return NO_USE_;
+    }
+
+    return uses_[kPatternId];
+}
+
+bool LinkIndex::IsUsedBy(const uint16_t kPatternId,
+                         const uint8_t  kSceneIdx) const
+{
+    for(const SPatternUse& krUse : GetUses(kPatternId))
+    {
+        if(krUse.sceneIdx == kSceneIdx)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void LinkIndex::Clear(void)
+{
+    uses_.clear();
+}
+
+size_t LinkIndex::GetHeapSize(void) const
+{
+    size_t size;
+
+    size = uses_.capacity() * sizeof(std::vector<SPatternUse>);
+    for(const std::vector<SPatternUse>& krUses : uses_)
+    {
+        size += krUses.capacity() * sizeof(SPatternUse);
+    }
+
+    return size;
+}
@@ -17,9 +17,10 @@
 /*******************************************************************************
  * INCLUDES
  ******************************************************************************/
-#include <cstdint>    /* Standard Int Types */
-#include <Logger.h> /* Logger services */
-#include <string>  /* std::string */
+#include <cstdint>        /* Standard Int Types */
+#include <Logger.h>       /* Logger services */
+#include <string>         /* std::string */
+#include <PatternImage.h> /* Pattern stored image */
 
 /* Header File */
 #include <Pattern.h>
@@ -93,6 +94,21 @@ void Pattern::SetBrightness(const uint8_t kBrightness)
     brightness_ = kBrightness;
 }
 
+void Pattern::SetPalette(const std::vector<uint32_t>& krPalette)
+{
+    if(krPalette.size() > PATTERN_PALETTE_MAX)
+    {
+        LOG_ERROR("Palette size too big, truncating to %d\n",
+                  PATTERN_PALETTE_MAX);
+        palette_.assign(krPalette.begin(),
+                        krPalette.begin() + PATTERN_PALETTE_MAX);
+    }
+    else
+    {
+        palette_ = krPalette;
+    }
+}
+
 const std::vector<SAnimation>& Pattern::GetAnimations(void) const
 {
     return animations_;
@@ -108,6 +124,86 @@ uint8_t Pattern::GetBrightness(void) const
     return brightness_;
 }
 
+const std::vector<uint32_t>& Pattern::GetPalette(void) const
+{
+    return palette_;
+}
+
+bool Pattern::IsIndexed(void) const
+{
+    if(IsPacked() == true)
+    {
+        return PatternImage(image_.data(), image_.size()).IsIndexed();
+    }
+    return palette_.size() != 0;
+}
+
+bool Pattern::Pack(void)
+{
+    size_t               imageSize;
+    std::vector<uint8_t> image;
+
+    if(IsPacked() == true)
+    {
+        return true;
+    }
+
+    imageSize = PatternImage::GetImageSize(*this);
+    if(imageSize == 0)
+    {
+        LOG_ERROR("Pattern %d cannot be packed\n", identifier_);
+        return false;
+    }
+
+    /* Written aside, the pattern is unpacked until the image is complete */
+    image.resize(imageSize);
+    PatternImage::Write(*this, image.data(), imageSize);
+    image_.swap(image);
+
+    /* Release the buffers, the image replaces them */
+    std::vector<SAnimation>().swap(animations_);
+    std::vector<SColor>().swap(colors_);
+    std::vector<uint32_t>().swap(palette_);
+
+    return true;
+}
+
+bool Pattern::LoadImage(const uint8_t* kpImage, const size_t kSize)
+{
+    PatternImage image(kpImage, kSize);
+
+    if(image.IsValid() == false)
+    {
+        return false;
+    }
+
+    identifier_ = image.GetId();
+    name_.assign(image.GetName(), image.GetNameSize());
+    brightness_ = image.GetBrightness();
+    image_.assign(kpImage, kpImage + image.GetSize());
+
+    std::vector<SAnimation>().swap(animations_);
+    std::vector<SColor>().swap(colors_);
+    std::vector<uint32_t>().swap(palette_);
+
+    return true;
+}
+
+bool Pattern::IsPacked(void) const
+{
+    return image_.size() != 0;
+}
+
+const uint8_t* Pattern::GetImage(void) const
+{
+    return image_.data();
+}
+
+size_t Pattern::GetImageSize(void) const
+{
+    return image_.size();
+}
+
 uint16_t Pattern::GetId(void) const
 {
     return identifier_;
@@ -121,4 +217,28 @@ const std::string& Pattern::GetName(void) const
 void Pattern::ForceId(const uint16_t kNewId)
 {
     identifier_ = kNewId;
-}
\ No newline at end of file
+    if(IsPacked() == true)
+    {
+        PatternImage::WriteId(image_.data(), kNewId);
+    }
+}
+
+size_t Pattern::GetHeapSize(void) const
+{
+    size_t size;
+
+    size = sizeof(Pattern) +
+           animations_.capacity() * sizeof(SAnimation) +
+           colors_.capacity() * sizeof(SColor) +
+           palette_.capacity() * sizeof(uint32_t) +
+           image_.capacity();
+
+    /* Short names are stored in the string object itself */
+    if(name_.data() < (const char*)this ||
+       name_.data() >= (const char*)(this + 1))
+    {
+        size += name_.capacity() + 1;
+    }
+
+    return size;
+}
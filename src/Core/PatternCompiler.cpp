@@ -0,0 +1,727 @@
+/*******************************************************************************
+ * @file PatternCompiler.cpp
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief LED strip pattern compiler.
+ *
+ * @details This file provides the pattern compiler and the kernels referenced
+ * by the compiled programs. The trail kernels also rotate palette ranges for
+ * the palette cycle animations.
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include <cstdint>        /* Standard Int Types */
+#include <cstring>        /* memcpy */
+#include <algorithm>      /* std::sort, std::min, std::max */
+#include <Logger.h>       /* Logger services */
+#include <ColorKernels.h> /* Color rendering kernels */
+
+/* Header File */
+#include <PatternCompiler.h>
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+#define PIXEL_OFFSET(IDX) ((size_t)(IDX) * COLOR_KERNELS_PIXEL_SIZE)
+
+/*******************************************************************************
+ * STRUCTURES AND TYPES
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/************************* Imported global variables **************************/
+/* None */
+
+/************************* Exported global variables **************************/
+/* None */
+
+/************************** Static global variables ***************************/
+/* None */
+
+/*******************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ ******************************************************************************/
+
+static void KernelFill(uint8_t* pFrame, const SColorOp& krOp);
+static void KernelGradient(uint8_t* pFrame, const SColorOp& krOp);
+static void KernelIndexFill(uint8_t* pFrame, const SColorOp& krOp);
+static void KernelIndexRamp(uint8_t* pFrame, const SColorOp& krOp);
+static void Rotate(uint8_t*       pFrame,
+                   const uint8_t* kpBase,
+                   const SAnimOp& krOp,
+                   const uint32_t kStep,
+                   const size_t   kPixelSize);
+static void KernelTrail(uint8_t*       pFrame,
+                        const uint8_t* kpBase,
+                        const SAnimOp& krOp,
+                        const uint32_t kStep);
+static void KernelTrailReverse(uint8_t*       pFrame,
+                               const uint8_t* kpBase,
+                               const SAnimOp& krOp,
+                               const uint32_t kStep);
+static void KernelIndexTrail(uint8_t*       pFrame,
+                             const uint8_t* kpBase,
+                             const SAnimOp& krOp,
+                             const uint32_t kStep);
+static void KernelIndexTrailReverse(uint8_t*       pFrame,
+                                    const uint8_t* kpBase,
+                                    const SAnimOp& krOp,
+                                    const uint32_t kStep);
+static void KernelBreath(uint8_t*       pFrame,
+                         const uint8_t* kpBase,
+                         const SAnimOp& krOp,
+                         const uint32_t kStep);
+static uint32_t LerpColor(const uint32_t kStartColorCode,
+                          const uint32_t kEndColorCode,
+                          const uint32_t kNum,
+                          const uint32_t kDen);
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+static void KernelFill(uint8_t* pFrame, const SColorOp& krOp)
+{
+    ColorKernels::Fill(pFrame + PIXEL_OFFSET(krOp.startIdx),
+                       krOp.count,
+                       krOp.startColorCode);
+}
+
+static void KernelGradient(uint8_t* pFrame, const SColorOp& krOp)
+{
+    ColorKernels::Gradient(pFrame + PIXEL_OFFSET(krOp.startIdx),
+                           krOp.count,
+                           krOp.startColorCode,
+                           krOp.endColorCode);
+}
+
+static void KernelIndexFill(uint8_t* pFrame, const SColorOp& krOp)
+{
+    memset(pFrame + krOp.startIdx, (uint8_t)krOp.startColorCode, krOp.count);
+}
+
+static void KernelIndexRamp(uint8_t* pFrame, const SColorOp& krOp)
+{
+    uint32_t i;
+    int32_t  acc;
+    int32_t  step;
+    int32_t  steps;
+
+    if(krOp.count < 2)
+    {
+        KernelIndexFill(pFrame, krOp);
+        return;
+    }
+
+    /* Q16.16 interpolation of the indices */
+    steps = (int32_t)krOp.count - 1;
+    acc   = ((int32_t)krOp.startColorCode << 16) + 0x8000;
+    step  = (((int32_t)krOp.endColorCode - (int32_t)krOp.startColorCode) *
+             65536) / steps;
+
+    pFrame += krOp.startIdx;
+    for(i = 0; i < krOp.count; ++i)
+    {
+        pFrame[i] = (uint8_t)(acc >> 16);
+        acc += step;
+    }
+}
+
+static void Rotate(uint8_t*       pFrame,
+                   const uint8_t* kpBase,
+                   const SAnimOp& krOp,
+                   const uint32_t kStep,
+                   const size_t   kPixelSize)
+{
+    /* Rotate the base segment by the step */
+    memcpy(pFrame + (krOp.lowIdx * kPixelSize),
+           kpBase + ((krOp.lowIdx + kStep) * kPixelSize),
+           (krOp.length - kStep) * kPixelSize);
+    memcpy(pFrame + ((krOp.lowIdx + krOp.length - kStep) * kPixelSize),
+           kpBase + (krOp.lowIdx * kPixelSize),
+           kStep * kPixelSize);
+}
+
+static void KernelTrail(uint8_t*       pFrame,
+                        const uint8_t* kpBase,
+                        const SAnimOp& krOp,
+                        const uint32_t kStep)
+{
+    Rotate(pFrame, kpBase, krOp, kStep, COLOR_KERNELS_PIXEL_SIZE);
+}
+
+static void KernelTrailReverse(uint8_t*       pFrame,
+                               const uint8_t* kpBase,
+                               const SAnimOp& krOp,
+                               const uint32_t kStep)
+{
+    Rotate(pFrame,
+           kpBase,
+           krOp,
+           (kStep == 0) ? 0 : krOp.length - kStep,
+           COLOR_KERNELS_PIXEL_SIZE);
+}
+
+static void KernelIndexTrail(uint8_t*       pFrame,
+                             const uint8_t* kpBase,
+                             const SAnimOp& krOp,
+                             const uint32_t kStep)
+{
+    Rotate(pFrame, kpBase, krOp, kStep, sizeof(uint8_t));
+}
+
+static void KernelIndexTrailReverse(uint8_t*       pFrame,
+                                    const uint8_t* kpBase,
+                                    const SAnimOp& krOp,
+                                    const uint32_t kStep)
+{
+    Rotate(pFrame,
+           kpBase,
+           krOp,
+           (kStep == 0) ? 0 : krOp.length - kStep,
+           sizeof(uint8_t));
+}
+
+static void KernelBreath(uint8_t*       pFrame,
+                         const uint8_t* kpBase,
+                         const SAnimOp& krOp,
+                         const uint32_t kStep)
+{
+    uint32_t level;
+
+    /* The breath scales the frame in place */
+    (void)kpBase;
+
+    /* Triangle from the pattern brightness down to 0 and back */
+    if(kStep <= krOp.level)
+    {
+        level = krOp.level - kStep;
+    }
+    else
+    {
+        level = kStep - krOp.level;
+    }
+
+    ColorKernels::Scale(pFrame + PIXEL_OFFSET(krOp.lowIdx),
+                        pFrame + PIXEL_OFFSET(krOp.lowIdx),
+                        krOp.length,
+                        (uint8_t)(level * 255U / krOp.level));
+}
+
+static uint32_t LerpColor(const uint32_t kStartColorCode,
+                          const uint32_t kEndColorCode,
+                          const uint32_t kNum,
+                          const uint32_t kDen)
+{
+    uint32_t colorCode;
+    uint8_t  shift;
+    int32_t  start;
+    int32_t  end;
+
+    colorCode = 0;
+    for(shift = 0; shift <= 16; shift += 8)
+    {
+        start = (int32_t)((kStartColorCode >> shift) & 0xFF);
+        end   = (int32_t)((kEndColorCode >> shift) & 0xFF);
+        colorCode |= (uint32_t)(start + (end - start) * (int32_t)kNum /
+                                (int32_t)kDen) << shift;
+    }
+
+    return colorCode;
+}
+
+/*******************************************************************************
+ * CLASS METHODS
+ ******************************************************************************/
+
+bool PatternCompiler::Validate(const Pattern& krPattern)
+{
+    size_t i;
+    size_t j;
+    size_t paletteSize;
+
+    if(krPattern.IsPacked() == true)
+    {
+        return Validate(PatternImage(krPattern.GetImage(),
+                                     krPattern.GetImageSize()));
+    }
+
+    paletteSize = krPattern.GetPalette().size();
+
+    const std::vector<SAnimation>& krAnims = krPattern.GetAnimations();
+    for(i = 0; i < krAnims.size(); ++i)
+    {
+        if(ValidateAnimation(krAnims[i],
+                             paletteSize,
+                             krPattern.GetId()) == false)
+        {
+            return false;
+        }
+        for(j = 0; j < i; ++j)
+        {
+            if(ValidateTrails(krAnims[i],
+                              krAnims[j],
+                              krPattern.GetId()) == false)
+            {
+                return false;
+            }
+        }
+    }
+    for(const SColor& krColor : krPattern.GetColors())
+    {
+        if(ValidateColor(krColor, paletteSize, krPattern.GetId()) == false)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool PatternCompiler::Validate(const PatternImage& krImage)
+{
+    size_t     i;
+    size_t     j;
+    size_t     paletteSize;
+    SAnimation anim;
+    SAnimation other;
+    SColor     color;
+
+    if(krImage.IsValid() == false)
+    {
+        return false;
+    }
+
+    paletteSize = krImage.GetPaletteSize();
+
+    for(i = 0; i < krImage.GetAnimationCount(); ++i)
+    {
+        krImage.GetAnimation(i, anim);
+        if(ValidateAnimation(anim, paletteSize, krImage.GetId()) == false)
+        {
+            return false;
+        }
+        for(j = 0; j < i; ++j)
+        {
+            krImage.GetAnimation(j, other);
+            if(ValidateTrails(anim, other, krImage.GetId()) == false)
+            {
+                return false;
+            }
+        }
+    }
+    for(i = 0; i < krImage.GetColorCount(); ++i)
+    {
+        krImage.GetColor(i, color);
+        if(ValidateColor(color, paletteSize, krImage.GetId()) == false)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool PatternCompiler::Compile(const Pattern&   krPattern,
+                              const uint16_t   kLedCount,
+                              SPatternProgram& rProgram)
+{
+    size_t               i;
+    std::vector<SAnimOp> paletteOps;
+    std::vector<SAnimOp> postScaleOps;
+
+    /* The patterns of the table are packed, read in place */
+    if(krPattern.IsPacked() == true)
+    {
+        return Compile(PatternImage(krPattern.GetImage(),
+                                    krPattern.GetImageSize()),
+                       kLedCount,
+                       rProgram);
+    }
+
+    if(Validate(krPattern) == false)
+    {
+        return false;
+    }
+
+    const std::vector<uint32_t>& krPalette = krPattern.GetPalette();
+
+    StartProgram(krPattern.GetBrightness(),
+                 krPalette.size(),
+                 kLedCount,
+                 rProgram);
+    for(i = 0; i < krPalette.size(); ++i)
+    {
+        ColorKernels::Fill(&rProgram.palette[PIXEL_OFFSET(i)], 1, krPalette[i]);
+    }
+
+    for(const SColor& krColor : krPattern.GetColors())
+    {
+        CompileColor(krColor, kLedCount, rProgram);
+    }
+
+    for(const SAnimation& krAnim : krPattern.GetAnimations())
+    {
+        CompileAnimation(krAnim, kLedCount, rProgram, paletteOps, postScaleOps);
+    }
+    EndProgram(paletteOps, postScaleOps, rProgram);
+
+    return true;
+}
+
+bool PatternCompiler::Compile(const PatternImage& krImage,
+                              const uint16_t      kLedCount,
+                              SPatternProgram&    rProgram)
+{
+    size_t               i;
+    SAnimation           anim;
+    SColor               color;
+    std::vector<SAnimOp> paletteOps;
+    std::vector<SAnimOp> postScaleOps;
+
+    if(Validate(krImage) == false)
+    {
+        return false;
+    }
+
+    /* The image fields are decoded one at a time, the image is not copied */
+    StartProgram(krImage.GetBrightness(),
+                 krImage.GetPaletteSize(),
+                 kLedCount,
+                 rProgram);
+    for(i = 0; i < krImage.GetPaletteSize(); ++i)
+    {
+        ColorKernels::Fill(&rProgram.palette[PIXEL_OFFSET(i)],
+                           1,
+                           krImage.GetPaletteColor(i));
+    }
+
+    for(i = 0; i < krImage.GetColorCount(); ++i)
+    {
+        krImage.GetColor(i, color);
+        CompileColor(color, kLedCount, rProgram);
+    }
+
+    for(i = 0; i < krImage.GetAnimationCount(); ++i)
+    {
+        krImage.GetAnimation(i, anim);
+        CompileAnimation(anim, kLedCount, rProgram, paletteOps, postScaleOps);
+    }
+    EndProgram(paletteOps, postScaleOps, rProgram);
+
+    return true;
+}
+
+void PatternCompiler::CopyBase(const SPatternProgram& krProgram,
+                               uint8_t*               pFrame,
+                               const uint8_t*         kpBase,
+                               const size_t           kPixelSize)
+{
+    for(const SFrameSpan& krSpan : krProgram.baseSpans)
+    {
+        memcpy(pFrame + krSpan.startIdx * kPixelSize,
+               kpBase + krSpan.startIdx * kPixelSize,
+               krSpan.count * kPixelSize);
+    }
+}
+
+bool PatternCompiler::ValidateAnimation(const SAnimation& krAnim,
+                                        const size_t      kPaletteSize,
+                                        const uint16_t    kPatternId)
+{
+    if(krAnim.type != ANIM_TRAIL &&
+       krAnim.type != ANIM_BREATH &&
+       (krAnim.type != ANIM_PALETTE_CYCLE || kPaletteSize == 0))
+    {
+        LOG_ERROR("Invalid animation ID %d in pattern %d\n",
+                  krAnim.type,
+                  kPatternId);
+        return false;
+    }
+
+    return true;
+}
+
+bool PatternCompiler::ValidateTrails(const SAnimation& krAnim,
+                                     const SAnimation& krOther,
+                                     const uint16_t    kPatternId)
+{
+    uint16_t lowIdx;
+    uint16_t highIdx;
+    uint16_t otherLowIdx;
+    uint16_t otherHighIdx;
+
+    /* The trails of a frame all read the base, two trails on the same LEDs
+     * would not combine.
+     */
+    if(krAnim.type != krOther.type ||
+       (krAnim.type != ANIM_TRAIL && krAnim.type != ANIM_PALETTE_CYCLE))
+    {
+        return true;
+    }
+
+    lowIdx       = std::min(krAnim.startIdx, krAnim.endIdx);
+    highIdx      = std::max(krAnim.startIdx, krAnim.endIdx);
+    otherLowIdx  = std::min(krOther.startIdx, krOther.endIdx);
+    otherHighIdx = std::max(krOther.startIdx, krOther.endIdx);
+    if(lowIdx <= otherHighIdx && otherLowIdx <= highIdx)
+    {
+        LOG_ERROR("Overlapping trails in pattern %d\n", kPatternId);
+        return false;
+    }
+
+    return true;
+}
+
+bool PatternCompiler::ValidateColor(const SColor&  krColor,
+                                    const size_t   kPaletteSize,
+                                    const uint16_t kPatternId)
+{
+    /* Indexed colors must exist in the palette */
+    if(kPaletteSize != 0 &&
+       (krColor.startColorCode >= kPaletteSize ||
+        krColor.endColorCode >= kPaletteSize))
+    {
+        LOG_ERROR("Invalid palette index in pattern %d\n", kPatternId);
+        return false;
+    }
+
+    return true;
+}
+
+void PatternCompiler::StartProgram(const uint8_t    kBrightness,
+                                   const uint16_t   kPaletteSize,
+                                   const uint16_t   kLedCount,
+                                   SPatternProgram& rProgram)
+{
+    rProgram.ledCount   = kLedCount;
+    rProgram.brightness = kBrightness;
+    rProgram.isIndexed  = (kPaletteSize != 0);
+    rProgram.colorOps.clear();
+    rProgram.animOps.clear();
+
+    /* The palette is packed as the output pixels */
+    rProgram.palette.resize(kPaletteSize * COLOR_KERNELS_PIXEL_SIZE);
+}
+
+void PatternCompiler::CompileAnimation(const SAnimation&     krAnim,
+                                       const uint16_t        kLedCount,
+                                       SPatternProgram&      rProgram,
+                                       std::vector<SAnimOp>& rPaletteOps,
+                                       std::vector<SAnimOp>& rPostScaleOps)
+{
+    SAnimOp  op;
+    uint16_t paletteSize;
+
+    paletteSize = rProgram.palette.size() / COLOR_KERNELS_PIXEL_SIZE;
+
+    /* The trails move the unscaled frame, the palette cycles move the
+     * unscaled palette and the breaths scale the output after the pattern
+     * brightness is applied.
+     */
+    op.level = rProgram.brightness;
+    op.rate  = ((uint64_t)krAnim.param << (32 - ANIM_SPEED_FRAC_BITS)) /
+               ANIM_SPEED_PERIOD_US;
+
+    switch(krAnim.type)
+    {
+        case ANIM_TRAIL:
+            if(ClipAnimation(krAnim, kLedCount, op) == true)
+            {
+                op.period = op.length;
+                if(rProgram.isIndexed == true)
+                {
+                    op.pKernel = (krAnim.startIdx > krAnim.endIdx) ?
+                                 KernelIndexTrailReverse :
+                                 KernelIndexTrail;
+                }
+                else
+                {
+                    op.pKernel = (krAnim.startIdx > krAnim.endIdx) ?
+                                 KernelTrailReverse :
+                                 KernelTrail;
+                }
+                rProgram.animOps.push_back(op);
+            }
+            break;
+        case ANIM_PALETTE_CYCLE:
+            if(ClipAnimation(krAnim, paletteSize, op) == true)
+            {
+                op.period  = op.length;
+                op.pKernel = (krAnim.startIdx > krAnim.endIdx) ?
+                             KernelTrailReverse :
+                             KernelTrail;
+                rPaletteOps.push_back(op);
+            }
+            break;
+        case ANIM_BREATH:
+            /* A breath on a black pattern has no effect */
+            if(rProgram.brightness != 0 &&
+               ClipAnimation(krAnim,
+                             rProgram.isIndexed ? paletteSize : kLedCount,
+                             op) == true)
+            {
+                op.period  = 2 * (uint32_t)rProgram.brightness;
+                op.pKernel = KernelBreath;
+                rPostScaleOps.push_back(op);
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+void PatternCompiler::EndProgram(const std::vector<SAnimOp>& krPaletteOps,
+                                 const std::vector<SAnimOp>& krPostScaleOps,
+                                 SPatternProgram&            rProgram)
+{
+    std::vector<SAnimOp> trails;
+    uint16_t             startIdx;
+
+    /* The trails ranges are disjoint, the base spans are the gaps between
+     * them.
+     */
+    trails = rProgram.animOps;
+    std::sort(trails.begin(),
+              trails.end(),
+              [](const SAnimOp& krFirst, const SAnimOp& krSecond)
+              {
+                  return krFirst.lowIdx < krSecond.lowIdx;
+              });
+    rProgram.baseSpans.clear();
+    startIdx = 0;
+    for(const SAnimOp& krTrail : trails)
+    {
+        if(krTrail.lowIdx > startIdx)
+        {
+            rProgram.baseSpans.push_back({
+                .startIdx = startIdx,
+                .count    = (uint16_t)(krTrail.lowIdx - startIdx)
+            });
+        }
+        startIdx = krTrail.lowIdx + krTrail.length;
+    }
+    if(startIdx < rProgram.ledCount)
+    {
+        rProgram.baseSpans.push_back({
+            .startIdx = startIdx,
+            .count    = (uint16_t)(rProgram.ledCount - startIdx)
+        });
+    }
+
+    rProgram.paletteIdx = rProgram.animOps.size();
+    rProgram.animOps.insert(rProgram.animOps.end(),
+                            krPaletteOps.begin(),
+                            krPaletteOps.end());
+    rProgram.scaleIdx = rProgram.animOps.size();
+    rProgram.animOps.insert(rProgram.animOps.end(),
+                            krPostScaleOps.begin(),
+                            krPostScaleOps.end());
+}
+
+void PatternCompiler::CompileColor(const SColor&    krColor,
+                                   const uint16_t   kLedCount,
+                                   SPatternProgram& rProgram)
+{
+    SColorOp op;
+    uint16_t endIdx;
+
+    if(krColor.endIdx < krColor.startIdx || krColor.startIdx >= kLedCount)
+    {
+        return;
+    }
+
+    op.startIdx       = krColor.startIdx;
+    op.startColorCode = krColor.startColorCode;
+    op.endColorCode   = krColor.endColorCode;
+
+    /* Clip to the strip, a clipped gradient ends on its color at the clip */
+    endIdx = krColor.endIdx;
+    if(endIdx >= kLedCount)
+    {
+        endIdx = kLedCount - 1;
+        if(rProgram.isIndexed == true)
+        {
+            op.endColorCode = krColor.startColorCode +
+                              ((int32_t)krColor.endColorCode -
+                               (int32_t)krColor.startColorCode) *
+                              (int32_t)(endIdx - krColor.startIdx) /
+                              (int32_t)(krColor.endIdx - krColor.startIdx);
+        }
+        else
+        {
+            op.endColorCode = LerpColor(krColor.startColorCode,
+                                        krColor.endColorCode,
+                                        endIdx - krColor.startIdx,
+                                        krColor.endIdx - krColor.startIdx);
+        }
+    }
+    op.count = endIdx - krColor.startIdx + 1;
+
+    if(rProgram.isIndexed == true)
+    {
+        op.pKernel = (op.startColorCode != op.endColorCode) ?
+                     KernelIndexRamp :
+                     KernelIndexFill;
+    }
+    else
+    {
+        op.pKernel = (op.startColorCode != op.endColorCode) ?
+                     KernelGradient :
+                     KernelFill;
+    }
+
+    rProgram.colorOps.push_back(op);
+}
+
+bool PatternCompiler::ClipAnimation(const SAnimation& krAnim,
+                                    const uint16_t    kLimit,
+                                    SAnimOp&          rOp)
+{
+    uint16_t highIdx;
+
+    if(krAnim.startIdx > krAnim.endIdx)
+    {
+        rOp.lowIdx = krAnim.endIdx;
+        highIdx    = krAnim.startIdx;
+    }
+    else
+    {
+        rOp.lowIdx = krAnim.startIdx;
+        highIdx    = krAnim.endIdx;
+    }
+
+    if(rOp.lowIdx >= kLimit)
+    {
+        return false;
+    }
+    if(highIdx >= kLimit)
+    {
+        highIdx = kLimit - 1;
+    }
+
+    rOp.length = highIdx - rOp.lowIdx + 1;
+
+    return true;
+}
@@ -0,0 +1,408 @@
+/*******************************************************************************
+ * @file PatternImage.cpp
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief LED strip pattern image.
+ *
+ * @details This file provides the stored form of a pattern and its view.
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include <cstdint>   /* Standard Int Types */
+#include <cstring>   /* memcpy */
+#include <memory>    /* std::shared_ptr */
+#include <vector>    /* std::vector */
+#include <string>    /* std::string */
+#include <Logger.h>  /* Logger services */
+#include <Pattern.h> /* Pattern object */
+
+/* Header File */
+#include <PatternImage.h>
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+/* Header fields offsets */
+#define HEADER_VERSION      0
+#define HEADER_BRIGHTNESS   1
+#define HEADER_ID           2
+#define HEADER_SIZE         4
+#define HEADER_NAME_SIZE    6
+#define HEADER_ANIM_COUNT   7
+#define HEADER_COLOR_COUNT  8
+#define HEADER_RESERVED     9
+#define HEADER_PALETTE_SIZE 10
+
+/* Animation fields offsets */
+#define ANIM_TYPE  0
+#define ANIM_START 1
+#define ANIM_END   3
+#define ANIM_PARAM 5
+
+/* Color fields offsets */
+#define COLOR_START      0
+#define COLOR_END        2
+#define COLOR_START_CODE 4
+#define COLOR_END_CODE   8
+
+/* Longer names are truncated */
+#define NAME_SIZE_MAX 255
+
+/*******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+#define MIN(X, Y) (((X) < (Y)) ? (X) : (Y))
+
+/*******************************************************************************
+ * STRUCTURES AND TYPES
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/************************* Imported global variables **************************/
+/* None */
+
+/************************* Exported global variables **************************/
+/* None */
+
+/************************** Static global variables ***************************/
+/* None */
+
+/*******************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ ******************************************************************************/
+
+static uint16_t ReadLE16(const uint8_t* kpData);
+static uint32_t ReadLE32(const uint8_t* kpData);
+static void WriteLE16(uint8_t* pData, const uint16_t kValue);
+static void WriteLE32(uint8_t* pData, const uint32_t kValue);
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+/* The fields are read byte per byte, the image may not be aligned */
+static uint16_t ReadLE16(const uint8_t* kpData)
+{
+    return kpData[0] | (kpData[1] << 8);
+}
+
+static uint32_t ReadLE32(const uint8_t* kpData)
+{
+    return kpData[0] |
+           (kpData[1] << 8) |
+           (kpData[2] << 16) |
+           ((uint32_t)kpData[3] << 24);
+}
+
+static void WriteLE16(uint8_t* pData, const uint16_t kValue)
+{
+    pData[0] = kValue & 0xFF;
+    pData[1] = kValue >> 8;
+}
+
+static void WriteLE32(uint8_t* pData, const uint32_t kValue)
+{
+    pData[0] = kValue & 0xFF;
+    pData[1] = (kValue >> 8) & 0xFF;
+    pData[2] = (kValue >> 16) & 0xFF;
+    pData[3] = kValue >> 24;
+}
+
+/*******************************************************************************
+ * CLASS METHODS
+ ******************************************************************************/
+
+PatternImage::PatternImage(const uint8_t* kpImage, const size_t kSize)
+{
+    size_t imageSize;
+
+    pImage_        = kpImage;
+    isValid_       = false;
+    animsOffset_   = PATTERN_IMAGE_HEADER_SIZE;
+    colorsOffset_  = 0;
+    paletteOffset_ = 0;
+    nameOffset_    = 0;
+
+    if(kSize < PATTERN_IMAGE_HEADER_SIZE)
+    {
+        LOG_ERROR("Pattern image too small: %d\n", kSize);
+        return;
+    }
+    if(kpImage[HEADER_VERSION] != PATTERN_IMAGE_VERSION)
+    {
+        LOG_ERROR("Unknown pattern image version %d\n",
+                  kpImage[HEADER_VERSION]);
+        return;
+    }
+    if(ReadLE16(&kpImage[HEADER_PALETTE_SIZE]) > PATTERN_PALETTE_MAX)
+    {
+        LOG_ERROR("Pattern image palette too big\n");
+        return;
+    }
+
+    colorsOffset_  = animsOffset_ +
+                     kpImage[HEADER_ANIM_COUNT] * PATTERN_IMAGE_ANIM_SIZE;
+    paletteOffset_ = colorsOffset_ +
+                     kpImage[HEADER_COLOR_COUNT] * PATTERN_IMAGE_COLOR_SIZE;
+    nameOffset_    = paletteOffset_ +
+                     ReadLE16(&kpImage[HEADER_PALETTE_SIZE]) *
+                     PATTERN_IMAGE_ENTRY_SIZE;
+
+    /* The parts must fill the image and the image must be available */
+    imageSize = ReadLE16(&kpImage[HEADER_SIZE]);
+    if(imageSize > kSize ||
+       nameOffset_ + kpImage[HEADER_NAME_SIZE] != imageSize)
+    {
+        LOG_ERROR("Pattern image size mismatch: %d\n", imageSize);
+        return;
+    }
+
+    isValid_ = true;
+}
+
+bool PatternImage::IsValid(void) const
+{
+    return isValid_;
+}
+
+size_t PatternImage::GetSize(void) const
+{
+    return ReadLE16(&pImage_[HEADER_SIZE]);
+}
+
+uint16_t PatternImage::GetId(void) const
+{
+    return ReadLE16(&pImage_[HEADER_ID]);
+}
+
+uint8_t PatternImage::GetBrightness(void) const
+{
+    return pImage_[HEADER_BRIGHTNESS];
+}
+
+bool PatternImage::IsIndexed(void) const
+{
+    return GetPaletteSize() != 0;
+}
+
+const char* PatternImage::GetName(void) const
+{
+    return (const char*)&pImage_[nameOffset_];
+}
+
+uint8_t PatternImage::GetNameSize(void) const
+{
+    return pImage_[HEADER_NAME_SIZE];
+}
+
+uint8_t PatternImage::GetAnimationCount(void) const
+{
+    return pImage_[HEADER_ANIM_COUNT];
+}
+
+void PatternImage::GetAnimation(const uint8_t kIdx, SAnimation& rAnim) const
+{
+    const uint8_t* kpAnim;
+
+    kpAnim = &pImage_[animsOffset_ + kIdx * PATTERN_IMAGE_ANIM_SIZE];
+
+    rAnim.type     = kpAnim[ANIM_TYPE];
+    rAnim.startIdx = ReadLE16(&kpAnim[ANIM_START]);
+    rAnim.endIdx   = ReadLE16(&kpAnim[ANIM_END]);
+    rAnim.param    = ReadLE16(&kpAnim[ANIM_PARAM]);
+}
+
+uint8_t PatternImage::GetColorCount(void) const
+{
+    return pImage_[HEADER_COLOR_COUNT];
+}
+
+void PatternImage::GetColor(const uint8_t kIdx, SColor& rColor) const
+{
+    const uint8_t* kpColor;
+
+    kpColor = &pImage_[colorsOffset_ + kIdx * PATTERN_IMAGE_COLOR_SIZE];
+
+    rColor.startIdx       = ReadLE16(&kpColor[COLOR_START]);
+    rColor.endIdx         = ReadLE16(&kpColor[COLOR_END]);
+    rColor.startColorCode = ReadLE32(&kpColor[COLOR_START_CODE]);
+    rColor.endColorCode   = ReadLE32(&kpColor[COLOR_END_CODE]);
+}
+
+uint16_t PatternImage::GetPaletteSize(void) const
+{
+    return ReadLE16(&pImage_[HEADER_PALETTE_SIZE]);
+}
+
+uint32_t PatternImage::GetPaletteColor(const uint16_t kIdx) const
+{
+    return ReadLE32(&pImage_[paletteOffset_ + kIdx * PATTERN_IMAGE_ENTRY_SIZE]);
+}
+
+std::shared_ptr<Pattern> PatternImage::ToPattern(void) const
+{
+    size_t                   i;
+    std::shared_ptr<Pattern> patternPtr;
+    std::vector<SAnimation>  anims;
+    std::vector<SColor>      colors;
+    std::vector<uint32_t>    palette;
+
+    if(isValid_ == false)
+    {
+        return nullptr;
+    }
+
+    patternPtr = std::make_shared<Pattern>(GetId(),
+                                           std::string(GetName(),
+                                                       GetNameSize()));
+    patternPtr->SetBrightness(GetBrightness());
+
+    anims.resize(GetAnimationCount());
+    for(i = 0; i < anims.size(); ++i)
+    {
+        GetAnimation(i, anims[i]);
+    }
+
+    colors.resize(GetColorCount());
+    for(i = 0; i < colors.size(); ++i)
+    {
+        GetColor(i, colors[i]);
+    }
+
+    palette.resize(GetPaletteSize());
+    for(i = 0; i < palette.size(); ++i)
+    {
+        palette[i] = GetPaletteColor(i);
+    }
+
+    patternPtr->SetAnimations(anims);
+    patternPtr->SetColors(colors);
+    patternPtr->SetPalette(palette);
+
+    return patternPtr;
+}
+
+void PatternImage::WriteId(uint8_t* pImage, const uint16_t kId)
+{
+    WriteLE16(&pImage[HEADER_ID], kId);
+}
+
+size_t PatternImage::GetImageSize(const Pattern& krPattern)
+{
+    size_t imageSize;
+
+    if(krPattern.IsPacked() == true)
+    {
+        return krPattern.GetImageSize();
+    }
+
+    if(krPattern.GetAnimations().size() > 255 ||
+       krPattern.GetColors().size() > 255 ||
+       krPattern.GetPalette().size() > PATTERN_PALETTE_MAX)
+    {
+        return 0;
+    }
+
+    imageSize = PATTERN_IMAGE_HEADER_SIZE +
+                krPattern.GetAnimations().size() * PATTERN_IMAGE_ANIM_SIZE +
+                krPattern.GetColors().size() * PATTERN_IMAGE_COLOR_SIZE +
+                krPattern.GetPalette().size() * PATTERN_IMAGE_ENTRY_SIZE +
+                MIN(krPattern.GetName().size(), NAME_SIZE_MAX);
+
+    return imageSize;
+}
+
+size_t PatternImage::Write(const Pattern& krPattern,
+                           uint8_t*       pBuffer,
+                           const size_t   kSize)
+{
+    size_t   imageSize;
+    size_t   offset;
+    size_t   nameSize;
+    uint32_t i;
+
+    imageSize = GetImageSize(krPattern);
+    if(imageSize == 0)
+    {
+        LOG_ERROR("Pattern %d cannot be stored\n", krPattern.GetId());
+        return 0;
+    }
+    if(imageSize > kSize)
+    {
+        LOG_ERROR("Could not save pattern, buffer is full\n");
+        return 0;
+    }
+
+    if(krPattern.IsPacked() == true)
+    {
+        memcpy(pBuffer, krPattern.GetImage(), imageSize);
+        return imageSize;
+    }
+
+    const std::vector<SAnimation>& krAnims   = krPattern.GetAnimations();
+    const std::vector<SColor>&     krColors  = krPattern.GetColors();
+    const std::vector<uint32_t>&   krPalette = krPattern.GetPalette();
+    const std::string&             krName    = krPattern.GetName();
+
+    nameSize = krName.size();
+    if(nameSize > NAME_SIZE_MAX)
+    {
+        LOG_ERROR("Pattern name size too big, truncating to 255\n");
+        nameSize = NAME_SIZE_MAX;
+    }
+
+    pBuffer[HEADER_VERSION]     = PATTERN_IMAGE_VERSION;
+    pBuffer[HEADER_BRIGHTNESS]  = krPattern.GetBrightness();
+    WriteLE16(&pBuffer[HEADER_ID], krPattern.GetId());
+    WriteLE16(&pBuffer[HEADER_SIZE], imageSize);
+    pBuffer[HEADER_NAME_SIZE]   = nameSize;
+    pBuffer[HEADER_ANIM_COUNT]  = krAnims.size();
+    pBuffer[HEADER_COLOR_COUNT] = krColors.size();
+    pBuffer[HEADER_RESERVED]    = 0;
+    WriteLE16(&pBuffer[HEADER_PALETTE_SIZE], krPalette.size());
+    offset = PATTERN_IMAGE_HEADER_SIZE;
+
+    for(const SAnimation& krAnim : krAnims)
+    {
+        pBuffer[offset + ANIM_TYPE] = krAnim.type;
+        WriteLE16(&pBuffer[offset + ANIM_START], krAnim.startIdx);
+        WriteLE16(&pBuffer[offset + ANIM_END], krAnim.endIdx);
+        WriteLE16(&pBuffer[offset + ANIM_PARAM], krAnim.param);
+        offset += PATTERN_IMAGE_ANIM_SIZE;
+    }
+
+    for(const SColor& krColor : krColors)
+    {
+        WriteLE16(&pBuffer[offset + COLOR_START], krColor.startIdx);
+        WriteLE16(&pBuffer[offset + COLOR_END], krColor.endIdx);
+        WriteLE32(&pBuffer[offset + COLOR_START_CODE], krColor.startColorCode);
+        WriteLE32(&pBuffer[offset + COLOR_END_CODE], krColor.endColorCode);
+        offset += PATTERN_IMAGE_COLOR_SIZE;
+    }
+
+    for(i = 0; i < krPalette.size(); ++i)
+    {
+        WriteLE32(&pBuffer[offset], krPalette[i]);
+        offset += PATTERN_IMAGE_ENTRY_SIZE;
+    }
+
+    memcpy(&pBuffer[offset], krName.c_str(), nameSize);
+
+    return imageSize;
+}
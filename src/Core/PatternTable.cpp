@@ -0,0 +1,289 @@
+/*******************************************************************************
+ * @file PatternTable.cpp
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief Pattern table.
+ *
+ * @details This file provides the table holding the patterns of the manager.
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include <cstdint> /* Standard Int Types */
+#include <vector>  /* std::vector */
+#include <memory>  /* std::shared_ptr */
+#include <Logger.h> /* Logger services */
+#include <Pattern.h> /* Pattern object */
+
+/* Header File */
+#include <PatternTable.h>
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * STRUCTURES AND TYPES
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/************************* Imported global variables **************************/
+/* None */
+
+/************************* Exported global variables **************************/
+/* None */
+
+/************************** Static global variables ***************************/
+/* None */
+
+/*******************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * CLASS METHODS
+ ******************************************************************************/
+
+PatternTable::PatternTable(void)
+{
+    freeHead_        = PATTERN_TABLE_NO_ID;
+    count_           = 0;
+    isFreeListValid_ = true;
+}
+
+uint16_t PatternTable::Add(const std::shared_ptr<Pattern>& krPattern)
+{
+    uint16_t newId;
+
+    if(isFreeListValid_ == false)
+    {
+        RebuildFreeList();
+    }
+
+    if(freeHead_ != PATTERN_TABLE_NO_ID)
+    {
+        newId     = freeHead_;
+        freeHead_ = slots_[newId].nextFree;
+    }
+    else if(slots_.size() < PATTERN_TABLE_NO_ID)
+    {
+        newId = slots_.size();
+        slots_.push_back({
+            .pattern    = nullptr,
+            .generation = 0,
+            .nextFree   = PATTERN_TABLE_NO_ID
+        });
+    }
+    else
+    {
+        LOG_ERROR("No more available pattern ID\n");
+        return PATTERN_TABLE_NO_ID;
+    }
+
+    krPattern->ForceId(newId);
+    krPattern->Pack();
+    slots_[newId].pattern  = krPattern;
+    slots_[newId].nextFree = PATTERN_TABLE_NO_ID;
+    ++slots_[newId].generation;
+    ++count_;
+
+    return newId;
+}
+
+bool PatternTable::Insert(const std::shared_ptr<Pattern>& krPattern)
+{
+    uint16_t patternId;
+
+    patternId = krPattern->GetId();
+    if(patternId == PATTERN_TABLE_NO_ID)
+    {
+        return false;
+    }
+
+    if(patternId >= slots_.size())
+    {
+        slots_.resize(patternId + 1, {
+            .pattern    = nullptr,
+            .generation = 0,
+            .nextFree   = PATTERN_TABLE_NO_ID
+        });
+    }
+    else if(slots_[patternId].pattern != nullptr)
+    {
+        return false;
+    }
+
+    krPattern->Pack();
+    slots_[patternId].pattern = krPattern;
+    ++slots_[patternId].generation;
+    ++count_;
+
+    /* The slot may be chained in the free list, it is rebuilt on the next
+     * allocation.
+     */
+    isFreeListValid_ = false;
+
+    return true;
+}
+
+bool PatternTable::Replace(const std::shared_ptr<Pattern>& krPattern)
+{
+    uint16_t patternId;
+
+    patternId = krPattern->GetId();
+    if(Contains(patternId) == false)
+    {
+        return false;
+    }
+
+    krPattern->Pack();
+    slots_[patternId].pattern = krPattern;
+    ++slots_[patternId].generation;
+
+    return true;
+}
+
+bool PatternTable::Remove(const uint16_t kPatternId)
+{
+    if(Contains(kPatternId) == false)
+    {
+        return false;
+    }
+
+    slots_[kPatternId].pattern = nullptr;
+    ++slots_[kPatternId].generation;
+    --count_;
+
+    if(isFreeListValid_ == true)
+    {
+        slots_[kPatternId].nextFree = freeHead_;
+        freeHead_                   = kPatternId;
+    }
+
+    return true;
+}
+
+const std::shared_ptr<Pattern>* PatternTable::Find(
+                                            const uint16_t kPatternId) const
+{
+    if(Contains(kPatternId) == false)
+    {
+        return nullptr;
+    }
+
+    return &slots_[kPatternId].pattern;
+}
+
+const std::shared_ptr<Pattern>* PatternTable::Resolve(
+                                        const SPatternHandle& krHandle) const
+{
+    if(Contains(krHandle.id) == false ||
+       slots_[krHandle.id].generation != krHandle.generation)
+    {
+        return nullptr;
+    }
+
+    return &slots_[krHandle.id].pattern;
+}
+
+SPatternHandle PatternTable::GetHandle(const uint16_t kPatternId) const
+{
+    if(Contains(kPatternId) == false)
+    {
+        return { .id = PATTERN_TABLE_NO_ID, .generation = 0 };
+    }
+
+    return { .id = kPatternId, .generation = slots_[kPatternId].generation };
+}
+
+bool PatternTable::Contains(const uint16_t kPatternId) const
+{
+    return kPatternId < slots_.size() &&
+           slots_[kPatternId].pattern != nullptr;
+}
+
+size_t PatternTable::GetCount(void) const
+{
+    return count_;
+}
+
+void PatternTable::GetIds(std::vector<uint16_t>& rPatternIds) const
+{
+    size_t i;
+
+    rPatternIds.clear();
+    rPatternIds.reserve(count_);
+    for(i = 0; i < slots_.size(); ++i)
+    {
+        if(slots_[i].pattern != nullptr)
+        {
+            rPatternIds.push_back(i);
+        }
+    }
+}
+
+void PatternTable::GetPatterns(
+                    std::vector<std::shared_ptr<Pattern>>& rPatterns) const
+{
+    rPatterns.clear();
+    rPatterns.reserve(count_);
+    for(const SPatternSlot& krSlot : slots_)
+    {
+        if(krSlot.pattern != nullptr)
+        {
+            rPatterns.push_back(krSlot.pattern);
+        }
+    }
+}
+
+size_t PatternTable::GetHeapSize(void) const
+{
+    return slots_.capacity() * sizeof(SPatternSlot);
+}
+
+void PatternTable::RebuildFreeList(void)
+{
+    size_t i;
+
+    /* Chain the free slots so the lowest identifiers are reused first */
+    freeHead_ = PATTERN_TABLE_NO_ID;
+    for(i = slots_.size(); i > 0; --i)
+    {
+        if(slots_[i - 1].pattern == nullptr)
+        {
+            slots_[i - 1].nextFree = freeHead_;
+            freeHead_              = i - 1;
+        }
+    }
+
+    isFreeListValid_ = true;
+}
@@ -0,0 +1,261 @@
+/*******************************************************************************
+ * @file SceneLinks.cpp
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief Scene links container.
+ *
+ * @details This file provides the container of the links between the strips
+ * and the patterns of a scene.
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include <cstdint> /* Standard Int Types */
+#include <vector>  /* std::vector */
+
+/* Header File */
+#include <SceneLinks.h>
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * STRUCTURES AND TYPES
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/************************* Imported global variables **************************/
+/* None */
+
+/************************* Exported global variables **************************/
+/* None */
+
+/************************** Static global variables ***************************/
+static const SLinkParams sDefaultParams = {
+    .brightness = LINK_BRIGHTNESS_DEFAULT,
+    .flags      = 0,
+    .speed      = LINK_SPEED_DEFAULT,
+    .phase      = LINK_PHASE_DEFAULT
+};
+
+/*******************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * CLASS METHODS
+ ******************************************************************************/
+
+SceneLinks::SceneLinks(void)
+{
+    count_     = 0;
+    isSpilled_ = false;
+}
+
+void SceneLinks::Set(const uint8_t kStripId, const uint16_t kPatternId)
+{
+    Set(kStripId, kPatternId, sDefaultParams);
+}
+
+void SceneLinks::Set(const uint8_t      kStripId,
+                     const uint16_t     kPatternId,
+                     const SLinkParams& krParams)
+{
+    size_t      i;
+    size_t      position;
+    SSceneLink* pLinks;
+
+    position = LowerBound(kStripId);
+    pLinks   = GetData();
+
+    /* Replace the link of an already linked strip */
+    if(position < count_ && pLinks[position].stripId == kStripId)
+    {
+        pLinks[position].patternId = kPatternId;
+        pLinks[position].params    = krParams;
+        return;
+    }
+
+    if(isSpilled_ == false && count_ < SCENE_LINKS_INLINE_COUNT)
+    {
+        for(i = count_; i > position; --i)
+        {
+            inline_[i] = inline_[i - 1];
+        }
+        inline_[position] = {
+            .stripId   = kStripId,
+            .patternId = kPatternId,
+            .params    = krParams
+        };
+    }
+    else
+    {
+        /* Move to the heap once, the scene keeps its buffer afterwards */
+        if(isSpilled_ == false)
+        {
+            spilled_.assign(inline_, inline_ + count_);
+            isSpilled_ = true;
+        }
+        spilled_.insert(spilled_.begin() + position,
+                        {
+                            .stripId   = kStripId,
+                            .patternId = kPatternId,
+                            .params    = krParams
+                        });
+    }
+
+    ++count_;
+}
+
+bool SceneLinks::Erase(const uint8_t kStripId)
+{
+    size_t      i;
+    size_t      position;
+    SSceneLink* pLinks;
+
+    position = LowerBound(kStripId);
+    pLinks   = GetData();
+
+    if(position >= count_ || pLinks[position].stripId != kStripId)
+    {
+        return false;
+    }
+
+    if(isSpilled_ == true)
+    {
+        spilled_.erase(spilled_.begin() + position);
+    }
+    else
+    {
+        for(i = position; i + 1 < count_; ++i)
+        {
+            inline_[i] = inline_[i + 1];
+        }
+    }
+
+    --count_;
+
+    return true;
+}
+
+const SSceneLink* SceneLinks::Find(const uint8_t kStripId) const
+{
+    size_t            position;
+    const SSceneLink* kpLinks;
+
+    position = LowerBound(kStripId);
+    kpLinks  = GetData();
+
+    if(position < count_ && kpLinks[position].stripId == kStripId)
+    {
+        return &kpLinks[position];
+    }
+
+    return nullptr;
+}
+
+size_t SceneLinks::Size(void) const
+{
+    return count_;
+}
+
+size_t SceneLinks::GetHeapSize(void) const
+{
+    return spilled_.capacity() * sizeof(SSceneLink);
+}
+
+bool SceneLinks::IsSameParams(const SLinkParams& krFirst,
+                              const SLinkParams& krSecond)
+{
+    return krFirst.brightness == krSecond.brightness &&
+           krFirst.flags == krSecond.flags &&
+           krFirst.speed == krSecond.speed &&
+           krFirst.phase == krSecond.phase;
+}
+
+const SSceneLink* SceneLinks::begin(void) const
+{
+    return GetData();
+}
+
+const SSceneLink* SceneLinks::end(void) const
+{
+    return GetData() + count_;
+}
+
+SSceneLink* SceneLinks::GetData(void)
+{
+    if(isSpilled_ == true)
+    {
+        return spilled_.data();
+    }
+
+    return inline_;
+}
+
+const SSceneLink* SceneLinks::GetData(void) const
+{
+    if(isSpilled_ == true)
+    {
+        return spilled_.data();
+    }
+
+    return inline_;
+}
+
+size_t SceneLinks::LowerBound(const uint8_t kStripId) const
+{
+    size_t            low;
+    size_t            high;
+    size_t            middle;
+    const SSceneLink* kpLinks;
+
+    kpLinks = GetData();
+    low     = 0;
+    high    = count_;
+
+    while(low < high)
+    {
+        middle = (low + high) / 2;
+        if(kpLinks[middle].stripId < kStripId)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+
+    return low;
+}
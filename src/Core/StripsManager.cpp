@@ -20,14 +20,16 @@
 #include <cstdint>    /* Standard Int Types */
 #include <vector>     /* std::vector */
 #include <memory>     /* std::shared_ptr */
-#include <unordered_map> /* std::unordered_map */
 #include <LEDStrip.hpp> /* LED strip driver*/
+#include <LEDTransmitter.h> /* LED strips output stage */
 #include <Logger.h> /* Logger services */
 #include <FastLED.h> /* FastLED driver */
 #include <Storage.h> /* Storage service */
 #include <SystemState.h> /* SystemState services */
 #include <HWLayer.h>    /* HW Layer abstraction */
+#include <TaskMonitor.h> /* Tasks configuration and monitoring */
 #include <Arduino.h>     /* Semaphore services */
+#include <esp_timer.h>   /* Frame deadline timer */
 
 /* Header File */
 #include <StripsManager.h>
@@ -36,8 +38,37 @@
  * CONSTANTS
  ******************************************************************************/
 
-#define NO_PATTERN              0xFFFF
-#define UPDATE_ROUTINE_DELAY_US 10000
+#define NO_PATTERN              PATTERN_TABLE_NO_ID
+/* The frame timer wakes the worker this long before the frame deadline,
+ * it spins for the remaining time.
+ */
+#define FRAME_SPIN_US           50
+#define LOCK_RATE_WINDOW_US     1000000
+
+/* A flash write ends this long before the next frame deadline, a write that
+ * fits no frame gap is delayed at most FRAME_GAP_WAIT_MAX_US. No frame is
+ * scheduled while the gap is unbounded.
+ */
+#define FRAME_GAP_MARGIN_US     500
+#define FRAME_GAP_WAIT_MAX_US   100000
+#define FRAME_GAP_UNBOUNDED     UINT64_MAX
+
+/* Worker wake up reasons, sent as notification bits */
+#define WORKER_WAKE_SCENE       0x01
+#define WORKER_WAKE_PATTERN     0x02
+#define WORKER_WAKE_BRIGHTNESS  0x04
+#define WORKER_WAKE_ENABLE      0x08
+#define WORKER_WAKE_SHUTDOWN    0x10
+#define WORKER_WAKE_STRIPS      0x20
+/* Sent by the frame timer, not a reason to restart the schedule */
+#define WORKER_WAKE_DEADLINE    0x40
+
+/* Updates deferred to the end of a batch */
+#define BATCH_PENDING_PLAN      0x01
+#define BATCH_PENDING_RESTART   0x02
+#define BATCH_PENDING_ACTIVITY  0x04
+#define BATCH_PENDING_SCENES    0x08
+#define BATCH_PENDING_SELECTED  0x10
 
 /*******************************************************************************
  * MACROS
@@ -69,13 +100,84 @@ StripsManager* StripsManager::PINSTANCE_ = nullptr;
  * STATIC FUNCTIONS DECLARATIONS
  ******************************************************************************/
 
-/* None */
+/**
+ * @brief Waits until an absolute time or a wake up notification.
+ *
+ * @details Waits until an absolute time. The task sleeps until the frame
+ * timer wakes it FRAME_SPIN_US before the deadline and spins for the
+ * remaining time, the wait is not rounded to the tick. A notification
+ * received while sleeping ends the wait early.
+ *
+ * @param[in] kDeadline The time to wait for in microseconds.
+ * @param[in] pTimer The frame timer, notifies WORKER_WAKE_DEADLINE.
+ *
+ * @return The received wake up reasons, 0 if the deadline was reached.
+ */
+static uint32_t WaitUntil(const uint64_t     kDeadline,
+                          esp_timer_handle_t pTimer);
+
+/**
+ * @brief Estimates the cost of rendering a program.
+ *
+ * @details Estimates the cost of rendering a program as the number of pixels
+ * or palette entries written per frame, at least one.
+ *
+ * @param[in] krProgram The program.
+ *
+ * @return The estimated cost.
+ */
+static uint32_t GetRenderCost(const SPatternProgram& krProgram);
 
 /*******************************************************************************
  * FUNCTIONS
  ******************************************************************************/
 
-/* None */
+static uint32_t WaitUntil(const uint64_t     kDeadline,
+                          esp_timer_handle_t pTimer)
+{
+    uint64_t timeNow;
+    uint32_t reasons;
+
+    timeNow = HWLayer::GetTime();
+    if(kDeadline > timeNow + FRAME_SPIN_US)
+    {
+        esp_timer_start_once(pTimer, kDeadline - timeNow - FRAME_SPIN_US);
+
+        /* A deadline notification left by a previous wait is ignored */
+        do
+        {
+            xTaskNotifyWait(0, 0xFFFFFFFF, &reasons, portMAX_DELAY);
+            reasons &= ~WORKER_WAKE_DEADLINE;
+        } while(reasons == 0 &&
+                HWLayer::GetTime() + FRAME_SPIN_US < kDeadline);
+
+        if(reasons != 0)
+        {
+            esp_timer_stop(pTimer);
+            return reasons;
+        }
+    }
+
+    while(HWLayer::GetTime() < kDeadline)
+    {
+    }
+
+    return 0;
+}
+
+static uint32_t GetRenderCost(const SPatternProgram& krProgram)
+{
+    uint32_t cost;
+
+    /* Base frame copy and brightness or palette expansion */
+    cost = krProgram.ledCount + 1;
+    for(const SAnimOp& krOp : krProgram.animOps)
+    {
+        cost += krOp.length;
+    }
+
+    return cost;
+}
 
 /*******************************************************************************
  * CLASS METHODS
@@ -93,44 +195,64 @@ StripsManager* StripsManager::GetInstance(void)
 
 void StripsManager::GetStripsInfo(StripsInfoTable_t& rStripsInfo) const
 {
-    std::unordered_map<uint8_t, std::shared_ptr<LEDStrip>>::const_iterator it;
-
     rStripsInfo.clear();
     LOG_DEBUG("Number of strips: %d.\n", strips_.size());
-    for(it = strips_.begin(); it != strips_.end(); ++it)
+    for(const std::shared_ptr<LEDStrip>& krStrip : strips_)
     {
-        LOG_DEBUG("Reading info for %s.\n", it->second->GetName().c_str());
+        LOG_DEBUG("Reading info for %s.\n", krStrip->GetName().c_str());
         std::shared_ptr<SStripInfo> info = std::make_shared<SStripInfo>();
-        it->second->GetStripInfo(info);
+        krStrip->GetStripInfo(info);
         rStripsInfo.push_back(info);
     }
 }
 
+bool StripsManager::SaveStripsLayout(const std::vector<SStripConfig>& krConfigs)
+{
+    std::vector<bool> isValid;
+
+    if(krConfigs.empty() == true ||
+       ValidateStrips(krConfigs, isValid) == false)
+    {
+        LOG_ERROR("Invalid strips layout\n");
+        return false;
+    }
+
+    /* The strips buffers and links are only created on boot */
+    Storage::GetInstance()->SaveStrips(krConfigs);
+    LOG_INFO("New strips layout saved, reboot to apply\n");
+
+    return true;
+}
+
 uint16_t StripsManager::AddPattern(const std::shared_ptr<Pattern>& krNewPattern)
 {
     uint16_t newId;
 
+    if(PatternCompiler::Validate(*krNewPattern) == false)
+    {
+        LOG_ERROR("Tried to add invalid pattern\n");
+        return NO_PATTERN;
+    }
+
     Lock();
-    if(patterns_.count(rkNewPattern->GetId()) != 0)
+    if(patterns_.Contains(krNewPattern->GetId()) == true)
     {
         Unlock();
 
         LOG_ERROR("Tried to add existing pattern %d\n", krNewPattern->GetId());
-        return false;
+        return NO_PATTERN;
     }
 
-    newId = GetNewPatternId();
-    if(newId == 0xFFFF)
+    newId = patterns_.Add(krNewPattern);
+
+    Unlock();
+
+    if(newId == NO_PATTERN)
     {
         return newId;
     }
 
-    patterns_[newId] = krNewPattern;
-    patterns_[newId]->ForceId(newId);
-
-    Unlock();
-
-    SavePatterns();
+    Storage::GetInstance()->SavePattern(krNewPattern);
 
     LOG_DEBUG("Added pattern %d\n", krNewPattern->GetId());
 
@@ -139,12 +261,17 @@ uint16_t StripsManager::AddPattern(const std::shared_ptr<Pattern>& krNewPattern)
 
 bool StripsManager::RemovePattern(const uint16_t kPatternId)
 {
-    std::unordered_map<uint8_t, uint16_t>::iterator it;
-    std::unordered_map<uint8_t, uint16_t>::iterator saveIt;
+    size_t                   i;
+    size_t                   j;
+    bool                     isLinked;
+    bool                     isStripsUpdate;
+    LEDStrip*                pStrip;
+    std::vector<SPatternUse> uses;
+    std::vector<uint8_t>     copiedScenes;
 
     Lock();
 
-    if(patterns_.count(kPatternId) == 0)
+    if(patterns_.Contains(kPatternId) == false)
     {
         Unlock();
 
@@ -152,31 +279,65 @@ bool StripsManager::RemovePattern(const uint16_t kPatternId)
         return false;
     }
 
-    /* Unlink pattern to all scenes */
-    for(std::shared_ptr<SScene>& rScene : scenes_)
+    /* Unlink pattern from the scenes that use it, scenes are copied on write
+     * as they may still be referenced by readers.
+     */
+    isLinked       = false;
+    isStripsUpdate = false;
+    uses           = linkIndex_.GetUses(kPatternId);
+    for(i = 0; i < uses.size(); ++i)
     {
-        for(it = rScene->links.begin(); it != rScene->links.end();)
+        for(j = 0; j < copiedScenes.size(); ++j)
         {
-            if(it->second == kPatternId)
+            if(copiedScenes[j] == uses[i].sceneIdx)
             {
-                strips_[it->first]->SetEnabled(false);
-                it = rScene->links.erase(it);
+                break;
             }
-            else
+        }
+        if(j == copiedScenes.size())
+        {
+            scenes_[uses[i].sceneIdx] =
+                std::make_shared<SScene>(*scenes_[uses[i].sceneIdx]);
+            copiedScenes.push_back(uses[i].sceneIdx);
+        }
+        scenes_[uses[i].sceneIdx]->links.Erase(uses[i].stripId);
+
+        if(uses[i].sceneIdx == selectedScene_)
+        {
+            pStrip = FindStrip(uses[i].stripId);
+            if(pStrip != nullptr)
             {
-                ++it;
+                isStripsUpdate |= pStrip->RequestEnabled(false);
             }
+            isLinked = true;
         }
     }
+    linkIndex_.RemovePattern(kPatternId);
 
     /* Remove pattern */
-    patterns_.erase(kPatternId);
+    patterns_.Remove(kPatternId);
+
+    if(isStripsUpdate == true)
+    {
+        PublishStripsEnable();
+    }
+    if(isLinked == true)
+    {
+        BuildRenderPlan(false);
+    }
 
     Unlock();
 
-    CheckForActivity();
+    if(isLinked == true)
+    {
+        UpdateActivity();
+    }
 
-    SavePatterns();
+    Storage::GetInstance()->RemovePattern(kPatternId);
+    if(uses.empty() == false)
+    {
+        SaveScenes();
+    }
 
     LOG_DEBUG("Erased pattern %d\n", kPatternId);
 
@@ -186,13 +347,22 @@ bool StripsManager::RemovePattern(const uint16_t kPatternId)
 bool StripsManager::UpdatePattern(const std::shared_ptr<Pattern>& krNewPattern)
 {
     uint16_t patternId;
-    std::unordered_map<uint8_t, uint16_t>::iterator it;
+    bool     isLinked;
 
     patternId = krNewPattern->GetId();
+    isLinked  = false;
+
+    if(PatternCompiler::Validate(*krNewPattern) == false)
+    {
+        LOG_ERROR("Tried to update pattern %d with invalid pattern\n",
+                  patternId);
+        return false;
+    }
 
     Lock();
 
-    if(patterns_.count(patternId) == 0)
+    /* Update the pattern */
+    if(patterns_.Replace(krNewPattern) == false)
     {
         Unlock();
 
@@ -200,28 +370,29 @@ bool StripsManager::UpdatePattern(const std::shared_ptr<Pattern>& krNewPattern)
         return false;
     }
 
-    /* Update the pattern */
-    patterns_[patternId] = krNewPattern;
-
-    /* Update colors for all links */
+    /* Check if the pattern is used by the active scene */
     if(selectedScene_ != 255)
     {
-        for(it = scenes_[selectedScene_]->links.begin();
-            it != scenes_[selectedScene_]->links.end();
-            ++it)
-        {
-            if(it->second == patternId)
-            {
-                strips_[it->first]->UpdateColors();
-            }
-        }
+        isLinked = linkIndex_.IsUsedBy(patternId, selectedScene_);
+    }
+
+    /* Only the active scene patterns are in the render plan, the new pattern
+     * object gets a new revision so the strips reload its colors.
+     */
+    if(isLinked == true)
+    {
+        BuildRenderPlan(false);
     }
 
     Unlock();
 
-    CheckForActivity();
+    /* The pattern brightness may have changed */
+    if(isLinked == true)
+    {
+        UpdateActivity();
+    }
 
-    SavePatterns();
+    Storage::GetInstance()->SavePattern(krNewPattern);
 
     LOG_DEBUG("Updated pattern %d\n", patternId);
 
@@ -230,19 +401,17 @@ bool StripsManager::UpdatePattern(const std::shared_ptr<Pattern>& krNewPattern)
 
 void StripsManager::GetPatternsIds(std::vector<uint16_t>& rPatternIds) const
 {
-    rPatternIds.clear();
-
-    for(const std::pair<uint16_t, std::shared_ptr<Pattern>>& krPattern : patterns_)
-    {
-        rPatternIds.push_back(krPattern.first);
-    }
+    patterns_.GetIds(rPatternIds);
 }
 
 const Pattern* StripsManager::GetPatternInfo(const uint16_t kPatternId)
 {
-    if(patterns_.count(kPatternId) != 0)
+    const std::shared_ptr<Pattern>* kpPattern;
+
+    kpPattern = patterns_.Find(kPatternId);
+    if(kpPattern != nullptr)
     {
-        return patterns_[kPatternId].get();
+        return kpPattern->get();
     }
     else
     {
@@ -250,27 +419,6 @@ const Pattern* StripsManager::GetPatternInfo(const uint16_t kPatternId)
     }
 }
 
-uint16_t StripsManager::GetNewPatternId(void)
-{
-    uint16_t newId;
-
-    /* Look for available ID */
-    for(newId = 0; newId < 0xFFFF; ++newId)
-    {
-        if(patterns_.count(newId) == 0)
-        {
-            break;
-        }
-    }
-
-    if(newId == 0xFFFF)
-    {
-        LOG_ERROR("No more available pattern ID\n");
-    }
-
-    return newId;
-}
-
 uint8_t StripsManager::AddScene(const std::shared_ptr<SScene>& krNewScene)
 {
     uint8_t retVal;
@@ -278,20 +426,17 @@ uint8_t StripsManager::AddScene(const std::shared_ptr<SScene>& krNewScene)
     Lock();
 
     /* Check that the patterns and strips exist for the scene */
-    for(const std::pair<uint8_t, uint16_t>& link : krNewScene->links)
+    if(CheckSceneLinks(*krNewScene) == false)
     {
-        if(strips_.count(link.first) == 0 ||
-           patterns_.count(link.second) == 0)
-        {
-            LOG_ERROR("Tried to add scene with unknown strip or pattern\n");
-            Unlock();
-            return -1;
-        }
+        LOG_ERROR("Tried to add scene with unknown strip or pattern\n");
+        Unlock();
+        return -1;
     }
 
     /* Add the scene */
-    scenes_.push_back(rkNewScene);
+    scenes_.push_back(krNewScene);
     retVal = scenes_.size() - 1;
+    linkIndex_.AddScene(retVal, krNewScene->links);
     LOG_DEBUG("Added scene %d\n", scenes_.size() - 1);
 
     Unlock();
@@ -306,6 +451,8 @@ bool StripsManager::RemoveScene(const uint8_t kSceneIdx)
     Lock();
     if(kSceneIdx < scenes_.size())
     {
+        linkIndex_.RemoveScene(kSceneIdx, scenes_[kSceneIdx]->links);
+        linkIndex_.ShiftScenes(kSceneIdx);
         scenes_.erase(scenes_.begin() + kSceneIdx);
 
         if(scenes_.size() != 0)
@@ -326,10 +473,11 @@ bool StripsManager::RemoveScene(const uint8_t kSceneIdx)
         else
         {
             selectedScene_ = 255;
+            BuildRenderPlan(true);
             Unlock();
         }
 
-        CheckForActivity();
+        UpdateActivity();
 
         SaveScenes();
         SaveSelectedScene();
@@ -351,18 +499,27 @@ bool StripsManager::UpdateScene(const uint8_t kSceneIdx,
     Lock();
     if(kSceneIdx < scenes_.size())
     {
-        scenes_[kSceneIdx] = krScene;
-        if(selectedScene_ == kSceneIdx)
+        if(CheckSceneLinks(*krScene) == false)
         {
+            LOG_ERROR("Tried to update scene %d with unknown strip or "
+                      "pattern\n",
+                      kSceneIdx);
             Unlock();
-            ActivateScene();
-            return true;
+            return false;
         }
 
+        linkIndex_.RemoveScene(kSceneIdx, scenes_[kSceneIdx]->links);
+        scenes_[kSceneIdx] = krScene;
+        linkIndex_.AddScene(kSceneIdx, krScene->links);
+
         LOG_DEBUG("Updated scene %d\n", kSceneIdx);
         Unlock();
 
-        CheckForActivity();
+        if(selectedScene_ == kSceneIdx)
+        {
+            ActivateScene();
+            UpdateActivity();
+        }
 
         SaveScenes();
 
@@ -380,11 +537,16 @@ void StripsManager::SelectScene(const uint8_t kSceneIdx)
 {
     if(kSceneIdx < scenes_.size())
     {
-        selectedScene_ = kSceneIdx;
+        /* The selection time is published with the scene render plan */
+        Lock();
+        selectedScene_   = kSceneIdx;
+        sceneSelectTime_ = HWLayer::GetTime();
+        Unlock();
+
         ActivateScene();
         SystemState::GetInstance()->NotifyUpdate();
 
-        CheckForActivity();
+        UpdateActivity();
 
         SaveSelectedScene();
 
@@ -418,47 +580,79 @@ uint8_t StripsManager::GetSceneCount(void) const
     return (uint8_t)scenes_.size();
 }
 
-void StripsManager::CheckForActivity(void)
+void StripsManager::UpdateActivity(void)
 {
-    bool     hasEnabled;
-    uint16_t patternId;
+    bool              hasEnabled;
+    bool              isStripsUpdate;
+    const SSceneLink* kpLink;
+    const SSceneLink* kpLinksEnd;
 
-    hasEnabled = false;
+    hasEnabled     = false;
+    isStripsUpdate = false;
 
     Lock();
 
-    /* Check if current scene is 255 or current brightness is 0 or there is
-     * no link
+    /* Checked once at the end of the batch */
+    if(batchDepth_ != 0)
+    {
+        batchPending_ |= BATCH_PENDING_ACTIVITY;
+        Unlock();
+        return;
+    }
+
+    /* Called by the mutators that change the selected scene, its links,
+     * its patterns brightness or the global brightness. Check if current
+     * scene is 255 or current brightness is 0 or there is no link.
      */
     if(selectedScene_ == 255 ||
-       SystemState::GetInstance()->GetBrightness() == 0 ||
-       scenes_[selectedScene_]->links.size() == 0)
+       isLit_ == false ||
+       scenes_[selectedScene_]->links.Size() == 0)
     {
         Unlock();
         Disable();
         return;
     }
 
-    /* For all links, check if patterns brightness is greater than 0 */
-    for(const std::pair<uint8_t, std::shared_ptr<LEDStrip>>& krStrip : strips_)
+    /* For all links, check if patterns and links brightness are greater
+     * than 0. The strips and the links are both sorted by strip identifier
+     * and are walked together.
+     */
+    kpLink     = scenes_[selectedScene_]->links.begin();
+    kpLinksEnd = scenes_[selectedScene_]->links.end();
+    for(const std::shared_ptr<LEDStrip>& krStrip : strips_)
     {
-        if(scenes_[selectedScene_]->links.count(krStrip.first) != 0)
+        while(kpLink != kpLinksEnd && kpLink->stripId < krStrip->GetId())
+        {
+            ++kpLink;
+        }
+
+        if(kpLink != kpLinksEnd &&
+           kpLink->stripId == krStrip->GetId() &&
+           patterns_.Contains(kpLink->patternId) == true)
         {
-            patternId = scenes_[selectedScene_]->links[krStrip.first];
-            if(patterns_[patternId]->GetBrightness() == 0)
+            /* A pattern updated to the other color mode is not shown */
+            if((*patterns_.Find(kpLink->patternId))->GetBrightness() == 0 ||
+               (*patterns_.Find(kpLink->patternId))->IsIndexed() !=
+               krStrip->IsIndexed() ||
+               kpLink->params.brightness == 0)
             {
-                krStrip.second->SetEnabled(false);
+                isStripsUpdate |= krStrip->RequestEnabled(false);
             }
             else
             {
+                isStripsUpdate |= krStrip->RequestEnabled(true);
                 hasEnabled = true;
             }
         }
         else
         {
-            krStrip.second->SetEnabled(false);
+            isStripsUpdate |= krStrip->RequestEnabled(false);
         }
     }
+    if(isStripsUpdate == true)
+    {
+        PublishStripsEnable();
+    }
 
     Unlock();
 
@@ -473,216 +667,1348 @@ void StripsManager::CheckForActivity(void)
     }
 }
 
+void StripsManager::PublishStripsEnable(void)
+{
+    /* Applied by the worker before its next frame */
+    stripsUpdate_.store(true, std::memory_order_release);
+    WakeWorker(WORKER_WAKE_STRIPS);
+}
+
+bool StripsManager::UpdateStripsEnable(void)
+{
+    bool isPoweredOn;
+
+    /* Called with the work lock held, the helper is idle between the
+     * frames.
+     */
+    isPoweredOn = false;
+    if(stripsUpdate_.exchange(false, std::memory_order_acquire) == true)
+    {
+        /* The pins are not switched during a transmission */
+        pTransmitter_->WaitDone();
+        for(const std::shared_ptr<LEDStrip>& krStrip : strips_)
+        {
+            if(krStrip->UpdateEnabled() == true)
+            {
+                isPoweredOn = true;
+            }
+        }
+    }
+
+    return isPoweredOn;
+}
+
 void StripsManager::Enable(void)
 {
+    xSemaphoreTake(threadWorkLock_, portMAX_DELAY);
     if(isEnabled_ == true)
     {
+        xSemaphoreGive(threadWorkLock_);
         return;
     }
+    isEnabled_  = true;
+    enableTime_ = HWLayer::GetTime();
+    xSemaphoreGive(threadWorkLock_);
 
     LOG_DEBUG("Enabling Strip Manager\n");
 
-    /* Enable the worker thread */
-    vTaskResume(workerThread_);
-
-    isEnabled_ = true;
+    /* Wake the worker thread, the strips were powered off and need a new
+     * frame.
+     */
+    WakeWorker(WORKER_WAKE_ENABLE);
 }
 
 void StripsManager::Disable(void)
 {
+    /* The worker checks the state under the work lock before each frame, it
+     * does not start a new frame once the lock is released.
+     */
+    xSemaphoreTake(threadWorkLock_, portMAX_DELAY);
     if(isEnabled_ == false)
     {
+        xSemaphoreGive(threadWorkLock_);
         return;
     }
+    isEnabled_ = false;
 
-    LOG_DEBUG("Disabling Strip Manager\n");
-
-    /* Disable the worker thread */
-    xSemaphoreTake(threadWorkLock_, portMAX_DELAY);
-
-    vTaskSuspend(workerThread_);
+    /* The worker is between frames and holds no snapshot */
+    workerEpoch_.fetch_add(1, std::memory_order_seq_cst);
 
     xSemaphoreGive(threadWorkLock_);
 
-    isEnabled_ = false;
+    LOG_DEBUG("Disabling Strip Manager\n");
+
+    /* End the frame wait so the worker parks right away */
+    WakeWorker(WORKER_WAKE_SHUTDOWN);
 }
 
 void StripsManager::Kill(void)
 {
     Disable();
-    for(const std::pair<uint8_t, std::shared_ptr<LEDStrip>>& rStrip : strips_)
+    for(const std::shared_ptr<LEDStrip>& krStrip : strips_)
     {
-        rStrip.second->SetEnabled(false);
+        krStrip->RequestEnabled(false);
     }
-}
 
-void StripsManager::Lock(void)
-{
-    xSemaphoreTake(managerLock_, portMAX_DELAY);
+    /* The worker is parked, power off the strips before returning */
+    xSemaphoreTake(threadWorkLock_, portMAX_DELAY);
+    stripsUpdate_.store(true, std::memory_order_relaxed);
+    UpdateStripsEnable();
+    xSemaphoreGive(threadWorkLock_);
 }
 
-void StripsManager::Unlock(void)
+void StripsManager::NotifyBrightnessUpdate(void)
 {
-    xSemaphoreGive(managerLock_);
-}
+    bool isLit;
 
-StripsManager::StripsManager(void)
-{
-    Storage* pStorage;
-    std::vector<std::shared_ptr<Pattern>> patterns;
+    /* The activity only depends on the global brightness being zero */
+    isLit = (SystemState::GetInstance()->GetBrightness() != 0);
+    if(isLit != isLit_)
+    {
+        isLit_ = isLit;
+        UpdateActivity();
+    }
 
-    isEnabled_ = true;
+    WakeWorker(WORKER_WAKE_BRIGHTNESS);
+}
 
-    /* Init locks */
-    managerLock_    = xSemaphoreCreateBinary();
-    threadWorkLock_ = xSemaphoreCreateMutex();
-    xSemaphoreGive(managerLock_);
+void StripsManager::GetLockStats(SLockStats& rStats)
+{
+    uint64_t timeNow;
 
-    /* Add Cross/ strip */
-    AddStrip(std::make_shared<LEDStripC<GPIO_NUM_4, GPIO_NUM_6, 120>>("Cross/"));
-    AddStrip(std::make_shared<LEDStripC<GPIO_NUM_5, GPIO_NUM_7, 70>>("Cross\\"));
+    /* Not counted as an acquisition */
+    xSemaphoreTakeRecursive(managerLock_, portMAX_DELAY);
 
-    pStorage = Storage::GetInstance();
+    rStats.acquisitions = lockCount_.load(std::memory_order_relaxed);
+    rStats.perSecond    = lockRate_.load(std::memory_order_relaxed);
 
-    /* Get patterns from storage */
-    pStorage->GetPatterns(patterns);
-    for(const std::shared_ptr<Pattern>& krPattern : patterns)
+    /* The rate is only updated by the next acquisition, report the rate of
+     * the current window when it is over.
+     */
+    timeNow = HWLayer::GetTime();
+    if(timeNow - lockWindowStart_ >= LOCK_RATE_WINDOW_US)
     {
-        patterns_.emplace(krPattern->GetId(), krPattern);
+        rStats.perSecond = (uint64_t)(rStats.acquisitions - lockWindowCount_) *
+                           1000000 /
+                           (timeNow - lockWindowStart_);
     }
 
-    /* Get scenes from storage */
-    pStorage->GetScenes(scenes_);
-    ActivateScene();
-
-    /* Start worker thread */
-    xTaskCreatePinnedToCore(UpdateRoutine,
-                            "LEDWorker",
-                            4096,
-                            this,
-                            0,
-                            &workerThread_,
-                            1);
-
-    LOG_INFO("Strip Manager Initialized.\n");
-}
-
-void StripsManager::AddStrip(std::shared_ptr<LEDStrip> newStrip)
-{
-    strips_[newStrip->GetId()] = newStrip;
-    LOG_DEBUG("Added new strip %s.\n", newStrip->GetName().c_str())
+    xSemaphoreGiveRecursive(managerLock_);
 }
 
-void StripsManager::ActivateScene(void)
+void StripsManager::GetHeapReport(SHeapReport& rReport)
 {
-    std::unordered_map<uint8_t, std::shared_ptr<LEDStrip>>::iterator it;
+    std::vector<std::shared_ptr<Pattern>> patterns;
 
     Lock();
 
-    /* Check for active scene */
-    if(selectedScene_ == 255)
+    patterns_.GetPatterns(patterns);
+
+    rReport.patternCount = patterns.size();
+    rReport.patternsSize = 0;
+    for(const std::shared_ptr<Pattern>& krPattern : patterns)
     {
-        Unlock();
-        return;
+        rReport.patternsSize += krPattern->GetHeapSize();
     }
+    rReport.tableSize = patterns_.GetHeapSize() +
+                        linkIndex_.GetHeapSize() +
+                        scenes_.capacity() * sizeof(std::shared_ptr<SScene>);
 
-    /* Update colors for all strips in the scene */
-    for(it = strips_.begin(); it != strips_.end(); ++it)
+    rReport.sceneCount = scenes_.size();
+    rReport.scenesSize = 0;
+    for(const std::shared_ptr<SScene>& krScene : scenes_)
     {
-        if(scenes_[selectedScene_]->links.count(it->first) == 0)
-        {
-            it->second->SetEnabled(false);
-        }
-        else
+        rReport.scenesSize += sizeof(SScene) + krScene->links.GetHeapSize();
+        /* Short names are stored in the string object itself */
+        if(krScene->name.data() < (const char*)krScene.get() ||
+           krScene->name.data() >= (const char*)(krScene.get() + 1))
         {
-            it->second->SetEnabled(true);
-            it->second->UpdateColors();
+            rReport.scenesSize += krScene->name.capacity() + 1;
         }
     }
 
     Unlock();
 }
 
-void StripsManager::UpdateRoutine(void* objThis)
+void StripsManager::Lock(void)
 {
-    uint64_t       startTime;
-    uint64_t       diffTime;
-    StripsManager* pManager;
-    std::unordered_map<uint8_t, uint16_t>::const_iterator it;
-
-    pManager = (StripsManager*)objThis;
+    uint32_t count;
+    uint64_t timeNow;
 
-    LOG_DEBUG("Worker thread on core %d\n", xPortGetCoreID());
+    xSemaphoreTakeRecursive(managerLock_, portMAX_DELAY);
 
-    while(1)
+    /* Update the acquisitions rate once per window */
+    count   = lockCount_.fetch_add(1, std::memory_order_relaxed) + 1;
+    timeNow = HWLayer::GetTime();
+    if(timeNow - lockWindowStart_ >= LOCK_RATE_WINDOW_US)
     {
-        startTime = HWLayer::GetTime();
-        xSemaphoreTake(pManager->threadWorkLock_, portMAX_DELAY);
-        /* Update general brightness */
-        FastLED.setBrightness(SystemState::GetInstance()->GetBrightness());
-
-        pManager->Lock();
-        if(pManager->selectedScene_ != 255)
-        {
-            const std::unordered_map<uint8_t, uint16_t>& krLinks =
-                pManager->scenes_[pManager->selectedScene_]->links;
-            for(it = krLinks.begin(); it != krLinks.end(); ++it)
-            {
-                if(it->second != NO_PATTERN)
-                {
-                    /* Apply linked patterns */
-                    pManager->strips_[it->first]->Apply(pManager->patterns_[it->second].get());
-                }
-            }
-        }
-        else
-        {
-            FastLED.setBrightness(0);
-        }
-        pManager->Unlock();
-
-        /* Show and delay */
-        FastLED.show();
-        xSemaphoreGive(pManager->threadWorkLock_);
-        diffTime = HWLayer::GetTime() - startTime;
-
-        if(diffTime < UPDATE_ROUTINE_DELAY_US)
-        {
-            FastLED.delay((UPDATE_ROUTINE_DELAY_US - diffTime) / 1000);
-        }
+        lockRate_.store((uint64_t)(count - lockWindowCount_) * 1000000 /
+                        (timeNow - lockWindowStart_),
+                        std::memory_order_relaxed);
+        lockWindowStart_ = timeNow;
+        lockWindowCount_ = count;
     }
 }
 
-void StripsManager::SavePatterns(void)
+void StripsManager::Unlock(void)
 {
-    std::vector<std::shared_ptr<Pattern>> savedPatterns;
+    xSemaphoreGiveRecursive(managerLock_);
+}
 
+void StripsManager::BeginBatch(void)
+{
+    /* Released by CommitBatch */
     Lock();
+    ++batchDepth_;
+}
+
+void StripsManager::CommitBatch(void)
+{
+    uint8_t pending;
+
+    /* The lock is held since BeginBatch */
+    --batchDepth_;
+    if(batchDepth_ != 0)
+    {
+        Unlock();
+        return;
+    }
+
+    pending       = batchPending_;
+    batchPending_ = 0;
 
-    for(const std::pair<uint16_t, std::shared_ptr<Pattern>>& krPattern : patterns_)
+    /* Publish all the edits at once */
+    if((pending & BATCH_PENDING_PLAN) != 0)
     {
-        savedPatterns.push_back(krPattern.second);
+        BuildRenderPlan((pending & BATCH_PENDING_RESTART) != 0);
     }
 
     Unlock();
 
-    Storage::GetInstance()->SavePatterns(savedPatterns);
+    if((pending & BATCH_PENDING_ACTIVITY) != 0)
+    {
+        UpdateActivity();
+    }
+    if((pending & BATCH_PENDING_SCENES) != 0)
+    {
+        SaveScenes();
+    }
+    if((pending & BATCH_PENDING_SELECTED) != 0)
+    {
+        SaveSelectedScene();
+    }
+
+    LOG_DEBUG("Committed batch\n");
 }
 
-void StripsManager::SaveScenes(void)
+StripsManager::StripsManager(void)
 {
-    std::vector<std::shared_ptr<SScene>> savedScenes;
+    Storage* pStorage;
+    std::vector<std::shared_ptr<Pattern>> patterns;
+    size_t                                i;
+    std::vector<SStripConfig>             stripsConfig;
+    SHeapReport                           heapReport;
+    esp_timer_create_args_t               frameTimerArgs;
+
+    isEnabled_     = true;
+    enableTime_    = 0;
+    stripsUpdate_.store(false);
+    selectedScene_ = 255;
+    sceneSelectTime_ = 0;
+    planRevision_  = 0;
+    planSequence_  = 0;
+    workerThread_  = nullptr;
+    renderThread_  = nullptr;
+    pHelperSnapshot_ = nullptr;
+    helperFrameTime_ = 0;
+    batchDepth_      = 0;
+    batchPending_    = 0;
+
+    lockWindowStart_ = HWLayer::GetTime();
+    lockWindowCount_ = 0;
+    lockCount_.store(0);
+    lockRate_.store(0);
+
+    /* Init locks, the manager lock is a mutex for priority inheritance. It
+     * is recursive so the edits of a batch can take it again.
+     */
+    managerLock_    = xSemaphoreCreateRecursiveMutex();
+    threadWorkLock_ = xSemaphoreCreateMutex();
+    renderDoneSem_  = xSemaphoreCreateBinary();
+    frameGapSem_    = xSemaphoreCreateBinary();
+    flashDoneSem_   = xSemaphoreCreateBinary();
+    frameGapEnd_    = FRAME_GAP_UNBOUNDED;
+    isFlashWriting_.store(false);
+
+    /* Init the frame timer, it wakes the worker before its frame deadlines */
+    frameTimerArgs = {
+        .callback              = FrameTimerRoutine,
+        .arg                   = this,
+        .dispatch_method       = ESP_TIMER_TASK,
+        .name                  = "LED Frame",
+        .skip_unhandled_events = true
+    };
+    esp_timer_create(&frameTimerArgs, &frameTimer_);
+
+    /* Init the render snapshot */
+    workerEpoch_.store(0);
+    pRenderSnapshot_.store(new SRenderSnapshot());
+    pRenderSnapshot_.load()->isActive   = false;
+    pRenderSnapshot_.load()->isAnimated = false;
+    pRenderSnapshot_.load()->sequence   = planSequence_;
+    pRenderSnapshot_.load()->framePeriodUs = 1000000 / SCENE_FPS_DEFAULT;
+    framePeriodUs_.store(1000000 / SCENE_FPS_DEFAULT);
+    pRenderSnapshot_.load()->hasHelperWork = false;
+    pRenderSnapshot_.load()->selectTime    = 0;
+    pRenderSnapshot_.load()->transition    = LED_TRANSITION_CUT;
+    pRenderSnapshot_.load()->transitionUs  = 0;
+    ResetFrameStats();
 
-    Lock();
+    pStorage = Storage::GetInstance();
 
-    savedScenes = scenes_;
+    /* Create the strips from the stored layout */
+    pStorage->GetStrips(stripsConfig);
+    CreateStrips(stripsConfig);
 
-    Unlock();
+    /* Get patterns from storage */
+    pStorage->GetPatterns(patterns);
+    for(const std::shared_ptr<Pattern>& krPattern : patterns)
+    {
+        if(patterns_.Insert(krPattern) == false)
+        {
+            LOG_ERROR("Could not load pattern %d\n", krPattern->GetId());
+        }
+    }
+
+    /* Get scenes from storage, links to unknown patterns are dropped */
+    pStorage->GetScenes(scenes_);
+    for(i = 0; i < scenes_.size(); ++i)
+    {
+        for(const SSceneLink& krLink : SceneLinks(scenes_[i]->links))
+        {
+            if(patterns_.Contains(krLink.patternId) == false)
+            {
+                LOG_ERROR("Scene %d links unknown pattern %d\n",
+                          i,
+                          krLink.patternId);
+                scenes_[i]->links.Erase(krLink.stripId);
+            }
+        }
+        linkIndex_.AddScene(i, scenes_[i]->links);
+    }
+    if(pStorage->GetSelectedScene() < scenes_.size())
+    {
+        selectedScene_ = pStorage->GetSelectedScene();
+    }
+    ActivateScene();
+
+    GetHeapReport(heapReport);
+    LOG_INFO("Heap: %d patterns (%d bytes), %d scenes (%d bytes), "
+             "tables %d bytes\n",
+             heapReport.patternCount,
+             heapReport.patternsSize,
+             heapReport.sceneCount,
+             heapReport.scenesSize,
+             heapReport.tableSize);
+
+    /* Start the output stage, the render helper and the worker thread, the
+     * helper and the worker are configured on different cores.
+     */
+    pTransmitter_ = std::make_shared<FastLEDTransmitter>();
+    renderThread_ = TaskMonitor::GetInstance()->CreateTask(TASK_LED_RENDER,
+                                                           RenderRoutine,
+                                                           this);
+    workerThread_ = TaskMonitor::GetInstance()->CreateTask(TASK_LED_WORKER,
+                                                           UpdateRoutine,
+                                                           this);
+
+    /* The storage writes the flash between the frames */
+    pStorage->SetWriteGate(FrameGapRoutine, FrameGapDoneRoutine, this);
+
+    /* Initial activity, then only updated when one of its inputs changes */
+    isLit_ = (SystemState::GetInstance()->GetBrightness() != 0);
+    UpdateActivity();
+
+    LOG_INFO("Strip Manager Initialized.\n");
+}
+
+bool StripsManager::ValidateStrips(const std::vector<SStripConfig>& krConfigs,
+                                   std::vector<bool>&               rIsValid)
+{
+    size_t i;
+    size_t j;
+    bool   isLayoutValid;
+
+    isLayoutValid = true;
+    rIsValid.assign(krConfigs.size(), true);
+    for(i = 0; i < krConfigs.size(); ++i)
+    {
+        if(krConfigs[i].numLed == 0)
+        {
+            LOG_ERROR("Strip %s has no LED\n", krConfigs[i].name.c_str());
+            rIsValid[i] = false;
+        }
+        for(j = 0; j < i && rIsValid[i] == true; ++j)
+        {
+            if(rIsValid[j] == true &&
+               krConfigs[j].ctrlGPIO == krConfigs[i].ctrlGPIO)
+            {
+                LOG_ERROR("Strip %s reuses GPIO %d\n",
+                          krConfigs[i].name.c_str(),
+                          krConfigs[i].ctrlGPIO);
+                rIsValid[i] = false;
+            }
+        }
+        if(rIsValid[i] == false)
+        {
+            isLayoutValid = false;
+        }
+    }
+
+    return isLayoutValid;
+}
+
+void StripsManager::CreateStrips(const std::vector<SStripConfig>& krConfigs)
+{
+    size_t                     i;
+    size_t                     sramSize;
+    size_t                     psramSize;
+    std::vector<bool>          isValid;
+    std::vector<size_t>        buffersSize;
+    std::shared_ptr<LEDStripC> newStrip;
+
+    /* Validate the layout and size the arenas, the big strips go in PSRAM */
+    sramSize  = 0;
+    psramSize = 0;
+    ValidateStrips(krConfigs, isValid);
+    buffersSize.assign(krConfigs.size(), 0);
+    for(i = 0; i < krConfigs.size(); ++i)
+    {
+        if(isValid[i] == false)
+        {
+            continue;
+        }
+
+        buffersSize[i] = LEDStripC::GetBuffersSize(krConfigs[i].numLed,
+                                                   krConfigs[i].isIndexed);
+        if(buffersSize[i] > LED_STRIP_SRAM_MAX_SIZE)
+        {
+            psramSize += buffersSize[i];
+        }
+        else
+        {
+            sramSize += buffersSize[i];
+        }
+    }
+
+    pSramArena_  = std::make_shared<PixelArena>(sramSize, false);
+    pPsramArena_ = std::make_shared<PixelArena>(psramSize, true);
+
+    /* Create the strips */
+    for(i = 0; i < krConfigs.size(); ++i)
+    {
+        if(isValid[i] == false)
+        {
+            continue;
+        }
+
+        if(buffersSize[i] > LED_STRIP_SRAM_MAX_SIZE)
+        {
+            newStrip = std::make_shared<LEDStripC>(krConfigs[i], *pPsramArena_);
+        }
+        else
+        {
+            newStrip = std::make_shared<LEDStripC>(krConfigs[i], *pSramArena_);
+        }
+
+        if(newStrip->IsReady() == true)
+        {
+            AddStrip(newStrip);
+        }
+        else
+        {
+            LOG_ERROR("Could not create strip %s\n",
+                      krConfigs[i].name.c_str());
+        }
+    }
+
+    LOG_INFO("Strips buffers: %d bytes SRAM, %d bytes PSRAM\n",
+             pSramArena_->GetUsedSize(),
+             pPsramArena_->GetUsedSize());
+}
+
+void StripsManager::AddStrip(const std::shared_ptr<LEDStrip>& krNewStrip)
+{
+    std::vector<std::shared_ptr<LEDStrip>>::iterator it;
+
+    /* Keep the strips sorted by identifier */
+    it = strips_.begin();
+    while(it != strips_.end() && (*it)->GetId() < krNewStrip->GetId())
+    {
+        ++it;
+    }
+    strips_.insert(it, krNewStrip);
+    LOG_DEBUG("Added new strip %s.\n", krNewStrip->GetName().c_str());
+}
+
+bool StripsManager::CheckSceneLinks(const SScene& krScene) const
+{
+    const LEDStrip* kpStrip;
+
+    /* The strips buffers are sized for their color mode */
+    for(const SSceneLink& krLink : krScene.links)
+    {
+        kpStrip = FindStrip(krLink.stripId);
+        if(kpStrip == nullptr ||
+           patterns_.Contains(krLink.patternId) == false ||
+           (*patterns_.Find(krLink.patternId))->IsIndexed() !=
+           kpStrip->IsIndexed())
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+LEDStrip* StripsManager::FindStrip(const uint8_t kStripId) const
+{
+    size_t low;
+    size_t high;
+    size_t middle;
+
+    low  = 0;
+    high = strips_.size();
+    while(low < high)
+    {
+        middle = (low + high) / 2;
+        if(strips_[middle]->GetId() < kStripId)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+
+    if(low < strips_.size() && strips_[low]->GetId() == kStripId)
+    {
+        return strips_[low].get();
+    }
+
+    return nullptr;
+}
+
+void StripsManager::ActivateScene(void)
+{
+    bool isStripsUpdate;
+
+    isStripsUpdate = false;
+
+    Lock();
+
+    /* Check for active scene */
+    if(selectedScene_ == 255)
+    {
+        Unlock();
+        return;
+    }
+
+    /* Enable the strips used in the scene */
+    for(const std::shared_ptr<LEDStrip>& krStrip : strips_)
+    {
+        if(scenes_[selectedScene_]->links.Find(krStrip->GetId()) == nullptr)
+        {
+            isStripsUpdate |= krStrip->RequestEnabled(false);
+        }
+        else
+        {
+            isStripsUpdate |= krStrip->RequestEnabled(true);
+        }
+    }
+    if(isStripsUpdate == true)
+    {
+        PublishStripsEnable();
+    }
+
+    /* Publish the scene, all strips restart their patterns */
+    BuildRenderPlan(true);
+
+    Unlock();
+}
+
+void StripsManager::BuildRenderPlan(const bool kRestart)
+{
+    SRenderSnapshot* pNewSnapshot;
+    SRenderSnapshot* pOldSnapshot;
+    uint32_t         revision;
+    uint8_t          fps;
+
+    std::shared_ptr<const SPatternProgram> program;
+    std::shared_ptr<SPatternProgram>       newProgram;
+
+    LEDStrip*                       pStrip;
+    const std::shared_ptr<Pattern>* kpPattern;
+    SPatternHandle                  patternHandle;
+
+    /* Must be called with the manager lock held. Published once at the end
+     * of the batch.
+     */
+    if(batchDepth_ != 0)
+    {
+        batchPending_ |= BATCH_PENDING_PLAN;
+        if(kRestart == true)
+        {
+            batchPending_ |= BATCH_PENDING_RESTART;
+        }
+        return;
+    }
+
+    pOldSnapshot = pRenderSnapshot_.load(std::memory_order_relaxed);
+
+    pNewSnapshot = new SRenderSnapshot();
+    pNewSnapshot->isActive   = (selectedScene_ != 255 &&
+                                selectedScene_ < scenes_.size());
+    pNewSnapshot->isAnimated = false;
+    pNewSnapshot->sequence   = ++planSequence_;
+    pNewSnapshot->framePeriodUs = 1000000 / SCENE_FPS_DEFAULT;
+    pNewSnapshot->selectTime    = sceneSelectTime_;
+    pNewSnapshot->transition    = LED_TRANSITION_CUT;
+    pNewSnapshot->transitionUs  = 0;
+
+    /* Resolve the links of the active scene once, the worker then iterates
+     * the plan without any lookup.
+     */
+    if(pNewSnapshot->isActive == true)
+    {
+        fps = scenes_[selectedScene_]->fps;
+        if(fps > SCENE_FPS_MAX)
+        {
+            fps = SCENE_FPS_MAX;
+        }
+        if(fps != 0)
+        {
+            pNewSnapshot->framePeriodUs = 1000000 / fps;
+        }
+
+        /* Only a scene selection transitions, edits of the scene are cuts */
+        if(sceneSelectTime_ != 0 &&
+           scenes_[selectedScene_]->transition <= LED_TRANSITION_MAX)
+        {
+            pNewSnapshot->transition   = scenes_[selectedScene_]->transition;
+            pNewSnapshot->transitionUs =
+                (uint32_t)scenes_[selectedScene_]->transitionMs * 1000;
+        }
+        sceneSelectTime_ = 0;
+
+        pNewSnapshot->steps.reserve(scenes_[selectedScene_]->links.Size());
+        for(const SSceneLink& krLink : scenes_[selectedScene_]->links)
+        {
+            if(krLink.patternId == NO_PATTERN)
+            {
+                continue;
+            }
+
+            pStrip    = FindStrip(krLink.stripId);
+            kpPattern = patterns_.Find(krLink.patternId);
+            if(pStrip == nullptr || kpPattern == nullptr)
+            {
+                LOG_ERROR("Scene %d links unknown strip %d or pattern %d\n",
+                          selectedScene_,
+                          krLink.stripId,
+                          krLink.patternId);
+                continue;
+            }
+            if((*kpPattern)->IsIndexed() != pStrip->IsIndexed())
+            {
+                LOG_ERROR("Pattern %d color mode does not match strip %d\n",
+                          krLink.patternId,
+                          krLink.stripId);
+                continue;
+            }
+            patternHandle = patterns_.GetHandle(krLink.patternId);
+
+            /* Keep the revision and program of unchanged steps so they keep
+             * animating.
+             */
+            revision = 0;
+            program  = nullptr;
+            if(kRestart == false)
+            {
+                for(const SRenderStep& krOldStep : pOldSnapshot->steps)
+                {
+                    if(krOldStep.pStrip == pStrip &&
+                       krOldStep.patternHandle.id == patternHandle.id &&
+                       krOldStep.patternHandle.generation ==
+                       patternHandle.generation &&
+                       SceneLinks::IsSameParams(krOldStep.params,
+                                                krLink.params) == true)
+                    {
+                        revision = krOldStep.revision;
+                        program  = krOldStep.program;
+                        break;
+                    }
+                }
+            }
+            if(revision == 0)
+            {
+                /* Compile the pattern for the strip it is linked to */
+                newProgram = std::make_shared<SPatternProgram>();
+                if(PatternCompiler::Compile(**kpPattern,
+                                            pStrip->GetLedCount(),
+                                            *newProgram) == false)
+                {
+                    LOG_ERROR("Could not compile pattern %d for strip %d\n",
+                              krLink.patternId,
+                              krLink.stripId);
+                    continue;
+                }
+                program = newProgram;
+
+                revision = ++planRevision_;
+                if(revision == 0)
+                {
+                    revision = ++planRevision_;
+                }
+            }
+
+            pNewSnapshot->steps.push_back({
+                .pStrip        = pStrip,
+                .pattern       = *kpPattern,
+                .patternHandle = patternHandle,
+                .params        = krLink.params,
+                .program       = program,
+                .revision      = revision,
+                .renderer      = RENDERER_WORKER
+            });
+
+            if(program->animOps.size() != 0)
+            {
+                pNewSnapshot->isAnimated = true;
+            }
+        }
+    }
+
+    BalanceRenderPlan(*pNewSnapshot, RENDERER_COUNT);
+
+    /* Publish and retire the previous snapshot. The epoch is read after the
+     * publication is visible, as the worker loads the snapshot and moves its
+     * epoch, so a frame still using the old snapshot holds it back.
+     */
+    framePeriodUs_.store(pNewSnapshot->framePeriodUs);
+    pRenderSnapshot_.store(pNewSnapshot, std::memory_order_seq_cst);
+    retiredSnapshots_.push_back({
+        .pSnapshot   = pOldSnapshot,
+        .retireEpoch = workerEpoch_.load(std::memory_order_seq_cst)
+    });
+
+    ReclaimSnapshots();
+
+    if(kRestart == true)
+    {
+        WakeWorker(WORKER_WAKE_SCENE);
+    }
+    else
+    {
+        WakeWorker(WORKER_WAKE_PATTERN);
+    }
+}
+
+void StripsManager::BalanceRenderPlan(SRenderSnapshot& rSnapshot,
+                                      const uint8_t    kRendererCount)
+{
+    size_t   i;
+    size_t   maxIdx;
+    uint32_t maxCost;
+    uint8_t  renderer;
+    std::vector<uint32_t> costs;
+    std::vector<uint32_t> loads;
+
+    /* Assign the most expensive remaining step to the least loaded
+     * renderer. The plans hold a few steps, the quadratic search is cheaper
+     * than sorting.
+     */
+    costs.resize(rSnapshot.steps.size());
+    for(i = 0; i < rSnapshot.steps.size(); ++i)
+    {
+        costs[i] = GetRenderCost(*rSnapshot.steps[i].program);
+    }
+
+    loads.assign(kRendererCount, 0);
+    rSnapshot.hasHelperWork = false;
+    while(true)
+    {
+        maxIdx  = costs.size();
+        maxCost = 0;
+        for(i = 0; i < costs.size(); ++i)
+        {
+            if(costs[i] != 0 && costs[i] > maxCost)
+            {
+                maxCost = costs[i];
+                maxIdx  = i;
+            }
+        }
+        if(maxIdx == costs.size())
+        {
+            break;
+        }
+
+        /* The worker also presents the frames, it is loaded first only on
+         * ties.
+         */
+        renderer = RENDERER_WORKER;
+        for(i = 1; i < loads.size(); ++i)
+        {
+            if(loads[i] < loads[renderer])
+            {
+                renderer = i;
+            }
+        }
+        rSnapshot.steps[maxIdx].renderer = renderer;
+        loads[renderer] += maxCost;
+        if(renderer != RENDERER_WORKER)
+        {
+            rSnapshot.hasHelperWork = true;
+        }
+        costs[maxIdx] = 0;
+    }
+}
+
+void StripsManager::ReclaimSnapshots(void)
+{
+    uint32_t epoch;
+    std::vector<SRetiredSnapshot>::iterator it;
+
+    /* Must be called with the manager lock held. A snapshot retired at epoch
+     * E can only be used by the frame that was running at E, once the worker
+     * epoch moved past E it is not referenced anymore.
+     */
+    epoch = workerEpoch_.load(std::memory_order_acquire);
+    for(it = retiredSnapshots_.begin(); it != retiredSnapshots_.end();)
+    {
+        if((int32_t)(epoch - it->retireEpoch) > 0)
+        {
+            delete it->pSnapshot;
+            it = retiredSnapshots_.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+void StripsManager::FrameTimerRoutine(void* pObjThis)
+{
+    ((StripsManager*)pObjThis)->WakeWorker(WORKER_WAKE_DEADLINE);
+}
+
+void StripsManager::WakeWorker(const uint32_t kReasons)
+{
+    if(workerThread_ != nullptr)
+    {
+        xTaskNotify(workerThread_, kReasons, eSetBits);
+    }
+}
+
+void StripsManager::UpdateRoutine(void* objThis)
+{
+    uint64_t               startTime;
+    uint64_t               endTime;
+    uint64_t               lastStartTime;
+    uint64_t               deadline;
+    uint64_t               shownTime;
+    uint64_t               selectTime;
+    uint32_t               lastSequence;
+    uint32_t               shownSequence;
+    uint32_t               transitionSequence;
+    uint32_t               reasons;
+    uint32_t               wakeReasons;
+    uint8_t                brightness;
+    uint8_t                lastBrightness;
+    bool                   frameChanged;
+    bool                   isParked;
+    StripsManager*         pManager;
+    const SRenderSnapshot* pSnapshot;
+
+    pManager = (StripsManager*)objThis;
+
+    lastSequence   = 0;
+    shownSequence  = 0;
+    transitionSequence = 0;
+    lastBrightness = 0;
+    lastStartTime  = 0;
+    deadline       = 0;
+
+    /* The first frame is always sent */
+    reasons = WORKER_WAKE_ENABLE;
+
+    LOG_DEBUG("Worker thread on core %d\n", xPortGetCoreID());
+
+    while(1)
+    {
+        /* A change is rendered on the next frame of the schedule */
+        reasons |= pManager->WaitNextFrame(deadline, lastStartTime);
+
+        startTime = HWLayer::GetTime();
+        xSemaphoreTake(pManager->threadWorkLock_, portMAX_DELAY);
+
+        /* Apply the strips power requests, a strip powered on needs a new
+         * frame.
+         */
+        if(pManager->UpdateStripsEnable() == true)
+        {
+            reasons |= WORKER_WAKE_ENABLE;
+        }
+
+        /* Disabled, park until a wake up reason is received. The schedule
+         * is kept for a short park.
+         */
+        if(pManager->isEnabled_ == false)
+        {
+            pManager->frameGapEnd_ = FRAME_GAP_UNBOUNDED;
+            xSemaphoreGive(pManager->threadWorkLock_);
+            xSemaphoreGive(pManager->frameGapSem_);
+            xTaskNotifyWait(0, 0xFFFFFFFF, &wakeReasons, portMAX_DELAY);
+            reasons |= wakeReasons;
+            continue;
+        }
+
+        /* The flash is not written while the frame is rendered */
+        pManager->frameGapEnd_ = 0;
+
+        /* Update general brightness */
+        brightness = SystemState::GetInstance()->GetBrightness();
+
+        /* Get the published snapshot, no lock is needed. The frame is
+         * rendered in the back buffers while the previous one is sent.
+         */
+        pSnapshot = pManager->pRenderSnapshot_.load(std::memory_order_seq_cst);
+        if(pSnapshot->isActive == true)
+        {
+            /* First frame of a selected scene, the strips transition from
+             * the frame they show.
+             */
+            if(pSnapshot->sequence != transitionSequence)
+            {
+                transitionSequence = pSnapshot->sequence;
+                if(pSnapshot->transition != LED_TRANSITION_CUT)
+                {
+                    for(const SRenderStep& krStep : pSnapshot->steps)
+                    {
+                        krStep.pStrip->StartTransition(
+                                                pSnapshot->transition,
+                                                pSnapshot->transitionUs,
+                                                startTime);
+                    }
+                }
+            }
+
+            /* Start the render helper on the other core */
+            if(pSnapshot->hasHelperWork == true)
+            {
+                pManager->pHelperSnapshot_ = pSnapshot;
+                pManager->helperFrameTime_ = startTime;
+                xTaskNotifyGive(pManager->renderThread_);
+            }
+
+            /* Apply linked patterns */
+            for(const SRenderStep& krStep : pSnapshot->steps)
+            {
+                if(krStep.renderer == RENDERER_WORKER)
+                {
+                    krStep.pStrip->Apply(krStep.program.get(),
+                                         krStep.params,
+                                         krStep.revision,
+                                         startTime);
+                }
+            }
+
+            /* Frame barrier, all the strips are rendered before output */
+            if(pSnapshot->hasHelperWork == true)
+            {
+                xSemaphoreTake(pManager->renderDoneSem_, portMAX_DELAY);
+            }
+        }
+        else
+        {
+            brightness = 0;
+        }
+
+        /* The strips were powered off and need a new frame */
+        frameChanged = (pSnapshot->sequence != lastSequence ||
+                        brightness != lastBrightness ||
+                        (reasons & WORKER_WAKE_ENABLE) != 0);
+        reasons = 0;
+
+        /* Wait for the previous frame, swap the buffers and send only if
+         * the frame changed.
+         */
+        pManager->pTransmitter_->WaitDone();
+        for(const SRenderStep& krStep : pSnapshot->steps)
+        {
+            if(krStep.pStrip->Present() == true)
+            {
+                frameChanged = true;
+            }
+        }
+        if(frameChanged == true)
+        {
+            /* A flash write admitted in the previous gap ends first, the
+             * frame is never sent during a write.
+             */
+            while(pManager->isFlashWriting_.load() == true)
+            {
+                xSemaphoreTake(pManager->flashDoneSem_, portMAX_DELAY);
+            }
+            pManager->pTransmitter_->Transmit(brightness,
+                                             pSnapshot->framePeriodUs);
+            lastSequence   = pSnapshot->sequence;
+            lastBrightness = brightness;
+
+            /* First frame of a selected scene, wait for the end of the
+             * transmission to measure the selection latency. The strips may
+             * have been enabled after the selection.
+             */
+            if(pSnapshot->selectTime != 0 &&
+               pSnapshot->sequence != shownSequence)
+            {
+                pManager->pTransmitter_->WaitDone();
+                shownTime  = HWLayer::GetTime();
+                selectTime = pSnapshot->selectTime;
+                if(pManager->enableTime_ > selectTime)
+                {
+                    selectTime = pManager->enableTime_;
+                }
+                pManager->frameStats_.sceneLatencyUs = shownTime - selectTime;
+                if(pManager->frameStats_.sceneLatencyUs >
+                   pManager->frameStats_.worstSceneLatencyUs)
+                {
+                    pManager->frameStats_.worstSceneLatencyUs =
+                        pManager->frameStats_.sceneLatencyUs;
+                }
+                shownSequence = pSnapshot->sequence;
+            }
+        }
+
+        endTime = HWLayer::GetTime();
+        pManager->UpdateFrameStats(startTime,
+                                   endTime,
+                                   deadline,
+                                   lastStartTime,
+                                   pSnapshot->framePeriodUs);
+
+        /* Next absolute deadline, a late frame restarts the schedule
+         * instead of rendering the missed frames back to back.
+         */
+        lastStartTime = startTime;
+        if(deadline == 0)
+        {
+            deadline = startTime;
+        }
+        deadline += pSnapshot->framePeriodUs;
+        if(endTime >= deadline)
+        {
+            deadline = endTime;
+        }
+
+        /* Static frame already sent, park until something changes. The flash
+         * can be written until the next frame.
+         */
+        isParked = (frameChanged == false && pSnapshot->isAnimated == false);
+        if(isParked == true)
+        {
+            pManager->frameGapEnd_ = FRAME_GAP_UNBOUNDED;
+        }
+        else
+        {
+            pManager->frameGapEnd_ = deadline;
+        }
+
+        /* Signal that the snapshot is not used anymore */
+        pManager->workerEpoch_.fetch_add(1, std::memory_order_seq_cst);
+        xSemaphoreGive(pManager->threadWorkLock_);
+        xSemaphoreGive(pManager->frameGapSem_);
+
+        if(isParked == true)
+        {
+            xTaskNotifyWait(0, 0xFFFFFFFF, &reasons, portMAX_DELAY);
+        }
+    }
+}
+
+uint32_t StripsManager::WaitNextFrame(uint64_t& rDeadline,
+                                      uint64_t& rLastStartTime)
+{
+    uint64_t timeNow;
+    uint32_t framePeriodUs;
+    uint32_t reasons;
+    uint32_t wakeReasons;
+    bool     isEnabled;
+
+    reasons = 0;
+
+    /* Unscheduled frame */
+    if(rDeadline == 0)
+    {
+        return reasons;
+    }
+
+    /* Parked for more than a frame, the schedule restarts */
+    timeNow       = HWLayer::GetTime();
+    framePeriodUs = framePeriodUs_.load();
+    if(timeNow >= rDeadline + framePeriodUs)
+    {
+        rDeadline      = 0;
+        rLastStartTime = 0;
+        return reasons;
+    }
+
+    do
+    {
+        /* A shorter frame period moves the deadline to its grid */
+        framePeriodUs = framePeriodUs_.load();
+        if(rLastStartTime + framePeriodUs < rDeadline)
+        {
+            rDeadline = rLastStartTime + framePeriodUs;
+        }
+
+        wakeReasons = WaitUntil(rDeadline, frameTimer_);
+        reasons    |= wakeReasons;
+
+        /* A shutdown ends the wait unless the manager was enabled again */
+        if((wakeReasons & WORKER_WAKE_SHUTDOWN) != 0)
+        {
+            xSemaphoreTake(threadWorkLock_, portMAX_DELAY);
+            isEnabled = isEnabled_;
+            xSemaphoreGive(threadWorkLock_);
+            if(isEnabled == false)
+            {
+                break;
+            }
+        }
+    } while(wakeReasons != 0);
+
+    return reasons;
+}
+
+void StripsManager::WaitFrameGap(const uint32_t kStallUs)
+{
+    uint64_t startTime;
+    uint64_t timeNow;
+    uint64_t gapEnd;
+    bool     isSent;
+
+    startTime = HWLayer::GetTime();
+    while(1)
+    {
+        /* The write is admitted under the work lock so the worker sees the
+         * reservation before sending its next frame.
+         */
+        xSemaphoreTake(threadWorkLock_, portMAX_DELAY);
+        gapEnd  = frameGapEnd_;
+        isSent  = (pTransmitter_->IsBusy() == false);
+        timeNow = HWLayer::GetTime();
+        if(gapEnd != 0 && isSent == true &&
+           (gapEnd == FRAME_GAP_UNBOUNDED ||
+            timeNow + kStallUs + FRAME_GAP_MARGIN_US <= gapEnd))
+        {
+            isFlashWriting_.store(true);
+            xSemaphoreGive(threadWorkLock_);
+            return;
+        }
+
+        /* The write does not fit in the frame gaps, do not delay it
+         * forever. It still waits for the end of the transmission.
+         */
+        if(isSent == true && timeNow - startTime >= FRAME_GAP_WAIT_MAX_US)
+        {
+            isFlashWriting_.store(true);
+            xSemaphoreGive(threadWorkLock_);
+            LOG_DEBUG("No frame gap for a %dus flash write\n", kStallUs);
+            return;
+        }
+        xSemaphoreGive(threadWorkLock_);
+
+        /* Poll the end of the transmission, otherwise wait for the next
+         * gap.
+         */
+        if(gapEnd != 0 && isSent == false)
+        {
+            vTaskDelay(1);
+        }
+        else
+        {
+            xSemaphoreTake(frameGapSem_,
+                           pdMS_TO_TICKS(FRAME_GAP_WAIT_MAX_US / 1000));
+        }
+    }
+}
+
+void StripsManager::EndFrameGap(void)
+{
+    isFlashWriting_.store(false);
+    xSemaphoreGive(flashDoneSem_);
+}
+
+void StripsManager::FrameGapRoutine(void* pObjThis, const uint32_t kStallUs)
+{
+    ((StripsManager*)pObjThis)->WaitFrameGap(kStallUs);
+}
+
+void StripsManager::FrameGapDoneRoutine(void* pObjThis)
+{
+    ((StripsManager*)pObjThis)->EndFrameGap();
+}
+
+void StripsManager::RenderRoutine(void* objThis)
+{
+    uint64_t               renderTime;
+    StripsManager*         pManager;
+    const SRenderSnapshot* pSnapshot;
+    TaskMonitor*           pMonitor;
+
+    pManager = (StripsManager*)objThis;
+    pMonitor = TaskMonitor::GetInstance();
+
+    LOG_DEBUG("Render helper thread on core %d\n", xPortGetCoreID());
+
+    while(1)
+    {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        /* The worker holds the snapshot until the frame barrier */
+        pSnapshot = pManager->pHelperSnapshot_;
+        for(const SRenderStep& krStep : pSnapshot->steps)
+        {
+            if(krStep.renderer == RENDERER_HELPER)
+            {
+                krStep.pStrip->Apply(krStep.program.get(),
+                                     krStep.params,
+                                     krStep.revision,
+                                     pManager->helperFrameTime_);
+            }
+        }
+
+        /* The helper part of the frame must fit in the frame period */
+        renderTime = HWLayer::GetTime() - pManager->helperFrameTime_;
+        pMonitor->ReportPeriod(TASK_LED_RENDER,
+                               renderTime > pSnapshot->framePeriodUs);
+
+        xSemaphoreGive(pManager->renderDoneSem_);
+    }
+}
+
+void StripsManager::UpdateFrameStats(const uint64_t kStartTime,
+                                     const uint64_t kEndTime,
+                                     const uint64_t kDeadline,
+                                     const uint64_t kLastStartTime,
+                                     const uint32_t kFramePeriodUs)
+{
+    uint32_t jitter;
+    uint32_t latency;
+    bool     isMissed;
+
+    /* Must be called with the work lock held */
+    frameStats_.framePeriodUs = kFramePeriodUs;
+    ++frameStats_.frameCount;
+
+    /* Unscheduled frames (first frame after parking) only count their
+     * rendering time.
+     */
+    if(kDeadline != 0)
+    {
+        latency = kEndTime - kDeadline;
+        isMissed = (kEndTime >= kDeadline + kFramePeriodUs);
+        if(isMissed == true)
+        {
+            ++frameStats_.missedDeadlines;
+        }
+        TaskMonitor::GetInstance()->ReportPeriod(TASK_LED_WORKER, isMissed);
+    }
+    else
+    {
+        latency = kEndTime - kStartTime;
+    }
+    if(latency > frameStats_.worstLatencyUs)
+    {
+        frameStats_.worstLatencyUs = latency;
+    }
+
+    if(kLastStartTime != 0)
+    {
+        if(kStartTime - kLastStartTime > kFramePeriodUs)
+        {
+            jitter = kStartTime - kLastStartTime - kFramePeriodUs;
+        }
+        else
+        {
+            jitter = kFramePeriodUs - (kStartTime - kLastStartTime);
+        }
+
+        frameStats_.lastJitterUs = jitter;
+        if(jitter > frameStats_.maxJitterUs)
+        {
+            frameStats_.maxJitterUs = jitter;
+        }
+        jitterSum_ += jitter;
+        ++frameStats_.jitterSamples;
+        frameStats_.meanJitterUs = jitterSum_ / frameStats_.jitterSamples;
+    }
+}
+
+void StripsManager::GetFrameStats(SFrameStats& rStats)
+{
+    xSemaphoreTake(threadWorkLock_, portMAX_DELAY);
+    rStats = frameStats_;
+    xSemaphoreGive(threadWorkLock_);
+}
+
+void StripsManager::ResetFrameStats(void)
+{
+    xSemaphoreTake(threadWorkLock_, portMAX_DELAY);
+    memset(&frameStats_, 0, sizeof(SFrameStats));
+    jitterSum_ = 0;
+    xSemaphoreGive(threadWorkLock_);
+}
+
+void StripsManager::SaveScenes(void)
+{
+    std::vector<std::shared_ptr<SScene>> savedScenes;
+
+    Lock();
+
+    if(batchDepth_ != 0)
+    {
+        batchPending_ |= BATCH_PENDING_SCENES;
+        Unlock();
+        return;
+    }
+
+    savedScenes = scenes_;
+
+    Unlock();
 
     Storage::GetInstance()->SaveScenes(savedScenes);
 }
 
-void StripsManager::SaveSelectedScene(void) const
+void StripsManager::SaveSelectedScene(void)
 {
-    Storage::GetInstance()->SaveSelectedScene(selectedScene_);
-}
\ No newline at end of file
+    uint8_t selectedScene;
+
+    Lock();
+
+    if(batchDepth_ != 0)
+    {
+        batchPending_ |= BATCH_PENDING_SELECTED;
+        Unlock();
+        return;
+    }
+
+    selectedScene = selectedScene_;
+
+    Unlock();
+
+    Storage::GetInstance()->SaveSelectedScene(selectedScene);
+}
\ No newline at end of file
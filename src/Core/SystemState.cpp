@@ -26,6 +26,7 @@
 #include <HWLayer.h> /* Hardware layer */
 #include <Storage.h> /* Storage service */
 #include <IOButtonMgr.h> /* Button manager */
+#include <TaskMonitor.h> /* Tasks monitoring */
 
 /* Header File */
 #include <SystemState.h>
@@ -94,6 +95,9 @@ void SystemState::Update(void)
     /* Update the state */
     UpdateState();
 
+    /* Report the tasks that keep missing their deadline */
+    CheckTasks();
+
     /* Manage the state  */
     switch(currentState_)
     {
@@ -170,6 +174,7 @@ void SystemState::SetBrightness(const uint8_t kNewBrightness)
 {
     currentBrightness_ = kNewBrightness;
     Storage::GetInstance()->SaveBrightness(kNewBrightness);
+    StripsManager::GetInstance()->NotifyBrightnessUpdate();
     displayNeedUpdate_ = true;
 }
 
@@ -415,6 +420,36 @@ void SystemState::ManageMenu0(void)
     }
 }
 
+void SystemState::CheckTasks(void)
+{
+    uint8_t      i;
+    EventBits_t  events;
+    STaskStats   stats;
+    TaskMonitor* pMonitor;
+
+    pMonitor = TaskMonitor::GetInstance();
+
+    /* Clear and get the events raised since the last check */
+    events = xEventGroupClearBits(pMonitor->GetEventGroup(),
+                                  (1 << TASK_MAX_ID) - 1);
+    for(i = 0; i < TASK_MAX_ID; ++i)
+    {
+        if((events & (1 << i)) == 0)
+        {
+            continue;
+        }
+
+        pMonitor->GetStats((ETaskId)i, stats);
+        LOG_ERROR("Task %s overruns: %u/%u periods, %u events, "
+                  "%u bytes stack free\n",
+                  TaskMonitor::GetConfig((ETaskId)i).kpName,
+                  stats.overruns,
+                  stats.periods,
+                  stats.missEvents,
+                  stats.stackHighWater);
+    }
+}
+
 void SystemState::ManageMenu1(void)
 {
     Adafruit_SSD1306* pOLEDDisplay;
@@ -480,6 +515,9 @@ void SystemState::Hibernate(const bool kDisplay)
             StripsManager::GetInstance()->Kill();
         }
 
+        /* Write the pending changes before the power goes off */
+        Storage::GetInstance()->Flush();
+
         esp_sleep_pd_config(ESP_PD_DOMAIN_RTC_PERIPH,   ESP_PD_OPTION_OFF);
         esp_sleep_pd_config(ESP_PD_DOMAIN_RTC_SLOW_MEM, ESP_PD_OPTION_OFF);
         esp_sleep_pd_config(ESP_PD_DOMAIN_RTC_FAST_MEM, ESP_PD_OPTION_OFF);
@@ -491,4 +529,4 @@ void SystemState::Hibernate(const bool kDisplay)
     {
         LOG_ERROR("Could not setup deep sleep wakeup (%d)\n", status);
     }
-}
\ No newline at end of file
+}
\ No newline at end of file
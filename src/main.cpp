@@ -28,10 +28,13 @@
 #include <StripsManager.h> /* Strips manager */
 #include <Storage.h>       /* Storage manager */
 #include <IOButtonMgr.h>  /* IO buttons manager */
+#include <TaskMonitor.h>  /* Tasks configuration and monitoring */
 /*******************************************************************************
  * CONSTANTS
  ******************************************************************************/
-/* None */
+
+/* Period of the UI loop */
+#define UI_LOOP_PERIOD_US 25000
 
 /*******************************************************************************
  * MACROS
@@ -62,6 +65,9 @@ static StripsManager* psStripManager;
 static Storage*       psStorage;
 static IOButtonMgr*   psIOBtnManager;
 
+/* The UI runs in the Arduino loop task, set its stack size */
+SET_LOOP_TASK_STACK_SIZE(UI_TASK_STACK);
+
 /*******************************************************************************
  * STATIC FUNCTIONS DECLARATIONS
  ******************************************************************************/
@@ -104,12 +110,15 @@ void setup(void)
     LOG_INFO("#========================#\n");
     LOG_INFO("===> SW " VERSION "\n");
 
+    /* Monitor the UI task and let the LED tasks preempt it */
+    TaskMonitor::GetInstance()->RegisterTask(TASK_UI, xTaskGetCurrentTaskHandle());
+    vTaskPrioritySet(nullptr, UI_TASK_PRIO);
 
 #if INIT_FLASH
     InitFlash();
 #endif
 
-    /* Get the storage */
+    /* Get the storage, starts the storage task */
     psStorage = Storage::GetInstance();
     psStorage->LoadData();
 
@@ -142,19 +151,13 @@ void loop(void)
     /* Update the system state */
     psSysState->Update();
 
-    /* Update the BLE manager */
-    psBLEManager->Update();
-
-    /* Update the strip manager */
-    psStripManager->CheckForActivity();
-
-    /* Update the storage manager without forcing a commit to flash */
-    //psStorage->Update(false);
-
     /* Loop speed down */
     endTime = HWLayer::GetTime();
-    if(endTime - startTime < 25000)
+    TaskMonitor::GetInstance()->ReportPeriod(TASK_UI,
+                                             endTime - startTime >
+                                             UI_LOOP_PERIOD_US);
+    if(endTime - startTime < UI_LOOP_PERIOD_US)
     {
-        HWLayer::DelayExecUs((25000 - (endTime - startTime)), true);
+        HWLayer::DelayExecUs((UI_LOOP_PERIOD_US - (endTime - startTime)), true);
     }
-}
\ No newline at end of file
+}
\ No newline at end of file
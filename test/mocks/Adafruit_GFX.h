@@ -0,0 +1,21 @@
+/*******************************************************************************
+ * @file Adafruit_GFX.h
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief Host Adafruit GFX library.
+ *
+ * @details This file is provided for the includes of the firmware, the
+ * screen is not used on the host.
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+#ifndef __MOCKS_ADAFRUIT_GFX_H_
+#define __MOCKS_ADAFRUIT_GFX_H_
+
+#endif /* #ifndef __MOCKS_ADAFRUIT_GFX_H_ */
@@ -0,0 +1,25 @@
+/*******************************************************************************
+ * @file Adafruit_SSD1306.h
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief Host Adafruit SSD1306 driver.
+ *
+ * @details This file is provided for the includes of the firmware, the
+ * screen is not used on the host.
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+#ifndef __MOCKS_ADAFRUIT_SSD1306_H_
+#define __MOCKS_ADAFRUIT_SSD1306_H_
+
+class Adafruit_SSD1306
+{
+};
+
+#endif /* #ifndef __MOCKS_ADAFRUIT_SSD1306_H_ */
@@ -0,0 +1,186 @@
+/*******************************************************************************
+ * @file Arduino.cpp
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief Host Arduino core.
+ *
+ * @details This file implements the Arduino core and ESP-IDF services used
+ * by the firmware on the host. The time is read from the host steady clock.
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include <cstdint> /* Standard Int Types */
+#include <cstdarg> /* va_list */
+#include <cstdio>  /* vprintf */
+#include <chrono>  /* std::chrono */
+#include <thread>  /* std::this_thread */
+#include <atomic>  /* std::atomic */
+
+/* Header File */
+#include <Arduino.h>
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * STRUCTURES AND TYPES
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/************************* Imported global variables **************************/
+/* None */
+
+/************************* Exported global variables **************************/
+HardwareSerial Serial;
+
+/************************** Static global variables ***************************/
+
+/* The time starts at one second as on a booted board, 0 is used by the
+ * firmware as a no time marker.
+ */
+static const std::chrono::steady_clock::time_point skBootTime =
+    std::chrono::steady_clock::now() - std::chrono::seconds(1);
+
+/* A frame is being sent and the pins written meanwhile */
+static std::atomic<bool>     sIsShowActive(false);
+static std::atomic<uint32_t> sShowPinWrites(0);
+
+/*******************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+void pinMode(const uint8_t kPin, const uint8_t kMode)
+{
+    (void)kPin;
+    (void)kMode;
+
+    if(sIsShowActive.load() == true)
+    {
+        ++sShowPinWrites;
+    }
+}
+
+void digitalWrite(const uint8_t kPin, const uint8_t kValue)
+{
+    (void)kPin;
+    (void)kValue;
+
+    if(sIsShowActive.load() == true)
+    {
+        ++sShowPinWrites;
+    }
+}
+
+int digitalRead(const uint8_t kPin)
+{
+    (void)kPin;
+    return LOW;
+}
+
+unsigned long millis(void)
+{
+    return (unsigned long)(esp_timer_get_time() / 1000);
+}
+
+unsigned long micros(void)
+{
+    return (unsigned long)esp_timer_get_time();
+}
+
+void delay(const uint32_t kMs)
+{
+    std::this_thread::sleep_for(std::chrono::milliseconds(kMs));
+}
+
+extern "C" int64_t esp_timer_get_time(void)
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - skBootTime).count();
+}
+
+extern "C" void ets_delay_us(const uint32_t kUs)
+{
+    int64_t endTime;
+
+    /* Busy wait as the ROM function */
+    endTime = esp_timer_get_time() + kUs;
+    while(esp_timer_get_time() < endTime)
+    {
+    }
+}
+
+void* heap_caps_malloc(const size_t kSize, const uint32_t kCaps)
+{
+    (void)kCaps;
+    return malloc(kSize);
+}
+
+void heap_caps_free(void* pPtr)
+{
+    free(pPtr);
+}
+
+void HostSetShowActive(const bool kIsActive)
+{
+    sIsShowActive.store(kIsActive);
+}
+
+bool HostIsShowActive(void)
+{
+    return sIsShowActive.load();
+}
+
+uint32_t HostGetShowPinWrites(void)
+{
+    return sShowPinWrites.load();
+}
+
+/*******************************************************************************
+ * CLASS METHODS
+ ******************************************************************************/
+
+void HardwareSerial::begin(const unsigned long kBaud)
+{
+    (void)kBaud;
+}
+
+int HardwareSerial::printf(const char* kpFormat, ...)
+{
+    int     len;
+    va_list argptr;
+
+    va_start(argptr, kpFormat);
+    len = vprintf(kpFormat, argptr);
+    va_end(argptr);
+
+    return len;
+}
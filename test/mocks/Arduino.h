@@ -0,0 +1,141 @@
+/*******************************************************************************
+ * @file Arduino.h
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief Host Arduino core.
+ *
+ * @details This file provides the subset of the Arduino core and ESP-IDF
+ * services used by the firmware core so it can be built and tested on the
+ * host. The FreeRTOS services run on host threads.
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+#ifndef __MOCKS_ARDUINO_H_
+#define __MOCKS_ARDUINO_H_
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+
+#include <cstdint>  /* Standard Int Types */
+#include <cstddef>  /* size_t */
+#include <cstdio>   /* printf */
+#include <cstdlib>  /* malloc */
+#include <cstring>  /* memcpy */
+#include <cstdarg>  /* va_list */
+#include <cmath>    /* Math services */
+#include <string>   /* std::string */
+#include <unistd.h> /* POSIX services */
+#include <freertos/FreeRTOS.h> /* FreeRTOS services */
+#include <freertos/task.h>     /* FreeRTOS tasks */
+#include <freertos/semphr.h>   /* FreeRTOS semaphores */
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+#define OUTPUT 0x03
+#define INPUT  0x01
+#define HIGH   0x1
+#define LOW    0x0
+
+#define IRAM_ATTR
+#define DRAM_ATTR
+#define EXT_RAM_ATTR
+
+#define MALLOC_CAP_8BIT     (1 << 2)
+#define MALLOC_CAP_SPIRAM   (1 << 10)
+#define MALLOC_CAP_INTERNAL (1 << 11)
+
+#define ARDUINO_RUNNING_CORE 1
+
+/*******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * STRUCTURES AND TYPES
+ ******************************************************************************/
+
+typedef enum
+{
+    GPIO_NUM_NC = -1,
+    GPIO_NUM_0  = 0,  GPIO_NUM_1  = 1,  GPIO_NUM_2  = 2,  GPIO_NUM_3  = 3,
+    GPIO_NUM_4  = 4,  GPIO_NUM_5  = 5,  GPIO_NUM_6  = 6,  GPIO_NUM_7  = 7,
+    GPIO_NUM_8  = 8,  GPIO_NUM_9  = 9,  GPIO_NUM_10 = 10, GPIO_NUM_11 = 11,
+    GPIO_NUM_12 = 12, GPIO_NUM_13 = 13, GPIO_NUM_14 = 14, GPIO_NUM_15 = 15,
+    GPIO_NUM_16 = 16, GPIO_NUM_17 = 17, GPIO_NUM_18 = 18, GPIO_NUM_19 = 19,
+    GPIO_NUM_20 = 20, GPIO_NUM_21 = 21, GPIO_NUM_26 = 26, GPIO_NUM_27 = 27,
+    GPIO_NUM_28 = 28, GPIO_NUM_29 = 29, GPIO_NUM_30 = 30, GPIO_NUM_31 = 31,
+    GPIO_NUM_32 = 32, GPIO_NUM_33 = 33, GPIO_NUM_34 = 34, GPIO_NUM_35 = 35,
+    GPIO_NUM_36 = 36, GPIO_NUM_37 = 37, GPIO_NUM_38 = 38, GPIO_NUM_39 = 39,
+    GPIO_NUM_40 = 40, GPIO_NUM_41 = 41, GPIO_NUM_42 = 42, GPIO_NUM_43 = 43,
+    GPIO_NUM_44 = 44, GPIO_NUM_45 = 45, GPIO_NUM_46 = 46, GPIO_NUM_47 = 47,
+    GPIO_NUM_48 = 48,
+    GPIO_NUM_MAX
+} gpio_num_t;
+
+/*******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/************************* Imported global variables **************************/
+/* None */
+
+/************************* Exported global variables **************************/
+/* None */
+
+/************************** Static global variables ***************************/
+/* None */
+
+/*******************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+void pinMode(const uint8_t kPin, const uint8_t kMode);
+void digitalWrite(const uint8_t kPin, const uint8_t kValue);
+int digitalRead(const uint8_t kPin);
+
+unsigned long millis(void);
+unsigned long micros(void);
+void delay(const uint32_t kMs);
+
+extern "C" int64_t esp_timer_get_time(void);
+extern "C" void ets_delay_us(const uint32_t kUs);
+
+void* heap_caps_malloc(const size_t kSize, const uint32_t kCaps);
+void heap_caps_free(void* pPtr);
+
+/* Host only services, counts the pins written while a frame is sent */
+void HostSetShowActive(const bool kIsActive);
+bool HostIsShowActive(void);
+uint32_t HostGetShowPinWrites(void);
+
+/*******************************************************************************
+ * CLASSES
+ ******************************************************************************/
+
+class HardwareSerial
+{
+    public:
+        void begin(const unsigned long kBaud);
+        int printf(const char* kpFormat, ...);
+};
+
+extern HardwareSerial Serial;
+
+#endif /* #ifndef __MOCKS_ARDUINO_H_ */
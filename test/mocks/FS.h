@@ -0,0 +1,72 @@
+/*******************************************************************************
+ * @file FS.h
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief Host filesystem.
+ *
+ * @details This file provides the Arduino filesystem file object on the host.
+ * The files are kept in memory by the host SPIFFS.
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+#ifndef __MOCKS_FS_H_
+#define __MOCKS_FS_H_
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+
+#include <cstdint> /* Standard Int Types */
+#include <cstddef> /* size_t */
+#include <string>  /* std::string */
+#include <memory>  /* std::shared_ptr */
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+#define FILE_READ   "r"
+#define FILE_WRITE  "w"
+#define FILE_APPEND "a"
+
+/*******************************************************************************
+ * STRUCTURES AND TYPES
+ ******************************************************************************/
+
+/* State of an opened file, shared by the copies of the file object */
+typedef struct SHostFile SHostFile;
+
+/*******************************************************************************
+ * CLASSES
+ ******************************************************************************/
+
+class File
+{
+    public:
+        File(void);
+        File(const std::shared_ptr<SHostFile>& krFile);
+
+        size_t write(const uint8_t* kpBuffer, const size_t kSize);
+        int read(uint8_t* pBuffer, const size_t kSize);
+        int available(void);
+        void flush(void);
+        size_t size(void);
+        void close(void);
+
+        const char* name(void) const;
+        bool isDirectory(void) const;
+        File openNextFile(void);
+
+        operator bool(void) const;
+
+    private:
+        std::shared_ptr<SHostFile> pFile_;
+};
+
+#endif /* #ifndef __MOCKS_FS_H_ */
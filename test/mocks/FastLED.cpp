@@ -0,0 +1,162 @@
+/*******************************************************************************
+ * @file FastLED.cpp
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief Host FastLED driver.
+ *
+ * @details This file implements the FastLED services used by the firmware on
+ * the host.
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include <cstdint> /* Standard Int Types */
+#include <chrono>  /* std::chrono */
+#include <thread>  /* std::this_thread */
+
+/* Header File */
+#include <FastLED.h>
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * STRUCTURES AND TYPES
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/************************* Imported global variables **************************/
+/* None */
+
+/************************* Exported global variables **************************/
+CFastLED FastLED;
+
+/************************** Static global variables ***************************/
+/* None */
+
+/*******************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * CLASS METHODS
+ ******************************************************************************/
+
+CLEDController::CLEDController(CRGB* pLeds, const int kCount)
+{
+    pLeds_  = pLeds;
+    count_  = kCount;
+}
+
+CLEDController& CLEDController::setCorrection(const uint32_t kCorrection)
+{
+    (void)kCorrection;
+    return *this;
+}
+
+CLEDController& CLEDController::setLeds(CRGB* pLeds, const int kCount)
+{
+    pLeds_ = pLeds;
+    count_ = kCount;
+    return *this;
+}
+
+CRGB* CLEDController::leds(void)
+{
+    return pLeds_;
+}
+
+int CLEDController::size(void) const
+{
+    return count_;
+}
+
+void CFastLED::show(const uint8_t kBrightness)
+{
+    int maxCount;
+
+    brightness_ = kBrightness;
+
+    /* The channels are sent in parallel */
+    maxCount = 0;
+    for(const CLEDController* kpController : controllers_)
+    {
+        if(kpController->size() > maxCount)
+        {
+            maxCount = kpController->size();
+        }
+    }
+    HostSetShowActive(true);
+    std::this_thread::sleep_for(
+        std::chrono::nanoseconds((int64_t)maxCount *
+                                 FASTLED_MOCK_LED_TIME_NS));
+    HostSetShowActive(false);
+
+    ++showCount_;
+}
+
+void CFastLED::show(void)
+{
+    show(brightness_);
+}
+
+void CFastLED::setBrightness(const uint8_t kBrightness)
+{
+    brightness_ = kBrightness;
+}
+
+uint8_t CFastLED::getBrightness(void) const
+{
+    return brightness_;
+}
+
+int CFastLED::count(void) const
+{
+    return (int)controllers_.size();
+}
+
+CLEDController& CFastLED::operator[](const int kIdx)
+{
+    return *controllers_[kIdx];
+}
+
+uint32_t CFastLED::getShowCount(void) const
+{
+    return showCount_;
+}
+
+CLEDController& CFastLED::AddController(CRGB* pLeds, const int kCount)
+{
+    controllers_.push_back(new CLEDController(pLeds, kCount));
+    return *controllers_.back();
+}
@@ -0,0 +1,135 @@
+/*******************************************************************************
+ * @file FastLED.h
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief Host FastLED driver.
+ *
+ * @details This file provides the FastLED services used by the firmware on
+ * the host. Showing a frame takes the WS2812B wire time of the longest
+ * strip, the channels are sent in parallel as with the RMT driver.
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+#ifndef __MOCKS_FASTLED_H_
+#define __MOCKS_FASTLED_H_
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+
+#include <cstdint>   /* Standard Int Types */
+#include <vector>    /* std::vector */
+#include <Arduino.h> /* Arduino services */
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+/* WS2812B wire time of one LED: 24 bits at 800kHz */
+#define FASTLED_MOCK_LED_TIME_NS 30000
+
+#define TypicalLEDStrip 0xFFB0F0
+
+/*******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * STRUCTURES AND TYPES
+ ******************************************************************************/
+
+typedef enum
+{
+    RGB = 0012,
+    GRB = 0102
+} EOrder;
+
+struct CRGB
+{
+    union
+    {
+        struct
+        {
+            uint8_t r;
+            uint8_t g;
+            uint8_t b;
+        };
+        uint8_t raw[3];
+    };
+
+    CRGB(void) {}
+    CRGB(const uint8_t kR, const uint8_t kG, const uint8_t kB) :
+        r(kR), g(kG), b(kB) {}
+    CRGB(const uint32_t kColorCode) :
+        r((kColorCode >> 16) & 0xFF),
+        g((kColorCode >> 8) & 0xFF),
+        b(kColorCode & 0xFF) {}
+};
+
+/*******************************************************************************
+ * CLASSES
+ ******************************************************************************/
+
+template<uint8_t DATA_PIN, EOrder RGB_ORDER>
+class WS2812B
+{
+};
+
+class CLEDController
+{
+    public:
+        CLEDController(CRGB* pLeds, const int kCount);
+
+        CLEDController& setCorrection(const uint32_t kCorrection);
+        CLEDController& setLeds(CRGB* pLeds, const int kCount);
+
+        CRGB* leds(void);
+        int size(void) const;
+
+    private:
+        CRGB* pLeds_;
+        int   count_;
+};
+
+class CFastLED
+{
+    public:
+        template<template<uint8_t DATA_PIN, EOrder RGB_ORDER> class CHIPSET,
+                 uint8_t DATA_PIN,
+                 EOrder  RGB_ORDER>
+        CLEDController& addLeds(CRGB* pLeds, const int kCount)
+        {
+            return AddController(pLeds, kCount);
+        }
+
+        void show(const uint8_t kBrightness);
+        void show(void);
+
+        void setBrightness(const uint8_t kBrightness);
+        uint8_t getBrightness(void) const;
+
+        int count(void) const;
+        CLEDController& operator[](const int kIdx);
+
+        /* Number of frames shown since the start */
+        uint32_t getShowCount(void) const;
+
+    private:
+        CLEDController& AddController(CRGB* pLeds, const int kCount);
+
+        std::vector<CLEDController*> controllers_;
+        uint8_t                      brightness_;
+        volatile uint32_t            showCount_;
+};
+
+extern CFastLED FastLED;
+
+#endif /* #ifndef __MOCKS_FASTLED_H_ */
@@ -0,0 +1,496 @@
+/*******************************************************************************
+ * @file FreeRTOS.cpp
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief Host FreeRTOS kernel.
+ *
+ * @details This file implements the FreeRTOS services used by the firmware
+ * with host threads, mutexes and condition variables. The objects are never
+ * freed, the tasks run until the test process exits.
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include <cstdint>            /* Standard Int Types */
+#include <chrono>             /* std::chrono */
+#include <thread>             /* std::thread */
+#include <mutex>              /* std::mutex */
+#include <condition_variable> /* std::condition_variable */
+
+/* Header File */
+#include <freertos/FreeRTOS.h>
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+#define SEM_BINARY    0
+#define SEM_COUNTING  1
+#define SEM_MUTEX     2
+#define SEM_RECURSIVE 3
+
+/*******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * STRUCTURES AND TYPES
+ ******************************************************************************/
+
+struct SHostTask
+{
+    std::mutex              lock;
+    std::condition_variable event;
+    uint32_t                notifyValue;
+    bool                    isNotified;
+    BaseType_t              core;
+    uint32_t                stackSize;
+    TaskFunction_t          pRoutine;
+    void*                   pParam;
+};
+
+struct SHostSemaphore
+{
+    std::mutex              lock;
+    std::condition_variable event;
+    uint8_t                 type;
+    UBaseType_t             count;
+    UBaseType_t             maxCount;
+    std::thread::id         owner;
+    uint32_t                depth;
+};
+
+struct SHostEventGroup
+{
+    std::mutex  lock;
+    EventBits_t bits;
+};
+
+/*******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/************************* Imported global variables **************************/
+/* None */
+
+/************************* Exported global variables **************************/
+/* None */
+
+/************************** Static global variables ***************************/
+
+/* Task of the calling thread, created on first use for the main thread. The
+ * main thread stands for the Arduino loop task on core 1.
+ */
+static thread_local SHostTask* spCurrentTask = nullptr;
+
+static const std::chrono::steady_clock::time_point skBootTime =
+    std::chrono::steady_clock::now();
+
+/*******************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ ******************************************************************************/
+
+static void TaskEntry(SHostTask* pTask);
+static SHostTask* GetCurrentTask(void);
+static SHostSemaphore* CreateSemaphore(const uint8_t     kType,
+                                       const UBaseType_t kMax,
+                                       const UBaseType_t kInitial);
+static bool WaitFor(std::condition_variable&      rEvent,
+                    std::unique_lock<std::mutex>& rLock,
+                    const TickType_t              kTicks,
+                    const std::chrono::steady_clock::time_point& krStart);
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+static void TaskEntry(SHostTask* pTask)
+{
+    spCurrentTask = pTask;
+    pTask->pRoutine(pTask->pParam);
+}
+
+static SHostTask* GetCurrentTask(void)
+{
+    if(spCurrentTask == nullptr)
+    {
+        spCurrentTask              = new SHostTask();
+        spCurrentTask->notifyValue = 0;
+        spCurrentTask->isNotified  = false;
+        spCurrentTask->core        = 1;
+        spCurrentTask->stackSize   = 8192;
+        spCurrentTask->pRoutine    = nullptr;
+        spCurrentTask->pParam      = nullptr;
+    }
+
+    return spCurrentTask;
+}
+
+static SHostSemaphore* CreateSemaphore(const uint8_t     kType,
+                                       const UBaseType_t kMax,
+                                       const UBaseType_t kInitial)
+{
+    SHostSemaphore* pSem;
+
+    pSem           = new SHostSemaphore();
+    pSem->type     = kType;
+    pSem->count    = kInitial;
+    pSem->maxCount = kMax;
+    pSem->depth    = 0;
+
+    return pSem;
+}
+
+static bool WaitFor(std::condition_variable&      rEvent,
+                    std::unique_lock<std::mutex>& rLock,
+                    const TickType_t              kTicks,
+                    const std::chrono::steady_clock::time_point& krStart)
+{
+    /* Returns false once the timeout is reached */
+    if(kTicks == portMAX_DELAY)
+    {
+        rEvent.wait(rLock);
+        return true;
+    }
+
+    return rEvent.wait_until(rLock,
+                             krStart + std::chrono::milliseconds(kTicks)) ==
+           std::cv_status::no_timeout;
+}
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t     pRoutine,
+                                   const char*        kpName,
+                                   const uint32_t     kStackSize,
+                                   void*              pParam,
+                                   const UBaseType_t  kPriority,
+                                   TaskHandle_t*      pHandle,
+                                   const BaseType_t   kCore)
+{
+    SHostTask* pTask;
+
+    (void)kpName;
+    (void)kPriority;
+
+    pTask              = new SHostTask();
+    pTask->notifyValue = 0;
+    pTask->isNotified  = false;
+    pTask->core        = kCore;
+    pTask->stackSize   = kStackSize;
+    pTask->pRoutine    = pRoutine;
+    pTask->pParam      = pParam;
+
+    if(pHandle != nullptr)
+    {
+        *pHandle = pTask;
+    }
+
+    std::thread(TaskEntry, pTask).detach();
+
+    return pdPASS;
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void)
+{
+    return GetCurrentTask();
+}
+
+BaseType_t xPortGetCoreID(void)
+{
+    return GetCurrentTask()->core;
+}
+
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t pTask)
+{
+    return pTask->stackSize;
+}
+
+void vTaskDelay(const TickType_t kTicks)
+{
+    std::this_thread::sleep_for(std::chrono::milliseconds(kTicks));
+}
+
+TickType_t xTaskGetTickCount(void)
+{
+    return (TickType_t)std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - skBootTime).count();
+}
+
+BaseType_t xTaskNotify(TaskHandle_t        pTask,
+                       const uint32_t      kValue,
+                       const eNotifyAction kAction)
+{
+    std::lock_guard<std::mutex> lock(pTask->lock);
+
+    switch(kAction)
+    {
+        case eSetBits:
+            pTask->notifyValue |= kValue;
+            break;
+        case eIncrement:
+            ++pTask->notifyValue;
+            break;
+        case eSetValueWithOverwrite:
+            pTask->notifyValue = kValue;
+            break;
+        case eSetValueWithoutOverwrite:
+            if(pTask->isNotified == true)
+            {
+                return pdFAIL;
+            }
+            pTask->notifyValue = kValue;
+            break;
+        default:
+            break;
+    }
+    pTask->isNotified = true;
+    pTask->event.notify_all();
+
+    return pdPASS;
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t pTask)
+{
+    return xTaskNotify(pTask, 0, eIncrement);
+}
+
+BaseType_t xTaskNotifyWait(const uint32_t   kClearOnEntry,
+                           const uint32_t   kClearOnExit,
+                           uint32_t*        pValue,
+                           const TickType_t kTicks)
+{
+    SHostTask* pTask;
+    std::chrono::steady_clock::time_point start;
+
+    pTask = GetCurrentTask();
+    start = std::chrono::steady_clock::now();
+
+    std::unique_lock<std::mutex> lock(pTask->lock);
+
+    if(pTask->isNotified == false)
+    {
+        pTask->notifyValue &= ~kClearOnEntry;
+    }
+    while(pTask->isNotified == false)
+    {
+        if(WaitFor(pTask->event, lock, kTicks, start) == false &&
+           pTask->isNotified == false)
+        {
+            return pdFALSE;
+        }
+    }
+
+    if(pValue != nullptr)
+    {
+        *pValue = pTask->notifyValue;
+    }
+    pTask->notifyValue &= ~kClearOnExit;
+    pTask->isNotified   = false;
+
+    return pdTRUE;
+}
+
+uint32_t ulTaskNotifyTake(const BaseType_t kClear, const TickType_t kTicks)
+{
+    SHostTask* pTask;
+    uint32_t   value;
+    std::chrono::steady_clock::time_point start;
+
+    pTask = GetCurrentTask();
+    start = std::chrono::steady_clock::now();
+
+    std::unique_lock<std::mutex> lock(pTask->lock);
+
+    while(pTask->notifyValue == 0)
+    {
+        if(WaitFor(pTask->event, lock, kTicks, start) == false &&
+           pTask->notifyValue == 0)
+        {
+            return 0;
+        }
+    }
+
+    value = pTask->notifyValue;
+    if(kClear == pdTRUE)
+    {
+        pTask->notifyValue = 0;
+    }
+    else
+    {
+        --pTask->notifyValue;
+    }
+    pTask->isNotified = false;
+
+    return value;
+}
+
+uint32_t ulTaskNotifyValueClear(TaskHandle_t pTask, const uint32_t kBits)
+{
+    uint32_t value;
+
+    if(pTask == nullptr)
+    {
+        pTask = GetCurrentTask();
+    }
+
+    std::lock_guard<std::mutex> lock(pTask->lock);
+    value               = pTask->notifyValue;
+    pTask->notifyValue &= ~kBits;
+
+    return value;
+}
+
+SemaphoreHandle_t xSemaphoreCreateBinary(void)
+{
+    return CreateSemaphore(SEM_BINARY, 1, 0);
+}
+
+SemaphoreHandle_t xSemaphoreCreateCounting(const UBaseType_t kMax,
+                                           const UBaseType_t kInitial)
+{
+    return CreateSemaphore(SEM_COUNTING, kMax, kInitial);
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutex(void)
+{
+    return CreateSemaphore(SEM_MUTEX, 1, 1);
+}
+
+SemaphoreHandle_t xSemaphoreCreateRecursiveMutex(void)
+{
+    return CreateSemaphore(SEM_RECURSIVE, 1, 1);
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t pSem, const TickType_t kTicks)
+{
+    std::chrono::steady_clock::time_point start;
+
+    start = std::chrono::steady_clock::now();
+
+    std::unique_lock<std::mutex> lock(pSem->lock);
+
+    while(pSem->count == 0)
+    {
+        if(kTicks == 0 ||
+           (WaitFor(pSem->event, lock, kTicks, start) == false &&
+            pSem->count == 0))
+        {
+            return pdFALSE;
+        }
+    }
+    --pSem->count;
+    pSem->owner = std::this_thread::get_id();
+
+    return pdTRUE;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t pSem)
+{
+    std::lock_guard<std::mutex> lock(pSem->lock);
+
+    if(pSem->count >= pSem->maxCount)
+    {
+        return pdFALSE;
+    }
+    ++pSem->count;
+    pSem->event.notify_one();
+
+    return pdTRUE;
+}
+
+BaseType_t xSemaphoreTakeRecursive(SemaphoreHandle_t pSem,
+                                   const TickType_t  kTicks)
+{
+    {
+        std::lock_guard<std::mutex> lock(pSem->lock);
+        if(pSem->depth != 0 && pSem->owner == std::this_thread::get_id())
+        {
+            ++pSem->depth;
+            return pdTRUE;
+        }
+    }
+
+    if(xSemaphoreTake(pSem, kTicks) == pdFALSE)
+    {
+        return pdFALSE;
+    }
+
+    std::lock_guard<std::mutex> lock(pSem->lock);
+    pSem->depth = 1;
+
+    return pdTRUE;
+}
+
+BaseType_t xSemaphoreGiveRecursive(SemaphoreHandle_t pSem)
+{
+    {
+        std::lock_guard<std::mutex> lock(pSem->lock);
+        if(pSem->depth == 0 || pSem->owner != std::this_thread::get_id())
+        {
+            return pdFALSE;
+        }
+        --pSem->depth;
+        if(pSem->depth != 0)
+        {
+            return pdTRUE;
+        }
+    }
+
+    return xSemaphoreGive(pSem);
+}
+
+UBaseType_t uxSemaphoreGetCount(SemaphoreHandle_t pSem)
+{
+    std::lock_guard<std::mutex> lock(pSem->lock);
+
+    return pSem->count;
+}
+
+EventGroupHandle_t xEventGroupCreate(void)
+{
+    SHostEventGroup* pGroup;
+
+    pGroup       = new SHostEventGroup();
+    pGroup->bits = 0;
+
+    return pGroup;
+}
+
+EventBits_t xEventGroupSetBits(EventGroupHandle_t pGroup,
+                               const EventBits_t  kBits)
+{
+    std::lock_guard<std::mutex> lock(pGroup->lock);
+
+    pGroup->bits |= kBits;
+
+    return pGroup->bits;
+}
+
+EventBits_t xEventGroupClearBits(EventGroupHandle_t pGroup,
+                                 const EventBits_t  kBits)
+{
+    EventBits_t bits;
+
+    std::lock_guard<std::mutex> lock(pGroup->lock);
+
+    bits          = pGroup->bits;
+    pGroup->bits &= ~kBits;
+
+    return bits;
+}
+
+EventBits_t xEventGroupGetBits(EventGroupHandle_t pGroup)
+{
+    std::lock_guard<std::mutex> lock(pGroup->lock);
+
+    return pGroup->bits;
+}
@@ -0,0 +1,376 @@
+/*******************************************************************************
+ * @file SPIFFS.cpp
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief Host SPIFFS driver.
+ *
+ * @details This file implements an in-memory SPIFFS on the host. SPIFFS has
+ * no directories, the root lists all the files.
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include <cstdint>   /* Standard Int Types */
+#include <cstring>   /* memcpy */
+#include <string>    /* std::string */
+#include <vector>    /* std::vector */
+#include <map>       /* std::map */
+#include <mutex>     /* std::mutex */
+#include <atomic>    /* std::atomic */
+#include <chrono>    /* std::chrono */
+#include <thread>    /* std::this_thread */
+#include <Arduino.h> /* Frames sending state */
+
+/* Header File */
+#include <SPIFFS.h>
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * STRUCTURES AND TYPES
+ ******************************************************************************/
+
+struct SHostFile
+{
+    std::string              path;
+    bool                     isDirectory;
+    bool                     isOpen;
+    size_t                   position;
+    /* Files listed by a directory and next one to open */
+    std::vector<std::string> entries;
+    size_t                   nextEntry;
+};
+
+/*******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/************************* Imported global variables **************************/
+/* None */
+
+/************************* Exported global variables **************************/
+SPIFFSFS SPIFFS;
+
+/************************** Static global variables ***************************/
+
+/* Never freed, the tasks may use the files until the process exits */
+static std::map<std::string, std::vector<uint8_t>>* spFiles =
+    new std::map<std::string, std::vector<uint8_t>>();
+static std::mutex* spLock = new std::mutex();
+
+static SSpiffsStats sStats = {
+    .bytesWritten   = 0,
+    .writeCount     = 0,
+    .maxWriteSize   = 0,
+    .showWriteCount = 0
+};
+
+/* Duration of each write, the flash stall */
+static std::atomic<uint32_t> sWriteDelayUs(0);
+
+/*******************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * CLASS METHODS
+ ******************************************************************************/
+
+File::File(void)
+{
+}
+
+File::File(const std::shared_ptr<SHostFile>& krFile)
+{
+    pFile_ = krFile;
+}
+
+size_t File::write(const uint8_t* kpBuffer, const size_t kSize)
+{
+    std::vector<uint8_t>* pData;
+    bool                  isShowWrite;
+
+    if(pFile_ == nullptr || pFile_->isOpen == false ||
+       pFile_->isDirectory == true)
+    {
+        return 0;
+    }
+
+    /* The flash stalls the whole write, a frame sent during the stall
+     * is active at its start or at its end.
+     */
+    isShowWrite = HostIsShowActive();
+    if(sWriteDelayUs.load() != 0)
+    {
+        std::this_thread::sleep_for(
+            std::chrono::microseconds(sWriteDelayUs.load()));
+    }
+    isShowWrite = isShowWrite || HostIsShowActive();
+
+    std::lock_guard<std::mutex> lock(*spLock);
+
+    pData = &(*spFiles)[pFile_->path];
+    pData->insert(pData->end(), kpBuffer, kpBuffer + kSize);
+    pFile_->position = pData->size();
+
+    sStats.bytesWritten += kSize;
+    ++sStats.writeCount;
+    if(kSize > sStats.maxWriteSize)
+    {
+        sStats.maxWriteSize = kSize;
+    }
+    if(isShowWrite == true)
+    {
+        ++sStats.showWriteCount;
+    }
+
+    return kSize;
+}
+
+int File::read(uint8_t* pBuffer, const size_t kSize)
+{
+    size_t readSize;
+    std::map<std::string, std::vector<uint8_t>>::iterator it;
+
+    if(pFile_ == nullptr || pFile_->isOpen == false)
+    {
+        return -1;
+    }
+
+    std::lock_guard<std::mutex> lock(*spLock);
+
+    it = spFiles->find(pFile_->path);
+    if(it == spFiles->end() || pFile_->position >= it->second.size())
+    {
+        return 0;
+    }
+
+    readSize = it->second.size() - pFile_->position;
+    if(readSize > kSize)
+    {
+        readSize = kSize;
+    }
+    memcpy(pBuffer, it->second.data() + pFile_->position, readSize);
+    pFile_->position += readSize;
+
+    return (int)readSize;
+}
+
+int File::available(void)
+{
+    size_t fileSize;
+
+    fileSize = size();
+    if(pFile_ == nullptr || pFile_->position >= fileSize)
+    {
+        return 0;
+    }
+
+    return (int)(fileSize - pFile_->position);
+}
+
+void File::flush(void)
+{
+}
+
+size_t File::size(void)
+{
+    std::map<std::string, std::vector<uint8_t>>::iterator it;
+
+    if(pFile_ == nullptr)
+    {
+        return 0;
+    }
+
+    std::lock_guard<std::mutex> lock(*spLock);
+
+    it = spFiles->find(pFile_->path);
+    if(it == spFiles->end())
+    {
+        return 0;
+    }
+
+    return it->second.size();
+}
+
+void File::close(void)
+{
+    if(pFile_ != nullptr)
+    {
+        pFile_->isOpen = false;
+    }
+}
+
+const char* File::name(void) const
+{
+    /* Name without the root directory */
+    return pFile_->path.c_str() + 1;
+}
+
+bool File::isDirectory(void) const
+{
+    return pFile_ != nullptr && pFile_->isDirectory;
+}
+
+File File::openNextFile(void)
+{
+    std::string path;
+
+    if(isDirectory() == false ||
+       pFile_->nextEntry >= pFile_->entries.size())
+    {
+        return File();
+    }
+
+    path = pFile_->entries[pFile_->nextEntry++];
+
+    return SPIFFS.open(path.c_str(), FILE_READ);
+}
+
+File::operator bool(void) const
+{
+    return pFile_ != nullptr && pFile_->isOpen == true;
+}
+
+bool SPIFFSFS::begin(const bool kFormatOnFail)
+{
+    (void)kFormatOnFail;
+    return true;
+}
+
+bool SPIFFSFS::exists(const char* kpPath)
+{
+    std::lock_guard<std::mutex> lock(*spLock);
+
+    return spFiles->count(kpPath) != 0;
+}
+
+bool SPIFFSFS::remove(const char* kpPath)
+{
+    std::lock_guard<std::mutex> lock(*spLock);
+
+    return spFiles->erase(kpPath) != 0;
+}
+
+bool SPIFFSFS::rename(const char* kpFrom, const char* kpTo)
+{
+    std::lock_guard<std::mutex> lock(*spLock);
+
+    if(spFiles->count(kpFrom) == 0 || spFiles->count(kpTo) != 0)
+    {
+        return false;
+    }
+    (*spFiles)[kpTo] = (*spFiles)[kpFrom];
+    spFiles->erase(kpFrom);
+
+    return true;
+}
+
+File SPIFFSFS::open(const char* kpPath, const char* kpMode)
+{
+    std::shared_ptr<SHostFile> file;
+    std::string                mode;
+
+    file = std::make_shared<SHostFile>();
+    file->path        = kpPath;
+    file->isDirectory = false;
+    file->isOpen      = true;
+    file->position    = 0;
+    file->nextEntry   = 0;
+    mode              = kpMode;
+
+    std::lock_guard<std::mutex> lock(*spLock);
+
+    if(file->path == "/")
+    {
+        file->isDirectory = true;
+        for(const std::pair<const std::string, std::vector<uint8_t>>& krFile :
+            *spFiles)
+        {
+            file->entries.push_back(krFile.first);
+        }
+    }
+    else if(mode == FILE_READ)
+    {
+        if(spFiles->count(file->path) == 0)
+        {
+            return File();
+        }
+    }
+    else if(mode == FILE_WRITE)
+    {
+        (*spFiles)[file->path].clear();
+    }
+    else
+    {
+        file->position = (*spFiles)[file->path].size();
+    }
+
+    return File(file);
+}
+
+size_t SPIFFSFS::totalBytes(void)
+{
+    return SPIFFS_MOCK_SIZE;
+}
+
+size_t SPIFFSFS::usedBytes(void)
+{
+    size_t used;
+
+    std::lock_guard<std::mutex> lock(*spLock);
+
+    used = 0;
+    for(const std::pair<const std::string, std::vector<uint8_t>>& krFile :
+        *spFiles)
+    {
+        used += krFile.second.size();
+    }
+
+    return used;
+}
+
+void SPIFFSFS::getStats(SSpiffsStats& rStats)
+{
+    std::lock_guard<std::mutex> lock(*spLock);
+
+    rStats = sStats;
+}
+
+void SPIFFSFS::format(void)
+{
+    std::lock_guard<std::mutex> lock(*spLock);
+
+    spFiles->clear();
+}
+
+void SPIFFSFS::setWriteDelay(const uint32_t kDelayUs)
+{
+    sWriteDelayUs.store(kDelayUs);
+}
@@ -0,0 +1,75 @@
+/*******************************************************************************
+ * @file SPIFFS.h
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief Host SPIFFS driver.
+ *
+ * @details This file provides the SPIFFS services on the host. The files are
+ * kept in memory for the life of the process and the writes are counted. The
+ * writes can be slowed down to simulate the flash stalls.
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+#ifndef __MOCKS_SPIFFS_H_
+#define __MOCKS_SPIFFS_H_
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+
+#include <cstdint> /* Standard Int Types */
+#include <cstddef> /* size_t */
+#include <FS.h>    /* Filesystem services */
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+/* Size of the data partition */
+#define SPIFFS_MOCK_SIZE 0x160000
+
+/*******************************************************************************
+ * STRUCTURES AND TYPES
+ ******************************************************************************/
+
+/* Flash writes since the filesystem was mounted */
+typedef struct
+{
+    uint64_t bytesWritten;
+    uint32_t writeCount;
+    /* Largest single write and writes made while a frame was sent */
+    uint32_t maxWriteSize;
+    uint32_t showWriteCount;
+} SSpiffsStats;
+
+/*******************************************************************************
+ * CLASSES
+ ******************************************************************************/
+
+class SPIFFSFS
+{
+    public:
+        bool begin(const bool kFormatOnFail);
+        bool exists(const char* kpPath);
+        bool remove(const char* kpPath);
+        bool rename(const char* kpFrom, const char* kpTo);
+        File open(const char* kpPath, const char* kpMode = FILE_READ);
+
+        size_t totalBytes(void);
+        size_t usedBytes(void);
+
+        /* Host only services */
+        void getStats(SSpiffsStats& rStats);
+        void format(void);
+        void setWriteDelay(const uint32_t kDelayUs);
+};
+
+extern SPIFFSFS SPIFFS;
+
+#endif /* #ifndef __MOCKS_SPIFFS_H_ */
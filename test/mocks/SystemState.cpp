@@ -0,0 +1,115 @@
+/*******************************************************************************
+ * @file SystemState.cpp
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief Host system state service.
+ *
+ * @details This file provides the system state services used by the strips
+ * manager on the host. There is no screen and no button on the host, only the
+ * brightness is kept.
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include <cstdint>         /* Standard Int Types */
+#include <OLED.h>          /* OLED screen manager */
+#include <StripsManager.h> /* Strips manager */
+
+/* Header File */
+#include <SystemState.h>
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * STRUCTURES AND TYPES
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/************************* Imported global variables **************************/
+/* None */
+
+/************************* Exported global variables **************************/
+SystemState* SystemState::PINSTANCE_ = nullptr;
+
+/************************** Static global variables ***************************/
+/* None */
+
+/*******************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * CLASS METHODS
+ ******************************************************************************/
+
+OLED::OLED(void)
+{
+    pDisplay_ = nullptr;
+}
+
+OLED::~OLED(void)
+{
+}
+
+SystemState* SystemState::GetInstance(void)
+{
+    if(SystemState::PINSTANCE_ == nullptr)
+    {
+        SystemState::PINSTANCE_ = new SystemState();
+    }
+
+    return SystemState::PINSTANCE_;
+}
+
+void SystemState::SetBrightness(const uint8_t kNewBrightness)
+{
+    currentBrightness_ = kNewBrightness;
+    StripsManager::GetInstance()->NotifyBrightnessUpdate();
+}
+
+uint8_t SystemState::GetBrightness(void) const
+{
+    return currentBrightness_;
+}
+
+void SystemState::NotifyUpdate(void)
+{
+    displayNeedUpdate_ = true;
+}
+
+SystemState::SystemState(void)
+{
+    currentBrightness_ = 255;
+    displayNeedUpdate_ = false;
+}
@@ -0,0 +1,71 @@
+/*******************************************************************************
+ * @file TestPattern.cpp
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief Test patterns builder.
+ *
+ * @details This file builds the patterns used by the unit tests and
+ * benchmarks.
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include <cstdint> /* Standard Int Types */
+#include <memory>  /* std::shared_ptr */
+#include <vector>  /* std::vector */
+#include <Pattern.h> /* Pattern object */
+
+/* Header File */
+#include <TestPattern.h>
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+std::shared_ptr<Pattern> MakeTestPattern(const STestPattern& krConfig)
+{
+    std::shared_ptr<Pattern> pattern;
+    std::vector<SColor>      colors;
+    std::vector<SAnimation>  anims;
+    uint16_t                 ledsPerColor;
+    uint16_t                 ledsPerAnim;
+    uint8_t                  i;
+
+    pattern = std::make_shared<Pattern>(krConfig.id, krConfig.kpName);
+
+    ledsPerColor = krConfig.ledCount / krConfig.colorCount;
+    for(i = 0; i < krConfig.colorCount; ++i)
+    {
+        colors.push_back({
+            .startIdx       = (uint16_t)(i * ledsPerColor),
+            .endIdx         = (uint16_t)((i + 1) * ledsPerColor - 1),
+            .startColorCode = 0xFF0000U >> i,
+            .endColorCode   = 0x0000FFU << i
+        });
+    }
+    /* The trails of a pattern cannot overlap */
+    ledsPerAnim = (krConfig.animCount == 0) ? 0 :
+                  krConfig.ledCount / krConfig.animCount;
+    for(i = 0; i < krConfig.animCount; ++i)
+    {
+        anims.push_back({
+            .type     = (i % 2 == 0) ? ANIM_TRAIL : ANIM_BREATH,
+            .startIdx = (uint16_t)(i * ledsPerAnim),
+            .endIdx   = (uint16_t)((i + 1) * ledsPerAnim - 1),
+            .param    = (uint16_t)(ANIM_SPEED_UNIT * (i + 1))
+        });
+    }
+    pattern->SetColors(colors);
+    pattern->SetAnimations(anims);
+    pattern->SetBrightness(krConfig.brightness);
+
+    return pattern;
+}
@@ -0,0 +1,61 @@
+/*******************************************************************************
+ * @file TestPattern.h
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief Test patterns builder.
+ *
+ * @details This file provides the patterns used by the unit tests and
+ * benchmarks. The patterns are built from a few parameters so the tests can
+ * size them to their measures.
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+#ifndef __MOCKS_TEST_PATTERN_H_
+#define __MOCKS_TEST_PATTERN_H_
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+
+#include <cstdint> /* Standard Int Types */
+#include <memory>  /* std::shared_ptr */
+#include <Pattern.h> /* Pattern object */
+
+/*******************************************************************************
+ * STRUCTURES AND TYPES
+ ******************************************************************************/
+
+typedef struct
+{
+    uint16_t    id;
+    const char* kpName;
+    uint16_t    ledCount;
+    /* Gradients splitting the LEDs evenly */
+    uint8_t     colorCount;
+    /* Trail and breath animations in turn on slices splitting the LEDs
+     * evenly, the first one runs at the unit speed.
+     */
+    uint8_t     animCount;
+    uint8_t     brightness;
+} STestPattern;
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+/**
+ * @brief Builds a test pattern.
+ *
+ * @param[in] krConfig The pattern parameters.
+ *
+ * @return The new pattern.
+ */
+std::shared_ptr<Pattern> MakeTestPattern(const STestPattern& krConfig);
+
+#endif /* #ifndef __MOCKS_TEST_PATTERN_H_ */
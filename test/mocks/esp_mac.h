@@ -0,0 +1,43 @@
+/*******************************************************************************
+ * @file esp_mac.h
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief Host ESP-IDF MAC services.
+ *
+ * @details This file provides the MAC address services on the host, the
+ * address is fixed.
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+#ifndef __MOCKS_ESP_MAC_H_
+#define __MOCKS_ESP_MAC_H_
+
+#include <cstdint> /* Standard Int Types */
+
+typedef enum
+{
+    ESP_MAC_WIFI_STA = 0,
+    ESP_MAC_WIFI_SOFTAP,
+    ESP_MAC_BT,
+    ESP_MAC_ETH
+} esp_mac_type_t;
+
+inline int esp_read_mac(uint8_t* pMac, const esp_mac_type_t kType)
+{
+    uint8_t i;
+
+    for(i = 0; i < 6; ++i)
+    {
+        pMac[i] = (uint8_t)(0x10 * i + kType);
+    }
+
+    return 0;
+}
+
+#endif /* #ifndef __MOCKS_ESP_MAC_H_ */
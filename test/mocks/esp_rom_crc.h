@@ -0,0 +1,43 @@
+/*******************************************************************************
+ * @file esp_rom_crc.h
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief Host ESP-IDF ROM CRC services.
+ *
+ * @details This file provides the ROM CRC32 on the host, it uses the
+ * reflected IEEE 802.3 polynomial as the ROM function.
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+#ifndef __MOCKS_ESP_ROM_CRC_H_
+#define __MOCKS_ESP_ROM_CRC_H_
+
+#include <cstdint> /* Standard Int Types */
+
+inline uint32_t esp_rom_crc32_le(uint32_t       crc,
+                                 const uint8_t* kpBuffer,
+                                 const uint32_t kSize)
+{
+    uint32_t i;
+    uint8_t  j;
+
+    crc = ~crc;
+    for(i = 0; i < kSize; ++i)
+    {
+        crc ^= kpBuffer[i];
+        for(j = 0; j < 8; ++j)
+        {
+            crc = (crc >> 1) ^ (0xEDB88320U & (0U - (crc & 1)));
+        }
+    }
+
+    return ~crc;
+}
+
+#endif /* #ifndef __MOCKS_ESP_ROM_CRC_H_ */
@@ -0,0 +1,163 @@
+/*******************************************************************************
+ * @file esp_timer.cpp
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief Host ESP-IDF timer services.
+ *
+ * @details This file implements the one shot timers on the host with a thread
+ * per timer. The timers are never deleted, the firmware creates them once.
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include <cstdint>            /* Standard Int Types */
+#include <chrono>             /* std::chrono */
+#include <mutex>              /* std::mutex */
+#include <condition_variable> /* std::condition_variable */
+#include <thread>             /* std::thread */
+
+/* Header File */
+#include <esp_timer.h>
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * STRUCTURES AND TYPES
+ ******************************************************************************/
+
+struct esp_timer
+{
+    esp_timer_cb_t                        callback;
+    void*                                 pArg;
+    std::mutex                            lock;
+    std::condition_variable               update;
+    std::chrono::steady_clock::time_point deadline;
+    bool                                  isArmed;
+};
+
+/*******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/************************* Imported global variables **************************/
+/* None */
+
+/************************* Exported global variables **************************/
+/* None */
+
+/************************** Static global variables ***************************/
+/* None */
+
+/*******************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ ******************************************************************************/
+
+/**
+ * @brief Timer thread routine, calls the callback when the armed timer
+ * expires.
+ *
+ * @param[in] pTimer The timer.
+ */
+static void TimerRoutine(esp_timer_handle_t pTimer);
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+static void TimerRoutine(esp_timer_handle_t pTimer)
+{
+    std::unique_lock<std::mutex> lock(pTimer->lock);
+
+    while(1)
+    {
+        if(pTimer->isArmed == false)
+        {
+            pTimer->update.wait(lock);
+        }
+        else if(pTimer->update.wait_until(lock, pTimer->deadline) ==
+                std::cv_status::timeout &&
+                pTimer->isArmed == true &&
+                std::chrono::steady_clock::now() >= pTimer->deadline)
+        {
+            pTimer->isArmed = false;
+
+            /* The callback may start the timer again */
+            lock.unlock();
+            pTimer->callback(pTimer->pArg);
+            lock.lock();
+        }
+    }
+}
+
+esp_err_t esp_timer_create(const esp_timer_create_args_t* kpArgs,
+                           esp_timer_handle_t*            pHandle)
+{
+    esp_timer_handle_t pTimer;
+
+    if(kpArgs == nullptr || kpArgs->callback == nullptr || pHandle == nullptr)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    pTimer           = new esp_timer();
+    pTimer->callback = kpArgs->callback;
+    pTimer->pArg     = kpArgs->arg;
+    pTimer->isArmed  = false;
+
+    std::thread(TimerRoutine, pTimer).detach();
+
+    *pHandle = pTimer;
+
+    return ESP_OK;
+}
+
+esp_err_t esp_timer_start_once(esp_timer_handle_t pTimer,
+                               const uint64_t     kTimeoutUs)
+{
+    std::lock_guard<std::mutex> lock(pTimer->lock);
+
+    if(pTimer->isArmed == true)
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    pTimer->deadline = std::chrono::steady_clock::now() +
+                       std::chrono::microseconds(kTimeoutUs);
+    pTimer->isArmed  = true;
+    pTimer->update.notify_one();
+
+    return ESP_OK;
+}
+
+esp_err_t esp_timer_stop(esp_timer_handle_t pTimer)
+{
+    std::lock_guard<std::mutex> lock(pTimer->lock);
+
+    if(pTimer->isArmed == false)
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    pTimer->isArmed = false;
+    pTimer->update.notify_one();
+
+    return ESP_OK;
+}
@@ -0,0 +1,71 @@
+/*******************************************************************************
+ * @file esp_timer.h
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief Host ESP-IDF timer services.
+ *
+ * @details This file provides the high resolution timer services on the
+ * host. Each timer has its own thread that calls the timer callback, as the
+ * timer task does on the target.
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+#ifndef __MOCKS_ESP_TIMER_H_
+#define __MOCKS_ESP_TIMER_H_
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+
+#include <cstdint>   /* Standard Int Types */
+#include <Arduino.h> /* esp_timer_get_time */
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+#define ESP_OK                0
+#define ESP_ERR_INVALID_ARG   0x102
+#define ESP_ERR_INVALID_STATE 0x103
+
+/*******************************************************************************
+ * STRUCTURES AND TYPES
+ ******************************************************************************/
+
+typedef int esp_err_t;
+
+typedef void (*esp_timer_cb_t)(void* pArg);
+
+typedef enum
+{
+    ESP_TIMER_TASK = 0
+} esp_timer_dispatch_t;
+
+typedef struct
+{
+    esp_timer_cb_t       callback;
+    void*                arg;
+    esp_timer_dispatch_t dispatch_method;
+    const char*          name;
+    bool                 skip_unhandled_events;
+} esp_timer_create_args_t;
+
+typedef struct esp_timer* esp_timer_handle_t;
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+esp_err_t esp_timer_create(const esp_timer_create_args_t* kpArgs,
+                           esp_timer_handle_t*            pHandle);
+esp_err_t esp_timer_start_once(esp_timer_handle_t pTimer,
+                               const uint64_t     kTimeoutUs);
+esp_err_t esp_timer_stop(esp_timer_handle_t pTimer);
+
+#endif /* #ifndef __MOCKS_ESP_TIMER_H_ */
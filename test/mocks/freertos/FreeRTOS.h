@@ -0,0 +1,121 @@
+/*******************************************************************************
+ * @file FreeRTOS.h
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief Host FreeRTOS kernel.
+ *
+ * @details This file provides the FreeRTOS services used by the firmware on
+ * host threads. Each task is a thread, the priorities and cores are recorded
+ * but not enforced. A tick lasts one millisecond.
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+#ifndef __MOCKS_FREERTOS_H_
+#define __MOCKS_FREERTOS_H_
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+
+#include <cstdint> /* Standard Int Types */
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+#define pdTRUE  1
+#define pdFALSE 0
+#define pdPASS  pdTRUE
+#define pdFAIL  pdFALSE
+
+#define portMAX_DELAY      0xFFFFFFFFU
+#define portTICK_PERIOD_MS 1
+
+#define configMAX_PRIORITIES 25
+#define tskIDLE_PRIORITY     0
+#define tskNO_AFFINITY       0x7FFFFFFF
+
+/*******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+#define pdMS_TO_TICKS(MS) ((TickType_t)(MS))
+
+/*******************************************************************************
+ * STRUCTURES AND TYPES
+ ******************************************************************************/
+
+typedef uint32_t     TickType_t;
+typedef int          BaseType_t;
+typedef unsigned int UBaseType_t;
+
+typedef struct SHostTask*       TaskHandle_t;
+typedef struct SHostSemaphore*  SemaphoreHandle_t;
+typedef struct SHostEventGroup* EventGroupHandle_t;
+typedef uint32_t                EventBits_t;
+
+typedef void (*TaskFunction_t)(void*);
+
+typedef enum
+{
+    eNoAction = 0,
+    eSetBits,
+    eIncrement,
+    eSetValueWithOverwrite,
+    eSetValueWithoutOverwrite
+} eNotifyAction;
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t     pRoutine,
+                                   const char*        kpName,
+                                   const uint32_t     kStackSize,
+                                   void*              pParam,
+                                   const UBaseType_t  kPriority,
+                                   TaskHandle_t*      pHandle,
+                                   const BaseType_t   kCore);
+TaskHandle_t xTaskGetCurrentTaskHandle(void);
+BaseType_t xPortGetCoreID(void);
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t pTask);
+void vTaskDelay(const TickType_t kTicks);
+TickType_t xTaskGetTickCount(void);
+
+BaseType_t xTaskNotify(TaskHandle_t        pTask,
+                       const uint32_t      kValue,
+                       const eNotifyAction kAction);
+BaseType_t xTaskNotifyGive(TaskHandle_t pTask);
+BaseType_t xTaskNotifyWait(const uint32_t   kClearOnEntry,
+                           const uint32_t   kClearOnExit,
+                           uint32_t*        pValue,
+                           const TickType_t kTicks);
+uint32_t ulTaskNotifyTake(const BaseType_t kClear, const TickType_t kTicks);
+uint32_t ulTaskNotifyValueClear(TaskHandle_t pTask, const uint32_t kBits);
+
+SemaphoreHandle_t xSemaphoreCreateBinary(void);
+SemaphoreHandle_t xSemaphoreCreateCounting(const UBaseType_t kMax,
+                                           const UBaseType_t kInitial);
+SemaphoreHandle_t xSemaphoreCreateMutex(void);
+SemaphoreHandle_t xSemaphoreCreateRecursiveMutex(void);
+BaseType_t xSemaphoreTake(SemaphoreHandle_t pSem, const TickType_t kTicks);
+BaseType_t xSemaphoreGive(SemaphoreHandle_t pSem);
+BaseType_t xSemaphoreTakeRecursive(SemaphoreHandle_t pSem,
+                                   const TickType_t  kTicks);
+BaseType_t xSemaphoreGiveRecursive(SemaphoreHandle_t pSem);
+UBaseType_t uxSemaphoreGetCount(SemaphoreHandle_t pSem);
+
+EventGroupHandle_t xEventGroupCreate(void);
+EventBits_t xEventGroupSetBits(EventGroupHandle_t pGroup,
+                               const EventBits_t  kBits);
+EventBits_t xEventGroupClearBits(EventGroupHandle_t pGroup,
+                                 const EventBits_t  kBits);
+EventBits_t xEventGroupGetBits(EventGroupHandle_t pGroup);
+
+#endif /* #ifndef __MOCKS_FREERTOS_H_ */
@@ -0,0 +1,23 @@
+/*******************************************************************************
+ * @file task.h
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief Host FreeRTOS kernel.
+ *
+ * @details This file is provided for the includes of the firmware, the
+ * services are declared in FreeRTOS.h.
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+#ifndef __MOCKS_FREERTOS_TASK_H_
+#define __MOCKS_FREERTOS_TASK_H_
+
+#include <freertos/FreeRTOS.h> /* FreeRTOS services */
+
+#endif /* #ifndef __MOCKS_FREERTOS_TASK_H_ */
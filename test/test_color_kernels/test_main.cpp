@@ -0,0 +1,271 @@
+/*******************************************************************************
+ * @file test_main.cpp
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief Color kernels microbenchmark.
+ *
+ * @details This file checks the fill and scale kernels of the build, scalar
+ * or packed, against the byte-wise reference for every alignment and reports
+ * the throughput of each kernel in pixels per microsecond.
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include <cstdint>        /* Standard Int Types */
+#include <cstdio>         /* snprintf */
+#include <cstring>        /* memcmp */
+#include <vector>         /* std::vector */
+#include <unity.h>        /* Unit tests */
+#include <HWLayer.h>      /* Time services */
+#include <ColorKernels.h> /* Color rendering kernels */
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+/* Pixels of the benchmark buffers, a long strip */
+#define BENCH_PIXELS 1024
+
+/* Runs of each benchmark */
+#define BENCH_RUNS 20000
+
+/* Longest run checked against the reference */
+#define CHECK_PIXELS_MAX 37
+
+/*******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * STRUCTURES AND TYPES
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/************************* Imported global variables **************************/
+/* None */
+
+/************************* Exported global variables **************************/
+/* None */
+
+/************************** Static global variables ***************************/
+static uint8_t spSrc[BENCH_PIXELS * COLOR_KERNELS_PIXEL_SIZE + 4];
+static uint8_t spDst[BENCH_PIXELS * COLOR_KERNELS_PIXEL_SIZE + 4];
+static uint8_t spRef[BENCH_PIXELS * COLOR_KERNELS_PIXEL_SIZE + 4];
+static uint8_t spIndices[BENCH_PIXELS];
+static uint8_t spPalette[256 * COLOR_KERNELS_PIXEL_SIZE];
+
+/*******************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+void setUp(void)
+{
+    uint32_t i;
+
+    for(i = 0; i < sizeof(spSrc); ++i)
+    {
+        spSrc[i] = (uint8_t)(i * 37 + 11);
+    }
+    for(i = 0; i < sizeof(spIndices); ++i)
+    {
+        spIndices[i] = (uint8_t)(i * 7);
+    }
+    for(i = 0; i < sizeof(spPalette); ++i)
+    {
+        spPalette[i] = (uint8_t)(i * 13);
+    }
+}
+
+void tearDown(void)
+{
+}
+
+/* Byte-wise references of the packed kernels */
+static void RefFill(uint8_t*       pPixels,
+                    const uint32_t kCount,
+                    const uint32_t kColorCode)
+{
+    uint32_t i;
+
+    for(i = 0; i < kCount; ++i)
+    {
+        pPixels[i * 3]     = (uint8_t)(kColorCode >> 16);
+        pPixels[i * 3 + 1] = (uint8_t)(kColorCode >> 8);
+        pPixels[i * 3 + 2] = (uint8_t)kColorCode;
+    }
+}
+
+static void RefScale(uint8_t*       pDst,
+                     const uint8_t* kpSrc,
+                     const uint32_t kCount,
+                     const uint8_t  kScale)
+{
+    uint32_t i;
+
+    for(i = 0; i < kCount * COLOR_KERNELS_PIXEL_SIZE; ++i)
+    {
+        pDst[i] = (uint8_t)(((uint32_t)kpSrc[i] * ((uint32_t)kScale + 1)) >>
+                            8);
+    }
+}
+
+static void Report(const char* kpName, const uint64_t kTimeUs)
+{
+    char pMessage[96];
+
+    snprintf(pMessage,
+             sizeof(pMessage),
+             "%-14s %8.1f px/us",
+             kpName,
+             (double)BENCH_PIXELS * BENCH_RUNS /
+             (double)(kTimeUs == 0 ? 1 : kTimeUs));
+    TEST_MESSAGE(pMessage);
+}
+
+static void TestFillExact(void)
+{
+    uint32_t offset;
+    uint32_t count;
+
+    for(offset = 0; offset < 4; ++offset)
+    {
+        for(count = 0; count <= CHECK_PIXELS_MAX; ++count)
+        {
+            memset(spDst, 0xA5, sizeof(spDst));
+            memset(spRef, 0xA5, sizeof(spRef));
+            ColorKernels::Fill(spDst + offset, count, 0x123456);
+            RefFill(spRef + offset, count, 0x123456);
+            TEST_ASSERT_EQUAL_MEMORY(spRef, spDst, sizeof(spRef));
+        }
+    }
+}
+
+static void TestScaleExact(void)
+{
+    uint32_t srcOffset;
+    uint32_t dstOffset;
+    uint32_t count;
+    uint32_t scale;
+
+    for(srcOffset = 0; srcOffset < 4; ++srcOffset)
+    {
+        for(dstOffset = 0; dstOffset < 4; ++dstOffset)
+        {
+            for(count = 0; count <= CHECK_PIXELS_MAX; ++count)
+            {
+                for(scale = 0; scale < 256; scale += 17)
+                {
+                    memset(spDst, 0xA5, sizeof(spDst));
+                    memset(spRef, 0xA5, sizeof(spRef));
+                    ColorKernels::Scale(spDst + dstOffset,
+                                        spSrc + srcOffset,
+                                        count,
+                                        (uint8_t)scale);
+                    RefScale(spRef + dstOffset,
+                             spSrc + srcOffset,
+                             count,
+                             (uint8_t)scale);
+                    TEST_ASSERT_EQUAL_MEMORY(spRef, spDst, sizeof(spRef));
+                }
+            }
+        }
+    }
+}
+
+static void TestBenchKernels(void)
+{
+    uint32_t i;
+    uint64_t startTime;
+
+    startTime = HWLayer::GetTime();
+    for(i = 0; i < BENCH_RUNS; ++i)
+    {
+        ColorKernels::Fill(spDst, BENCH_PIXELS, i);
+    }
+    Report("Fill", HWLayer::GetTime() - startTime);
+
+    startTime = HWLayer::GetTime();
+    for(i = 0; i < BENCH_RUNS; ++i)
+    {
+        RefFill(spRef, BENCH_PIXELS, i);
+    }
+    Report("Fill ref", HWLayer::GetTime() - startTime);
+    TEST_ASSERT_EQUAL_MEMORY(spRef,
+                             spDst,
+                             BENCH_PIXELS * COLOR_KERNELS_PIXEL_SIZE);
+
+    startTime = HWLayer::GetTime();
+    for(i = 0; i < BENCH_RUNS; ++i)
+    {
+        ColorKernels::Gradient(spDst, BENCH_PIXELS, i, 0xFFFFFF - i);
+    }
+    Report("Gradient", HWLayer::GetTime() - startTime);
+
+    startTime = HWLayer::GetTime();
+    for(i = 0; i < BENCH_RUNS; ++i)
+    {
+        ColorKernels::Scale(spDst, spSrc, BENCH_PIXELS, (uint8_t)i | 1);
+    }
+    Report("Scale", HWLayer::GetTime() - startTime);
+
+    startTime = HWLayer::GetTime();
+    for(i = 0; i < BENCH_RUNS; ++i)
+    {
+        RefScale(spRef, spSrc, BENCH_PIXELS, (uint8_t)i | 1);
+    }
+    Report("Scale ref", HWLayer::GetTime() - startTime);
+    TEST_ASSERT_EQUAL_MEMORY(spRef,
+                             spDst,
+                             BENCH_PIXELS * COLOR_KERNELS_PIXEL_SIZE);
+
+    startTime = HWLayer::GetTime();
+    for(i = 0; i < BENCH_RUNS; ++i)
+    {
+        ColorKernels::Scale(spDst + 1, spSrc + 2, BENCH_PIXELS, (uint8_t)i);
+    }
+    Report("Scale unalign", HWLayer::GetTime() - startTime);
+
+    startTime = HWLayer::GetTime();
+    for(i = 0; i < BENCH_RUNS; ++i)
+    {
+        ColorKernels::Expand(spDst, spIndices, spPalette, BENCH_PIXELS);
+    }
+    Report("Expand", HWLayer::GetTime() - startTime);
+
+    startTime = HWLayer::GetTime();
+    for(i = 0; i < BENCH_RUNS; ++i)
+    {
+        ColorKernels::Blend(spDst, spSrc, spRef, BENCH_PIXELS, i & 0xFF);
+    }
+    Report("Blend", HWLayer::GetTime() - startTime);
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(TestFillExact);
+    RUN_TEST(TestScaleExact);
+    RUN_TEST(TestBenchKernels);
+    return UNITY_END();
+}
@@ -0,0 +1,211 @@
+/*******************************************************************************
+ * @file test_main.cpp
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief Flash writes scheduling test.
+ *
+ * @details This file commits a batch of 50 patterns to a slow host flash
+ * while the LED worker animates a scene. Each flash write stalls for
+ * FLASH_WRITE_DELAY_US, the journal writes it in chunks that are scheduled
+ * between the frames by the manager frame gaps. The test checks that the
+ * frame deadlines are met and that no write overlaps a frame transmission.
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include <cstdint>         /* Standard Int Types */
+#include <cstdio>          /* snprintf */
+#include <chrono>          /* std::chrono */
+#include <memory>          /* std::shared_ptr */
+#include <thread>          /* std::thread */
+#include <vector>          /* std::vector */
+#include <unity.h>         /* Unit tests */
+#include <SPIFFS.h>        /* Slow flash */
+#include <Journal.h>       /* Journal chunks */
+#include <Pattern.h>       /* Pattern object */
+#include <PatternTable.h>  /* Pattern identifiers */
+#include <Storage.h>       /* Storage service */
+#include <SystemState.h>   /* System state */
+#include <StripsManager.h> /* Strips manager */
+#include <TestPattern.h>   /* Test patterns */
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+/* Patterns committed in one batch */
+#define BATCH_PATTERN_COUNT 50
+
+/* Colors of the batch patterns, sized so a record spans several chunks */
+#define BATCH_COLOR_COUNT 24
+
+/* Duration of a flash write */
+#define FLASH_WRITE_DELAY_US 2000
+
+/* Number of LEDs of the patterns, the longest default strip */
+#define PATTERN_LED_COUNT 120
+
+/* Default strips identifiers */
+#define STRIP_0_ID 4
+#define STRIP_1_ID 5
+
+/*******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * STRUCTURES AND TYPES
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/************************* Imported global variables **************************/
+/* None */
+
+/************************* Exported global variables **************************/
+/* None */
+
+/************************** Static global variables ***************************/
+static StripsManager* spManager;
+
+static const STestPattern skBatchPattern = {
+    .id         = PATTERN_TABLE_NO_ID,
+    .kpName     = "Batch",
+    .ledCount   = PATTERN_LED_COUNT,
+    .colorCount = BATCH_COLOR_COUNT,
+    .animCount  = 1,
+    .brightness = 200
+};
+
+/*******************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+static void TestSlowFlashBatchCommit(void)
+{
+    SSpiffsStats                          fsStart;
+    SSpiffsStats                          fsEnd;
+    SFrameStats                           frameStats;
+    SStorageStats                         storageStats;
+    uint32_t                              writeCount;
+    uint64_t                              writtenBytes;
+    uint16_t                              i;
+    std::chrono::steady_clock::time_point start;
+    std::chrono::milliseconds             elapsed;
+    char                                  msg[200];
+
+    SPIFFS.setWriteDelay(FLASH_WRITE_DELAY_US);
+    SPIFFS.getStats(fsStart);
+    spManager->ResetFrameStats();
+
+    /* Commit the batch and write it to the flash right away */
+    start = std::chrono::steady_clock::now();
+    spManager->BeginBatch();
+    for(i = 0; i < BATCH_PATTERN_COUNT; ++i)
+    {
+        TEST_ASSERT_NOT_EQUAL(PATTERN_TABLE_NO_ID,
+                              spManager->AddPattern(
+                                            MakeTestPattern(skBatchPattern)));
+    }
+    spManager->CommitBatch();
+    Storage::GetInstance()->Flush();
+    elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+                                    std::chrono::steady_clock::now() - start);
+
+    spManager->GetFrameStats(frameStats);
+    SPIFFS.getStats(fsEnd);
+    Storage::GetInstance()->GetStorageStats(storageStats);
+    SPIFFS.setWriteDelay(0);
+
+    writeCount   = fsEnd.writeCount - fsStart.writeCount;
+    writtenBytes = fsEnd.bytesWritten - fsStart.bytesWritten;
+
+    snprintf(msg, sizeof(msg),
+             "%d patterns: %llu bytes in %u writes of at most %u bytes, "
+             "%lld ms, longest stall %u us",
+             BATCH_PATTERN_COUNT, (unsigned long long)writtenBytes,
+             writeCount, fsEnd.maxWriteSize, (long long)elapsed.count(),
+             storageStats.lastCommitStallUs);
+    TEST_MESSAGE(msg);
+    snprintf(msg, sizeof(msg),
+             "%u frames, jitter mean %u us, max %u us, %u missed deadlines, "
+             "%u writes during a frame",
+             frameStats.frameCount, frameStats.meanJitterUs,
+             frameStats.maxJitterUs, frameStats.missedDeadlines,
+             fsEnd.showWriteCount - fsStart.showWriteCount);
+    TEST_MESSAGE(msg);
+
+    /* The batch is written in chunks, each one a flash stall */
+    TEST_ASSERT_TRUE(writtenBytes > 4 * JOURNAL_CHUNK_SIZE);
+    TEST_ASSERT_LESS_OR_EQUAL(JOURNAL_CHUNK_SIZE, fsEnd.maxWriteSize);
+    TEST_ASSERT_TRUE(writeCount >= writtenBytes / JOURNAL_CHUNK_SIZE);
+    TEST_ASSERT_TRUE(storageStats.lastCommitStallUs >= FLASH_WRITE_DELAY_US);
+
+    /* The chunks are written in the frame gaps, the frames are on time */
+    TEST_ASSERT_GREATER_THAN(0, frameStats.frameCount);
+    TEST_ASSERT_EQUAL(0, frameStats.missedDeadlines);
+    TEST_ASSERT_EQUAL(fsStart.showWriteCount, fsEnd.showWriteCount);
+}
+
+int main(void)
+{
+    std::shared_ptr<SScene> scene;
+    STestPattern            patternConfig;
+    uint16_t                patternId;
+    uint8_t                 sceneIdx;
+
+    Storage::GetInstance()->LoadData();
+    SystemState::GetInstance();
+    spManager = StripsManager::GetInstance();
+
+    /* Animated scene on both default strips */
+    patternConfig            = skBatchPattern;
+    patternConfig.colorCount = 1;
+    patternId = spManager->AddPattern(MakeTestPattern(patternConfig));
+
+    scene = std::make_shared<SScene>();
+    scene->name         = "Flash";
+    scene->fps          = 0;
+    scene->transition   = LED_TRANSITION_CUT;
+    scene->transitionMs = 0;
+    scene->links.Set(STRIP_0_ID, patternId);
+    scene->links.Set(STRIP_1_ID, patternId);
+    sceneIdx = spManager->AddScene(scene);
+    spManager->SelectScene(sceneIdx);
+
+    /* Write the setup before the measure */
+    Storage::GetInstance()->Flush();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    UNITY_BEGIN();
+    RUN_TEST(TestSlowFlashBatchCommit);
+    return UNITY_END();
+}
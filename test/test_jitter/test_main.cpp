@@ -0,0 +1,273 @@
+/*******************************************************************************
+ * @file test_main.cpp
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief LED worker jitter stress test.
+ *
+ * @details This file measures the frame time jitter of the LED worker while a
+ * thread updates patterns in a loop. The updated pattern is first unlinked,
+ * then linked to the selected scene with its brightness toggled so the strips
+ * are powered on and off while the frames are rendered and sent.
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include <cstdint>         /* Standard Int Types */
+#include <cstdio>          /* snprintf */
+#include <atomic>          /* std::atomic */
+#include <chrono>          /* std::chrono */
+#include <memory>          /* std::shared_ptr */
+#include <thread>          /* std::thread */
+#include <vector>          /* std::vector */
+#include <unity.h>         /* Unit tests */
+#include <FastLED.h>       /* Frames counter */
+#include <Pattern.h>       /* Pattern object */
+#include <PatternTable.h>  /* Pattern identifiers */
+#include <Storage.h>       /* Storage service */
+#include <SystemState.h>   /* System state */
+#include <StripsManager.h> /* Strips manager */
+#include <TestPattern.h>   /* Test patterns */
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+/* Duration of each measure */
+#define MEASURE_DURATION_MS 1500
+
+/* Tolerance on the number of frames of a measure, in percent */
+#define FRAME_COUNT_TOLERANCE 10
+
+/* Number of LEDs of the patterns, the longest default strip */
+#define PATTERN_LED_COUNT 120
+
+/* Default strips identifiers */
+#define STRIP_0_ID 4
+#define STRIP_1_ID 5
+
+/*******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * STRUCTURES AND TYPES
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/************************* Imported global variables **************************/
+/* None */
+
+/************************* Exported global variables **************************/
+/* None */
+
+/************************** Static global variables ***************************/
+static StripsManager*    spManager;
+static uint16_t          sLinkedId;
+static uint16_t          sUnlinkedId;
+static std::atomic<bool> sIsHammering;
+static uint32_t          sUpdateCount;
+
+static const STestPattern skStressPattern = {
+    .id         = PATTERN_TABLE_NO_ID,
+    .kpName     = "Stress",
+    .ledCount   = PATTERN_LED_COUNT,
+    .colorCount = 1,
+    .animCount  = 1,
+    .brightness = 200
+};
+
+/*******************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+static void HammerRoutine(const uint16_t kPatternId, const bool kToggle)
+{
+    STestPattern patternConfig;
+
+    sUpdateCount     = 0;
+    patternConfig    = skStressPattern;
+    patternConfig.id = kPatternId;
+    while(sIsHammering.load() == true)
+    {
+        if(kToggle == true)
+        {
+            patternConfig.brightness = (patternConfig.brightness == 0) ?
+                                       200 : 0;
+        }
+        spManager->UpdatePattern(MakeTestPattern(patternConfig));
+        ++sUpdateCount;
+    }
+}
+
+static void MeasureFrames(const char*    kpName,
+                          const uint16_t kPatternId,
+                          const bool     kToggle,
+                          SFrameStats&   rStats)
+{
+    std::thread hammer;
+    char        pMessage[160];
+
+    if(kpName != nullptr)
+    {
+        sIsHammering.store(true);
+        hammer = std::thread(HammerRoutine, kPatternId, kToggle);
+    }
+
+    spManager->ResetFrameStats();
+    std::this_thread::sleep_for(
+        std::chrono::milliseconds(MEASURE_DURATION_MS));
+    spManager->GetFrameStats(rStats);
+
+    if(kpName != nullptr)
+    {
+        sIsHammering.store(false);
+        hammer.join();
+    }
+
+    snprintf(pMessage,
+             sizeof(pMessage),
+             "%-10s %5u frames, %7u updates, jitter mean %5u us "
+             "(%u samples), max %5u us, %u missed deadlines",
+             kpName == nullptr ? "Idle" : kpName,
+             rStats.frameCount,
+             kpName == nullptr ? 0 : sUpdateCount,
+             rStats.meanJitterUs,
+             rStats.jitterSamples,
+             rStats.maxJitterUs,
+             rStats.missedDeadlines);
+    TEST_MESSAGE(pMessage);
+}
+
+static void CheckSchedule(const SFrameStats& krStats)
+{
+    uint32_t expectedCount;
+    uint32_t tolerance;
+
+    /* The frames are rendered at the scene frame rate */
+    TEST_ASSERT_GREATER_THAN(0, krStats.framePeriodUs);
+    expectedCount = (uint64_t)MEASURE_DURATION_MS * 1000 /
+                    krStats.framePeriodUs;
+    tolerance     = expectedCount * FRAME_COUNT_TOLERANCE / 100;
+    TEST_ASSERT_GREATER_THAN(expectedCount - tolerance, krStats.frameCount);
+    TEST_ASSERT_LESS_OR_EQUAL(expectedCount + tolerance, krStats.frameCount);
+
+    /* The frames are scheduled, no frame is a period early or late */
+    TEST_ASSERT_GREATER_THAN(krStats.frameCount / 2, krStats.jitterSamples);
+    TEST_ASSERT_LESS_OR_EQUAL(krStats.framePeriodUs, krStats.maxJitterUs);
+    TEST_ASSERT_LESS_OR_EQUAL(krStats.frameCount / 20,
+                              krStats.missedDeadlines);
+}
+
+static void TestIdleJitter(void)
+{
+    SFrameStats stats;
+
+    MeasureFrames(nullptr, 0, false, stats);
+
+    CheckSchedule(stats);
+}
+
+static void TestUnlinkedUpdateJitter(void)
+{
+    SFrameStats stats;
+
+    MeasureFrames("Unlinked", sUnlinkedId, false, stats);
+
+    /* The updates do not change the plan, the schedule is kept */
+    CheckSchedule(stats);
+}
+
+static void TestLinkedToggleJitter(void)
+{
+    SFrameStats       stats;
+    StripsInfoTable_t stripsInfo;
+    STestPattern      patternConfig;
+    uint32_t          pinWrites;
+    uint32_t          showCount;
+
+    pinWrites = HostGetShowPinWrites();
+
+    MeasureFrames("Linked", sLinkedId, true, stats);
+
+    /* The edits are rendered on the scheduled frames */
+    CheckSchedule(stats);
+
+    /* The strips are only powered on and off between two frames */
+    TEST_ASSERT_EQUAL(pinWrites, HostGetShowPinWrites());
+
+    /* The strips are powered on again and the frames sent */
+    patternConfig    = skStressPattern;
+    patternConfig.id = sLinkedId;
+    TEST_ASSERT_TRUE(spManager->UpdatePattern(MakeTestPattern(patternConfig)));
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    spManager->GetStripsInfo(stripsInfo);
+    TEST_ASSERT_EQUAL(2, stripsInfo.size());
+    TEST_ASSERT_TRUE(stripsInfo[0]->isEnabled);
+    TEST_ASSERT_TRUE(stripsInfo[1]->isEnabled);
+
+    showCount = FastLED.getShowCount();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    TEST_ASSERT_GREATER_THAN(showCount, FastLED.getShowCount());
+}
+
+int main(void)
+{
+    std::shared_ptr<SScene> scene;
+    uint8_t                 sceneIdx;
+
+    Storage::GetInstance()->LoadData();
+    SystemState::GetInstance();
+    spManager = StripsManager::GetInstance();
+
+    sLinkedId   = spManager->AddPattern(MakeTestPattern(skStressPattern));
+    sUnlinkedId = spManager->AddPattern(MakeTestPattern(skStressPattern));
+
+    scene = std::make_shared<SScene>();
+    scene->name         = "Stress";
+    scene->fps          = 0;
+    scene->transition   = LED_TRANSITION_CUT;
+    scene->transitionMs = 0;
+    scene->links.Set(STRIP_0_ID, sLinkedId);
+    scene->links.Set(STRIP_1_ID, sLinkedId);
+    sceneIdx = spManager->AddScene(scene);
+    spManager->SelectScene(sceneIdx);
+
+    /* Write the setup before the measures */
+    Storage::GetInstance()->Flush();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    UNITY_BEGIN();
+    RUN_TEST(TestIdleJitter);
+    RUN_TEST(TestUnlinkedUpdateJitter);
+    RUN_TEST(TestLinkedToggleJitter);
+    return UNITY_END();
+}
@@ -0,0 +1,343 @@
+/*******************************************************************************
+ * @file test_main.cpp
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief Pattern table benchmark.
+ *
+ * @details This file measures the pattern table add, remove and lookup times
+ * with 10000 patterns, and the heap bytes used per pattern and per scene. The
+ * heap is measured by counting the allocations and compared with the sizes
+ * reported by the objects for the manager heap report.
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include <cstdint>         /* Standard Int Types */
+#include <cstdio>          /* snprintf */
+#include <cstdlib>         /* malloc, free */
+#include <new>             /* std::bad_alloc */
+#include <atomic>          /* std::atomic */
+#include <chrono>          /* std::chrono */
+#include <memory>          /* std::shared_ptr */
+#include <vector>          /* std::vector */
+#include <malloc.h>        /* malloc_usable_size */
+#include <unity.h>         /* Unit tests */
+#include <Pattern.h>       /* Pattern object */
+#include <PatternTable.h>  /* Pattern table */
+#include <SceneLinks.h>    /* Scene links */
+#include <StripsManager.h> /* Scene object */
+#include <TestPattern.h>   /* Test patterns */
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+/* Number of patterns in the table */
+#define BENCH_PATTERN_COUNT 10000
+
+/* Number of lookups measured */
+#define BENCH_LOOKUP_COUNT 1000000
+
+/* Number of LEDs of the patterns */
+#define PATTERN_LED_COUNT 120
+
+/* Links of the measured scenes, inline and spilled */
+#define SCENE_SMALL_LINKS 2
+#define SCENE_LARGE_LINKS 8
+
+/*******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * STRUCTURES AND TYPES
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/************************* Imported global variables **************************/
+/* None */
+
+/************************* Exported global variables **************************/
+/* None */
+
+/************************** Static global variables ***************************/
+
+/* Heap bytes currently allocated by the process */
+static std::atomic<int64_t> sHeapBytes(0);
+
+static const STestPattern skBenchPattern = {
+    .id         = PATTERN_TABLE_NO_ID,
+    .kpName     = "Bench",
+    .ledCount   = PATTERN_LED_COUNT,
+    .colorCount = 1,
+    .animCount  = 1,
+    .brightness = 255
+};
+
+/*******************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+void* operator new(size_t kSize)
+{
+    void* pMem;
+
+    pMem = malloc(kSize);
+    if(pMem == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    sHeapBytes += malloc_usable_size(pMem);
+
+    return pMem;
+}
+
+void operator delete(void* pMem) noexcept
+{
+    if(pMem != nullptr)
+    {
+        sHeapBytes -= malloc_usable_size(pMem);
+        free(pMem);
+    }
+}
+
+void operator delete(void* pMem, size_t kSize) noexcept
+{
+    (void)kSize;
+    operator delete(pMem);
+}
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+static double GetElapsedNs(
+                const std::chrono::steady_clock::time_point& krStart,
+                const size_t                                 kCount)
+{
+    std::chrono::nanoseconds elapsed;
+
+    elapsed = std::chrono::steady_clock::now() - krStart;
+
+    return (double)elapsed.count() / kCount;
+}
+
+static void TestTableOperations(void)
+{
+    PatternTable                          table;
+    std::vector<std::shared_ptr<Pattern>> patterns;
+    std::vector<SPatternHandle>           handles;
+    std::chrono::steady_clock::time_point start;
+    uint32_t                              seed;
+    uint32_t                              found;
+    size_t                                i;
+    uint16_t                              patternId;
+    double                                addNs;
+    double                                findNs;
+    double                                resolveNs;
+    double                                removeNs;
+    double                                reuseNs;
+    char                                  msg[160];
+
+    for(i = 0; i < BENCH_PATTERN_COUNT; ++i)
+    {
+        patterns.push_back(MakeTestPattern(skBenchPattern));
+    }
+
+    start = std::chrono::steady_clock::now();
+    for(i = 0; i < BENCH_PATTERN_COUNT; ++i)
+    {
+        patternId = table.Add(patterns[i]);
+        TEST_ASSERT_EQUAL(i, patternId);
+    }
+    addNs = GetElapsedNs(start, BENCH_PATTERN_COUNT);
+    TEST_ASSERT_EQUAL(BENCH_PATTERN_COUNT, table.GetCount());
+
+    for(i = 0; i < BENCH_PATTERN_COUNT; ++i)
+    {
+        handles.push_back(table.GetHandle(i));
+    }
+
+    /* Random identifiers so the slots are not read in sequence */
+    seed  = 1;
+    found = 0;
+    start = std::chrono::steady_clock::now();
+    for(i = 0; i < BENCH_LOOKUP_COUNT; ++i)
+    {
+        seed = seed * 1664525 + 1013904223;
+        if(table.Find((seed >> 8) % BENCH_PATTERN_COUNT) != nullptr)
+        {
+            ++found;
+        }
+    }
+    findNs = GetElapsedNs(start, BENCH_LOOKUP_COUNT);
+    TEST_ASSERT_EQUAL(BENCH_LOOKUP_COUNT, found);
+
+    found = 0;
+    start = std::chrono::steady_clock::now();
+    for(i = 0; i < BENCH_LOOKUP_COUNT; ++i)
+    {
+        seed = seed * 1664525 + 1013904223;
+        if(table.Resolve(handles[(seed >> 8) % BENCH_PATTERN_COUNT]) !=
+           nullptr)
+        {
+            ++found;
+        }
+    }
+    resolveNs = GetElapsedNs(start, BENCH_LOOKUP_COUNT);
+    TEST_ASSERT_EQUAL(BENCH_LOOKUP_COUNT, found);
+
+    /* Remove one pattern out of two */
+    start = std::chrono::steady_clock::now();
+    for(i = 0; i < BENCH_PATTERN_COUNT; i += 2)
+    {
+        TEST_ASSERT_TRUE(table.Remove(i));
+    }
+    removeNs = GetElapsedNs(start, BENCH_PATTERN_COUNT / 2);
+    TEST_ASSERT_EQUAL(BENCH_PATTERN_COUNT / 2, table.GetCount());
+    TEST_ASSERT_FALSE(table.Contains(0));
+    TEST_ASSERT_NULL(table.Resolve(handles[0]));
+    TEST_ASSERT_NOT_NULL(table.Resolve(handles[1]));
+
+    /* The freed slots are reused, the table does not grow */
+    start = std::chrono::steady_clock::now();
+    for(i = 0; i < BENCH_PATTERN_COUNT; i += 2)
+    {
+        patternId = table.Add(patterns[i]);
+        TEST_ASSERT_TRUE(patternId < BENCH_PATTERN_COUNT);
+        TEST_ASSERT_EQUAL(0, patternId % 2);
+    }
+    reuseNs = GetElapsedNs(start, BENCH_PATTERN_COUNT / 2);
+    TEST_ASSERT_EQUAL(BENCH_PATTERN_COUNT, table.GetCount());
+    TEST_ASSERT_NULL(table.Resolve(handles[0]));
+
+    snprintf(msg, sizeof(msg),
+             "%d patterns: add %6.1f ns, find %6.1f ns, resolve %6.1f ns, "
+             "remove %6.1f ns, reuse %6.1f ns",
+             BENCH_PATTERN_COUNT, addNs, findNs, resolveNs, removeNs, reuseNs);
+    TEST_MESSAGE(msg);
+}
+
+static void TestPatternHeap(void)
+{
+    PatternTable                          table;
+    std::vector<std::shared_ptr<Pattern>> patterns;
+    int64_t                               heapStart;
+    size_t                                measured;
+    size_t                                reported;
+    size_t                                i;
+    char                                  msg[160];
+
+    patterns.reserve(BENCH_PATTERN_COUNT);
+
+    heapStart = sHeapBytes.load();
+    for(i = 0; i < BENCH_PATTERN_COUNT; ++i)
+    {
+        patterns.push_back(MakeTestPattern(skBenchPattern));
+        table.Add(patterns.back());
+    }
+    measured = (size_t)(sHeapBytes.load() - heapStart) / BENCH_PATTERN_COUNT;
+
+    /* Same sum as the manager heap report */
+    reported = table.GetHeapSize();
+    for(const std::shared_ptr<Pattern>& krPattern : patterns)
+    {
+        reported += krPattern->GetHeapSize();
+    }
+    reported /= BENCH_PATTERN_COUNT;
+
+    snprintf(msg, sizeof(msg),
+             "Pattern heap: %zu B measured, %zu B reported, table %zu B",
+             measured, reported, table.GetHeapSize() / BENCH_PATTERN_COUNT);
+    TEST_MESSAGE(msg);
+
+    /* The report misses the allocator and shared pointer overheads only */
+    TEST_ASSERT_TRUE(reported <= measured);
+    TEST_ASSERT_TRUE(measured <= 2 * reported);
+}
+
+static size_t GetSceneReportedSize(const std::shared_ptr<SScene>& krScene)
+{
+    size_t size;
+
+    /* Same sum as the manager heap report */
+    size = sizeof(SScene) + krScene->links.GetHeapSize();
+    if(krScene->name.data() < (const char*)krScene.get() ||
+       krScene->name.data() >= (const char*)(krScene.get() + 1))
+    {
+        size += krScene->name.capacity() + 1;
+    }
+
+    return size;
+}
+
+static void MeasureScene(const uint8_t kLinkCount, const char* kpName)
+{
+    std::shared_ptr<SScene> scene;
+    int64_t                 heapStart;
+    size_t                  measured;
+    size_t                  reported;
+    uint8_t                 i;
+    char                    msg[160];
+
+    heapStart = sHeapBytes.load();
+    scene     = std::make_shared<SScene>();
+    scene->name = kpName;
+    for(i = 0; i < kLinkCount; ++i)
+    {
+        scene->links.Set(i, i);
+    }
+    measured = (size_t)(sHeapBytes.load() - heapStart);
+    reported = GetSceneReportedSize(scene);
+
+    snprintf(msg, sizeof(msg),
+             "Scene heap, %d links: %zu B measured, %zu B reported",
+             kLinkCount, measured, reported);
+    TEST_MESSAGE(msg);
+
+    TEST_ASSERT_EQUAL(kLinkCount, scene->links.Size());
+    TEST_ASSERT_TRUE(reported <= measured);
+    TEST_ASSERT_TRUE(measured <= 2 * reported);
+}
+
+static void TestSceneHeap(void)
+{
+    MeasureScene(SCENE_SMALL_LINKS, "Small");
+    MeasureScene(SCENE_LARGE_LINKS, "Large scene with a long name");
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(TestTableOperations);
+    RUN_TEST(TestPatternHeap);
+    RUN_TEST(TestSceneHeap);
+
+    return UNITY_END();
+}
@@ -0,0 +1,426 @@
+/*******************************************************************************
+ * @file test_main.cpp
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief Render scheduler scaling benchmark.
+ *
+ * @details This file runs the render scheduler on host threads. A render plan
+ * is split between 1 to N renderers by the manager balancer, each renderer
+ * renders its steps and the first one waits for the others before presenting
+ * the frame, as the LED worker does with the render helper. The frame time is
+ * measured for each renderer count and the frames are checked against the
+ * single renderer output. The device runs RENDERER_COUNT renderers.
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include <cstdint>            /* Standard Int Types */
+#include <cstdio>             /* snprintf */
+#include <chrono>             /* std::chrono */
+#include <condition_variable> /* std::condition_variable */
+#include <memory>             /* std::shared_ptr */
+#include <mutex>              /* std::mutex */
+#include <thread>             /* std::thread */
+#include <vector>             /* std::vector */
+#include <unity.h>            /* Unit tests */
+#include <FastLED.h>          /* Strips controllers */
+#include <LEDStrip.hpp>       /* LED strip driver */
+#include <PixelArena.h>       /* Strips buffers */
+#include <Pattern.h>          /* Pattern object */
+#include <PatternCompiler.h>  /* Pattern compiler */
+#include <SceneLinks.h>       /* Link parameters */
+#include <StripsManager.h>    /* Render plan balancer */
+#include <TestPattern.h>      /* Test patterns */
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+/* Strips of the plan, their length grows with their index */
+#define STRIP_COUNT      16
+#define STRIP_LED_BASE   600
+#define STRIP_LED_STEP   120
+#define STRIP_GPIO_FIRST 1
+
+/* Renderers measured */
+#define RENDERER_MAX 8
+
+/* Frames rendered per measure */
+#define FRAME_COUNT     400
+#define FRAME_PERIOD_US 10000
+
+/*******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * STRUCTURES AND TYPES
+ ******************************************************************************/
+
+/* Frame handed by the first renderer to the others */
+typedef struct
+{
+    std::mutex              lock;
+    std::condition_variable start;
+    std::condition_variable done;
+    const SRenderSnapshot*  pSnapshot;
+    uint64_t                frameTime;
+    uint32_t                frameSequence;
+    uint32_t                doneCount;
+    bool                    isRunning;
+} SFrameSync;
+
+typedef struct
+{
+    SFrameSync* pSync;
+    uint8_t     renderer;
+} SRendererArgs;
+
+/*******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/************************* Imported global variables **************************/
+/* None */
+
+/************************* Exported global variables **************************/
+/* None */
+
+/************************** Static global variables ***************************/
+static const SLinkParams skDefaultParams = {
+    .brightness = LINK_BRIGHTNESS_DEFAULT,
+    .flags      = 0,
+    .speed      = LINK_SPEED_DEFAULT,
+    .phase      = LINK_PHASE_DEFAULT
+};
+
+static std::shared_ptr<PixelArena>             spArena;
+static std::vector<std::shared_ptr<LEDStripC>> sStrips;
+static SRenderSnapshot                         sSnapshot;
+
+static const STestPattern skScalingPattern = {
+    .id         = 0,
+    .kpName     = "Scaling",
+    .ledCount   = STRIP_LED_BASE,
+    .colorCount = 1,
+    .animCount  = 1,
+    .brightness = 255
+};
+
+/*******************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+static uint32_t GetStepCost(const SRenderStep& krStep)
+{
+    uint32_t cost;
+
+    /* Same estimate as the manager balancer */
+    cost = krStep.program->ledCount + 1;
+    for(const SAnimOp& krOp : krStep.program->animOps)
+    {
+        cost += krOp.length;
+    }
+
+    return cost;
+}
+
+static void RenderSteps(const SRenderSnapshot& krSnapshot,
+                        const uint8_t          kRenderer,
+                        const uint64_t         kFrameTime)
+{
+    for(const SRenderStep& krStep : krSnapshot.steps)
+    {
+        if(krStep.renderer == kRenderer)
+        {
+            krStep.pStrip->Apply(krStep.program.get(),
+                                 krStep.params,
+                                 krStep.revision,
+                                 kFrameTime);
+        }
+    }
+}
+
+static void RendererRoutine(SRendererArgs* pArgs)
+{
+    SFrameSync* pSync;
+    uint32_t    lastSequence;
+    uint64_t    frameTime;
+
+    pSync        = pArgs->pSync;
+    lastSequence = 0;
+
+    while(1)
+    {
+        {
+            std::unique_lock<std::mutex> lock(pSync->lock);
+            while(pSync->isRunning == true &&
+                  pSync->frameSequence == lastSequence)
+            {
+                pSync->start.wait(lock);
+            }
+            if(pSync->isRunning == false)
+            {
+                return;
+            }
+            lastSequence = pSync->frameSequence;
+            frameTime    = pSync->frameTime;
+        }
+
+        RenderSteps(*pSync->pSnapshot, pArgs->renderer, frameTime);
+
+        {
+            std::lock_guard<std::mutex> lock(pSync->lock);
+            ++pSync->doneCount;
+        }
+        pSync->done.notify_one();
+    }
+}
+
+static uint32_t GetFramesChecksum(void)
+{
+    uint32_t checksum;
+    int      i;
+    int      j;
+    CRGB*    pLeds;
+
+    checksum = 0;
+    for(i = 0; i < FastLED.count(); ++i)
+    {
+        pLeds = FastLED[i].leds();
+        for(j = 0; j < FastLED[i].size(); ++j)
+        {
+            checksum = checksum * 31 + pLeds[j].r;
+            checksum = checksum * 31 + pLeds[j].g;
+            checksum = checksum * 31 + pLeds[j].b;
+        }
+    }
+
+    return checksum;
+}
+
+static double RunFrames(const uint8_t kRendererCount, const uint32_t kRevision)
+{
+    SFrameSync                            sync;
+    std::vector<SRendererArgs>            args;
+    std::vector<std::thread>              threads;
+    std::chrono::steady_clock::time_point start;
+    std::chrono::nanoseconds              elapsed;
+    uint32_t                              frame;
+    uint8_t                               i;
+
+    for(SRenderStep& rStep : sSnapshot.steps)
+    {
+        rStep.revision = kRevision;
+    }
+
+    sync.pSnapshot     = &sSnapshot;
+    sync.frameTime     = 0;
+    sync.frameSequence = 0;
+    sync.doneCount     = 0;
+    sync.isRunning     = true;
+
+    /* The first renderer is the calling thread */
+    args.resize(kRendererCount);
+    for(i = 1; i < kRendererCount; ++i)
+    {
+        args[i].pSync    = &sync;
+        args[i].renderer = i;
+        threads.push_back(std::thread(RendererRoutine, &args[i]));
+    }
+
+    start = std::chrono::steady_clock::now();
+    for(frame = 0; frame < FRAME_COUNT; ++frame)
+    {
+        {
+            std::lock_guard<std::mutex> lock(sync.lock);
+            sync.frameTime = (uint64_t)frame * FRAME_PERIOD_US;
+            sync.doneCount = 0;
+            ++sync.frameSequence;
+        }
+        sync.start.notify_all();
+
+        RenderSteps(sSnapshot, RENDERER_WORKER, sync.frameTime);
+
+        /* Frame barrier before the output */
+        {
+            std::unique_lock<std::mutex> lock(sync.lock);
+            while(sync.doneCount != (uint32_t)(kRendererCount - 1))
+            {
+                sync.done.wait(lock);
+            }
+        }
+
+        for(const std::shared_ptr<LEDStripC>& krStrip : sStrips)
+        {
+            krStrip->Present();
+        }
+    }
+    elapsed = std::chrono::steady_clock::now() - start;
+
+    {
+        std::lock_guard<std::mutex> lock(sync.lock);
+        sync.isRunning = false;
+    }
+    sync.start.notify_all();
+    for(std::thread& rThread : threads)
+    {
+        rThread.join();
+    }
+
+    return (double)elapsed.count() / 1000.0 / FRAME_COUNT;
+}
+
+static void TestScaling(void)
+{
+    size_t                 arenaSize;
+    uint8_t                i;
+    uint8_t                rendererCount;
+    uint16_t               ledCount;
+    uint32_t               refChecksum;
+    uint32_t               totalCost;
+    uint32_t               maxCost;
+    uint32_t               maxLoad;
+    uint32_t               loads[RENDERER_MAX];
+    double                 frameUs;
+    double                 refFrameUs;
+    STestPattern           patternConfig;
+    std::shared_ptr<SPatternProgram> program;
+    char                   msg[160];
+
+    arenaSize = 0;
+    for(i = 0; i < STRIP_COUNT; ++i)
+    {
+        arenaSize += LEDStripC::GetBuffersSize(STRIP_LED_BASE +
+                                               i * STRIP_LED_STEP,
+                                               false);
+    }
+    spArena = std::make_shared<PixelArena>(arenaSize, false);
+
+    totalCost = 0;
+    maxCost   = 0;
+    for(i = 0; i < STRIP_COUNT; ++i)
+    {
+        ledCount = STRIP_LED_BASE + i * STRIP_LED_STEP;
+        sStrips.push_back(std::make_shared<LEDStripC>(SStripConfig{
+            .ctrlGPIO   = (gpio_num_t)(STRIP_GPIO_FIRST + i),
+            .mosfetGPIO = (gpio_num_t)(STRIP_GPIO_FIRST + i),
+            .numLed     = ledCount,
+            .isIndexed  = false,
+            .name       = "Scaling"
+        }, *spArena));
+        TEST_ASSERT_TRUE(sStrips.back()->IsReady());
+
+        /* The test renders the frames, it applies the power state */
+        sStrips.back()->RequestEnabled(true);
+        sStrips.back()->UpdateEnabled();
+
+        patternConfig           = skScalingPattern;
+        patternConfig.ledCount  = ledCount;
+        patternConfig.animCount = 1 + i % 3;
+        program = std::make_shared<SPatternProgram>();
+        TEST_ASSERT_TRUE(PatternCompiler::Compile(
+                                            *MakeTestPattern(patternConfig),
+                                            ledCount,
+                                            *program));
+        sSnapshot.steps.push_back({
+            .pStrip        = sStrips.back().get(),
+            .pattern       = nullptr,
+            .patternHandle = {0, 0},
+            .params        = skDefaultParams,
+            .program       = program,
+            .revision      = 0,
+            .renderer      = RENDERER_WORKER
+        });
+
+        totalCost += GetStepCost(sSnapshot.steps.back());
+        if(GetStepCost(sSnapshot.steps.back()) > maxCost)
+        {
+            maxCost = GetStepCost(sSnapshot.steps.back());
+        }
+    }
+
+    snprintf(msg, sizeof(msg),
+             "%d strips, %u LEDs and ops per frame, %u host CPUs",
+             STRIP_COUNT, totalCost, std::thread::hardware_concurrency());
+    TEST_MESSAGE(msg);
+
+    refChecksum = 0;
+    refFrameUs  = 0;
+    for(rendererCount = 1; rendererCount <= RENDERER_MAX; ++rendererCount)
+    {
+        StripsManager::BalanceRenderPlan(sSnapshot, rendererCount);
+        TEST_ASSERT_EQUAL(rendererCount > 1, sSnapshot.hasHelperWork);
+
+        /* The greedy split is at most one step above the even share */
+        for(i = 0; i < rendererCount; ++i)
+        {
+            loads[i] = 0;
+        }
+        for(const SRenderStep& krStep : sSnapshot.steps)
+        {
+            TEST_ASSERT_TRUE(krStep.renderer < rendererCount);
+            loads[krStep.renderer] += GetStepCost(krStep);
+        }
+        maxLoad = 0;
+        for(i = 0; i < rendererCount; ++i)
+        {
+            if(loads[i] > maxLoad)
+            {
+                maxLoad = loads[i];
+            }
+        }
+        TEST_ASSERT_TRUE(maxLoad <= totalCost / rendererCount + maxCost);
+
+        frameUs = RunFrames(rendererCount, rendererCount);
+        if(rendererCount == 1)
+        {
+            refChecksum = GetFramesChecksum();
+            refFrameUs  = frameUs;
+        }
+        else
+        {
+            TEST_ASSERT_EQUAL(refChecksum, GetFramesChecksum());
+        }
+
+        snprintf(msg, sizeof(msg),
+                 "%d renderer(s): %8.1f us/frame, speedup %4.2f, "
+                 "largest share %5.1f%%",
+                 rendererCount, frameUs, refFrameUs / frameUs,
+                 100.0 * maxLoad / totalCost);
+        TEST_MESSAGE(msg);
+    }
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(TestScaling);
+
+    return UNITY_END();
+}
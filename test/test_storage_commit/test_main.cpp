@@ -0,0 +1,332 @@
+/*******************************************************************************
+ * @file test_main.cpp
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief Storage commit write amplification test.
+ *
+ * @details This file measures the bytes written to the host filesystem by the
+ * storage commits. A library of patterns is saved, then a single pattern is
+ * updated and another one removed. The bytes written by each commit are
+ * compared with the library rewrite and checked against the filesystem
+ * counters, the data is then reloaded from the journal.
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include <cstdint>   /* Standard Int Types */
+#include <cstdio>    /* snprintf */
+#include <memory>    /* std::shared_ptr */
+#include <vector>    /* std::vector */
+#include <unity.h>   /* Unit tests */
+#include <SPIFFS.h>  /* Filesystem counters */
+#include <Pattern.h> /* Pattern object */
+#include <Storage.h> /* Storage service */
+#include <SceneLinks.h> /* Scene links */
+#include <TestPattern.h> /* Test patterns */
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+/* Patterns of the library */
+#define LIBRARY_SIZE     50
+#define LIBRARY_FIRST_ID 100
+
+/* Number of LEDs of the patterns */
+#define PATTERN_LED_COUNT 120
+
+/* Patterns updated and removed after the library is saved */
+#define UPDATED_ID (LIBRARY_FIRST_ID + 7)
+#define REMOVED_ID (LIBRARY_FIRST_ID + 8)
+
+/* Strip of the reloaded scene link */
+#define RELOAD_STRIP_ID 4
+
+/* Brightness of the library and of the updated pattern */
+#define LIBRARY_BRIGHTNESS 200
+#define UPDATED_BRIGHTNESS 50
+
+/* A single pattern commit writes at most as much as this number of library
+ * patterns, the whole library was written before the tracking.
+ */
+#define MAX_COMMIT_PATTERNS 2
+
+/*******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * STRUCTURES AND TYPES
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/************************* Imported global variables **************************/
+/* None */
+
+/************************* Exported global variables **************************/
+/* None */
+
+/************************** Static global variables ***************************/
+
+/* Bytes written by the library commit */
+static uint64_t sLibraryBytes;
+
+static const STestPattern skLibraryPattern = {
+    .id         = LIBRARY_FIRST_ID,
+    .kpName     = "Library",
+    .ledCount   = PATTERN_LED_COUNT,
+    .colorCount = 2,
+    .animCount  = 1,
+    .brightness = LIBRARY_BRIGHTNESS
+};
+
+/*******************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+/**
+ * @brief Flushes the storage and gets the bytes written since the last call,
+ * checks that the storage and the filesystem counters agree.
+ *
+ * @param[out] rBytes The bytes written.
+ */
+static void FlushAndMeasure(uint64_t& rBytes)
+{
+    static uint64_t sLastStorageBytes = 0;
+    static uint64_t sLastFsBytes      = 0;
+
+    Storage*      pStorage;
+    SStorageStats storageStats;
+    SSpiffsStats  fsStats;
+    uint64_t      storageBytes;
+    uint64_t      fsBytes;
+
+    pStorage = Storage::GetInstance();
+    pStorage->Flush();
+
+    pStorage->GetStorageStats(storageStats);
+    SPIFFS.getStats(fsStats);
+
+    storageBytes = storageStats.totalBytesWritten - sLastStorageBytes;
+    fsBytes      = fsStats.bytesWritten - sLastFsBytes;
+    sLastStorageBytes = storageStats.totalBytesWritten;
+    sLastFsBytes      = fsStats.bytesWritten;
+
+    rBytes = storageBytes;
+
+    TEST_ASSERT_EQUAL(fsBytes, storageBytes);
+}
+
+static void TestLibraryCommit(void)
+{
+    Storage*     pStorage;
+    STestPattern patternConfig;
+    uint64_t     bootBytes;
+    uint16_t     i;
+    char         msg[160];
+
+    pStorage = Storage::GetInstance();
+
+    /* Writes of the first boot */
+    FlushAndMeasure(bootBytes);
+
+    for(i = 0; i < LIBRARY_SIZE; ++i)
+    {
+        patternConfig    = skLibraryPattern;
+        patternConfig.id = LIBRARY_FIRST_ID + i;
+        pStorage->SavePattern(MakeTestPattern(patternConfig));
+    }
+    FlushAndMeasure(sLibraryBytes);
+
+    snprintf(msg, sizeof(msg),
+             "Library of %d patterns: %llu bytes written",
+             LIBRARY_SIZE, (unsigned long long)sLibraryBytes);
+    TEST_MESSAGE(msg);
+
+    TEST_ASSERT_TRUE(sLibraryBytes > 0);
+}
+
+static void TestPatternUpdateCommit(void)
+{
+    STestPattern patternConfig;
+    uint64_t     updateBytes;
+    char         msg[160];
+
+    patternConfig            = skLibraryPattern;
+    patternConfig.id         = UPDATED_ID;
+    patternConfig.brightness = UPDATED_BRIGHTNESS;
+    Storage::GetInstance()->SavePattern(MakeTestPattern(patternConfig));
+    FlushAndMeasure(updateBytes);
+
+    snprintf(msg, sizeof(msg),
+             "1 pattern updated: %llu bytes written, %.1f%% of the library",
+             (unsigned long long)updateBytes,
+             100.0 * updateBytes / sLibraryBytes);
+    TEST_MESSAGE(msg);
+
+    TEST_ASSERT_TRUE(updateBytes > 0);
+    TEST_ASSERT_TRUE(updateBytes * LIBRARY_SIZE <=
+                     MAX_COMMIT_PATTERNS * sLibraryBytes);
+}
+
+static void TestPatternRemoveCommit(void)
+{
+    uint64_t removeBytes;
+    char     msg[160];
+
+    Storage::GetInstance()->RemovePattern(REMOVED_ID);
+    FlushAndMeasure(removeBytes);
+
+    snprintf(msg, sizeof(msg),
+             "1 pattern removed: %llu bytes written, %.1f%% of the library",
+             (unsigned long long)removeBytes,
+             100.0 * removeBytes / sLibraryBytes);
+    TEST_MESSAGE(msg);
+
+    TEST_ASSERT_TRUE(removeBytes > 0);
+    TEST_ASSERT_TRUE(removeBytes * LIBRARY_SIZE <=
+                     MAX_COMMIT_PATTERNS * sLibraryBytes);
+}
+
+static void TestReload(void)
+{
+    std::vector<std::shared_ptr<Pattern>> patterns;
+    uint16_t                              libraryCount;
+    bool                                  isUpdated;
+
+    /* Replay the journal as on the next boot */
+    Storage::GetInstance()->LoadData();
+    Storage::GetInstance()->GetPatterns(patterns);
+
+    libraryCount = 0;
+    isUpdated    = false;
+    for(const std::shared_ptr<Pattern>& krPattern : patterns)
+    {
+        if(krPattern->GetId() < LIBRARY_FIRST_ID ||
+           krPattern->GetId() >= LIBRARY_FIRST_ID + LIBRARY_SIZE)
+        {
+            continue;
+        }
+        ++libraryCount;
+
+        /* The images are kept packed, not deserialized */
+        TEST_ASSERT_TRUE(krPattern->IsPacked());
+        TEST_ASSERT_EQUAL(0, krPattern->GetColors().size());
+        TEST_ASSERT_NOT_EQUAL(REMOVED_ID, krPattern->GetId());
+        if(krPattern->GetId() == UPDATED_ID)
+        {
+            TEST_ASSERT_EQUAL(UPDATED_BRIGHTNESS, krPattern->GetBrightness());
+            isUpdated = true;
+        }
+        else
+        {
+            TEST_ASSERT_EQUAL(LIBRARY_BRIGHTNESS, krPattern->GetBrightness());
+        }
+    }
+
+    TEST_ASSERT_EQUAL(LIBRARY_SIZE - 1, libraryCount);
+    TEST_ASSERT_TRUE(isUpdated);
+}
+
+static void TestScenesStripsReload(void)
+{
+    std::vector<std::shared_ptr<SScene>> scenes;
+    std::vector<SStripConfig>            strips;
+    std::shared_ptr<SScene>              scene;
+    SLinkParams                          params;
+    Storage*                             pStorage;
+
+    pStorage = Storage::GetInstance();
+
+    /* Settings and links parameters with both bytes of each field set */
+    params.brightness = 0x80;
+    params.flags      = LINK_FLAG_MIRROR;
+    params.speed      = 0x0180;
+    params.phase      = 0x1234;
+    scene = std::make_shared<SScene>();
+    scene->name         = "Versioned";
+    scene->fps          = 50;
+    scene->transition   = LED_TRANSITION_WIPE;
+    scene->transitionMs = 0x0304;
+    scene->links.Set(RELOAD_STRIP_ID, UPDATED_ID, params);
+    scenes.push_back(scene);
+    pStorage->SaveScenes(scenes);
+
+    strips.push_back({
+        .ctrlGPIO   = GPIO_NUM_4,
+        .mosfetGPIO = GPIO_NUM_6,
+        .numLed     = 0x0102,
+        .isIndexed  = true,
+        .name       = "Indexed"
+    });
+    pStorage->SaveStrips(strips);
+
+    /* Replay the journal as on the next boot */
+    pStorage->Flush();
+    pStorage->LoadData();
+    pStorage->GetScenes(scenes);
+    pStorage->GetStrips(strips);
+
+    TEST_ASSERT_EQUAL(1, scenes.size());
+    TEST_ASSERT_TRUE(scenes[0]->name == "Versioned");
+    TEST_ASSERT_EQUAL(50, scenes[0]->fps);
+    TEST_ASSERT_EQUAL(LED_TRANSITION_WIPE, scenes[0]->transition);
+    TEST_ASSERT_EQUAL(0x0304, scenes[0]->transitionMs);
+    TEST_ASSERT_EQUAL(1, scenes[0]->links.Size());
+    TEST_ASSERT_EQUAL(RELOAD_STRIP_ID, scenes[0]->links.begin()->stripId);
+    TEST_ASSERT_EQUAL(UPDATED_ID, scenes[0]->links.begin()->patternId);
+    TEST_ASSERT_TRUE(SceneLinks::IsSameParams(
+                                            params,
+                                            scenes[0]->links.begin()->params));
+
+    TEST_ASSERT_EQUAL(1, strips.size());
+    TEST_ASSERT_EQUAL(GPIO_NUM_4, strips[0].ctrlGPIO);
+    TEST_ASSERT_EQUAL(GPIO_NUM_6, strips[0].mosfetGPIO);
+    TEST_ASSERT_EQUAL(0x0102, strips[0].numLed);
+    TEST_ASSERT_TRUE(strips[0].isIndexed);
+    TEST_ASSERT_TRUE(strips[0].name == "Indexed");
+}
+
+int main(void)
+{
+    Storage::GetInstance()->LoadData();
+
+    UNITY_BEGIN();
+
+    RUN_TEST(TestLibraryCommit);
+    RUN_TEST(TestPatternUpdateCommit);
+    RUN_TEST(TestPatternRemoveCommit);
+    RUN_TEST(TestReload);
+    RUN_TEST(TestScenesStripsReload);
+
+    return UNITY_END();
+}
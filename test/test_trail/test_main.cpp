@@ -0,0 +1,328 @@
+/*******************************************************************************
+ * @file test_main.cpp
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief Trail animation benchmark.
+ *
+ * @details This file checks the compiled trail kernel against the shifting
+ * loop it replaced and compares their frame times for 120, 1000 and 10000
+ * LEDs, with the trail moving one and eight LEDs per frame.
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include <cstdint>         /* Standard Int Types */
+#include <cstdio>          /* snprintf */
+#include <cstring>         /* memcpy */
+#include <vector>          /* std::vector */
+#include <unity.h>         /* Unit tests */
+#include <FastLED.h>       /* CRGB */
+#include <HWLayer.h>       /* Time services */
+#include <Pattern.h>       /* Pattern object */
+#include <ColorKernels.h>  /* Pixel size */
+#include <PatternCompiler.h> /* Pattern compiler */
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+/* LEDs moved by each benchmark run */
+#define BENCH_LED_STEPS 20000000
+
+/* Trail steps per frame of the fast runs */
+#define BENCH_FAST_STEPS 8
+
+/*******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * STRUCTURES AND TYPES
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/************************* Imported global variables **************************/
+/* None */
+
+/************************* Exported global variables **************************/
+/* None */
+
+/************************** Static global variables ***************************/
+/* None */
+
+/*******************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+static void CompileTrail(const uint16_t   kNumLeds,
+                         const uint16_t   kStartIdx,
+                         const uint16_t   kEndIdx,
+                         SPatternProgram& rProgram)
+{
+    Pattern                 pattern(0, "Trail");
+    std::vector<SColor>     colors;
+    std::vector<SAnimation> anims;
+
+    colors.push_back({
+        .startIdx       = 0,
+        .endIdx         = (uint16_t)(kNumLeds - 1),
+        .startColorCode = 0xFF0010,
+        .endColorCode   = 0x00F0FF
+    });
+    anims.push_back({
+        .type     = ANIM_TRAIL,
+        .startIdx = kStartIdx,
+        .endIdx   = kEndIdx,
+        .param    = ANIM_SPEED_UNIT
+    });
+    pattern.SetColors(colors);
+    pattern.SetAnimations(anims);
+    pattern.SetBrightness(255);
+
+    TEST_ASSERT_TRUE(PatternCompiler::Compile(pattern, kNumLeds, rProgram));
+}
+
+/* Trail update of the firmware before the rotation offsets: the frame is
+ * shifted by one LED at every step.
+ */
+static void ShiftTrail(CRGB* pLeds, const uint16_t kStartIdx,
+                       const uint16_t kEndIdx)
+{
+    uint32_t i;
+    CRGB     swap;
+
+    swap = pLeds[kStartIdx];
+    for(i = kStartIdx; i < kEndIdx; ++i)
+    {
+        pLeds[i] = pLeds[i + 1];
+    }
+    pLeds[kEndIdx] = swap;
+}
+
+static void BenchTrail(const uint16_t kNumLeds, const uint32_t kSteps)
+{
+    SPatternProgram      program;
+    std::vector<uint8_t> base;
+    std::vector<uint8_t> frame;
+    std::vector<CRGB>    leds;
+    uint32_t             frames;
+    uint32_t             i;
+    uint32_t             j;
+    uint32_t             step;
+    uint64_t             startTime;
+    uint64_t             shiftTime;
+    uint64_t             copyTime;
+    uint64_t             offsetTime;
+    char                 pMessage[160];
+
+    CompileTrail(kNumLeds, 0, kNumLeds - 1, program);
+    TEST_ASSERT_EQUAL(1, program.colorOps.size());
+    TEST_ASSERT_EQUAL(1, program.animOps.size());
+
+    /* The trail covers the strip, no base LED is copied */
+    TEST_ASSERT_EQUAL(0, program.baseSpans.size());
+
+    const SAnimOp& krOp = program.animOps[0];
+
+    base.resize(kNumLeds * COLOR_KERNELS_PIXEL_SIZE);
+    frame.resize(base.size());
+    leds.resize(kNumLeds);
+    program.colorOps[0].pKernel(base.data(), program.colorOps[0]);
+    memcpy(leds.data(), base.data(), base.size());
+
+    frames = BENCH_LED_STEPS / kNumLeds;
+
+    /* Both versions give the same frames */
+    for(i = 1; i < 2 * (uint32_t)kNumLeds; i += kNumLeds / 7 + 1)
+    {
+        memcpy(leds.data(), base.data(), base.size());
+        for(step = 0; step < i; ++step)
+        {
+            ShiftTrail(leds.data(), 0, kNumLeds - 1);
+        }
+        krOp.pKernel(frame.data(), base.data(), krOp, i % krOp.period);
+        TEST_ASSERT_EQUAL_MEMORY(leds.data(), frame.data(), frame.size());
+    }
+
+    /* Old loop: the frame is shifted in place once per step */
+    memcpy(leds.data(), base.data(), base.size());
+    startTime = HWLayer::GetTime();
+    for(i = 0; i < frames; ++i)
+    {
+        for(j = 0; j < kSteps; ++j)
+        {
+            ShiftTrail(leds.data(), 0, kNumLeds - 1);
+        }
+    }
+    shiftTime = HWLayer::GetTime() - startTime;
+
+    /* Rotation offset over a full copy of the base: each LED of the trail
+     * is written twice.
+     */
+    step      = 0;
+    startTime = HWLayer::GetTime();
+    for(i = 0; i < frames; ++i)
+    {
+        memcpy(frame.data(), base.data(), base.size());
+        krOp.pKernel(frame.data(), base.data(), krOp, step);
+        step = (step + kSteps) % krOp.period;
+    }
+    copyTime = HWLayer::GetTime() - startTime;
+
+    /* Rotation offset as rendered: the base LEDs no trail moves, then the
+     * trail, each LED is written once.
+     */
+    step      = 0;
+    startTime = HWLayer::GetTime();
+    for(i = 0; i < frames; ++i)
+    {
+        PatternCompiler::CopyBase(program,
+                                  frame.data(),
+                                  base.data(),
+                                  COLOR_KERNELS_PIXEL_SIZE);
+        krOp.pKernel(frame.data(), base.data(), krOp, step);
+        step = (step + kSteps) % krOp.period;
+    }
+    offsetTime = HWLayer::GetTime() - startTime;
+
+    /* Keep the results alive */
+    TEST_ASSERT_TRUE(leds[0].r + frame[0] < 512);
+
+    snprintf(pMessage,
+             sizeof(pMessage),
+             "%5u LEDs, %u step(s)/frame: shift %8.1f ns/frame, "
+             "copy and offset %8.1f ns/frame, offset %8.1f ns/frame",
+             kNumLeds,
+             kSteps,
+             (double)shiftTime * 1000.0 / frames,
+             (double)copyTime * 1000.0 / frames,
+             (double)offsetTime * 1000.0 / frames);
+    TEST_MESSAGE(pMessage);
+}
+
+static void TestTrailSpans(void)
+{
+    SPatternProgram      program;
+    std::vector<uint8_t> base;
+    std::vector<uint8_t> frame;
+    std::vector<CRGB>    leds;
+    uint32_t             step;
+
+    /* Trail on the middle of the strip, the base is copied around it */
+    CompileTrail(120, 40, 79, program);
+    TEST_ASSERT_EQUAL(2, program.baseSpans.size());
+    TEST_ASSERT_EQUAL(0, program.baseSpans[0].startIdx);
+    TEST_ASSERT_EQUAL(40, program.baseSpans[0].count);
+    TEST_ASSERT_EQUAL(80, program.baseSpans[1].startIdx);
+    TEST_ASSERT_EQUAL(40, program.baseSpans[1].count);
+
+    const SAnimOp& krOp = program.animOps[0];
+
+    base.resize(120 * COLOR_KERNELS_PIXEL_SIZE);
+    frame.assign(base.size(), 0xAA);
+    leds.resize(120);
+    program.colorOps[0].pKernel(base.data(), program.colorOps[0]);
+    memcpy(leds.data(), base.data(), base.size());
+    for(step = 0; step < 7; ++step)
+    {
+        ShiftTrail(leds.data(), 40, 79);
+    }
+
+    PatternCompiler::CopyBase(program,
+                              frame.data(),
+                              base.data(),
+                              COLOR_KERNELS_PIXEL_SIZE);
+    krOp.pKernel(frame.data(), base.data(), krOp, 7);
+    TEST_ASSERT_EQUAL_MEMORY(leds.data(), frame.data(), frame.size());
+}
+
+static void TestOverlappingTrails(void)
+{
+    Pattern                 pattern(0, "Overlap");
+    std::vector<SAnimation> anims;
+
+    /* The trails all read the base, overlapping trails are rejected */
+    anims.push_back({
+        .type     = ANIM_TRAIL,
+        .startIdx = 0,
+        .endIdx   = 59,
+        .param    = ANIM_SPEED_UNIT
+    });
+    anims.push_back({
+        .type     = ANIM_TRAIL,
+        .startIdx = 90,
+        .endIdx   = 59,
+        .param    = ANIM_SPEED_UNIT
+    });
+    pattern.SetAnimations(anims);
+    TEST_ASSERT_FALSE(PatternCompiler::Validate(pattern));
+
+    /* Disjoint trails and a breath over them are valid */
+    anims[1].endIdx = 60;
+    anims.push_back({
+        .type     = ANIM_BREATH,
+        .startIdx = 0,
+        .endIdx   = 119,
+        .param    = ANIM_SPEED_UNIT
+    });
+    pattern.SetAnimations(anims);
+    TEST_ASSERT_TRUE(PatternCompiler::Validate(pattern));
+}
+
+static void TestTrail120(void)
+{
+    BenchTrail(120, 1);
+    BenchTrail(120, BENCH_FAST_STEPS);
+}
+
+static void TestTrail1000(void)
+{
+    BenchTrail(1000, 1);
+    BenchTrail(1000, BENCH_FAST_STEPS);
+}
+
+static void TestTrail10000(void)
+{
+    BenchTrail(10000, 1);
+    BenchTrail(10000, BENCH_FAST_STEPS);
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(TestTrailSpans);
+    RUN_TEST(TestOverlappingTrails);
+    RUN_TEST(TestTrail120);
+    RUN_TEST(TestTrail1000);
+    RUN_TEST(TestTrail10000);
+    return UNITY_END();
+}